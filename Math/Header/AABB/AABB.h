@@ -0,0 +1,160 @@
+#pragma once
+
+#include <limits>
+#include "Vec3/Vec3.h"
+#include "Mat4/Mat4.h"
+
+namespace lm
+{
+	// axis aligned box, the default one is empty (min above max) so that merge and expand start from it
+	template <typename T> class AABB
+	{
+		public:
+			Vec3<T> min;
+			Vec3<T> max;
+
+			constexpr AABB() : min(std::numeric_limits<T>::max()), max(std::numeric_limits<T>::lowest())
+			{
+			}
+
+			constexpr AABB(const Vec3<T>& min, const Vec3<T>& max) : min(min), max(max)
+			{
+			}
+
+			constexpr AABB(const AABB<T>& aabb) = default;
+			constexpr AABB(AABB<T>&& aabb) noexcept = default;
+			constexpr AABB<T>& operator=(const AABB<T>& aabb) = default;
+			constexpr AABB<T>& operator=(AABB<T>&& aabb) noexcept = default;
+
+			static constexpr AABB<T> fromCenterExtents(const Vec3<T>& center, const Vec3<T>& extents)
+			{
+				return AABB<T>(center - extents, center + extents);
+			}
+
+			static constexpr AABB<T> fromPoints(const Vec3<T>* points, size_t count)
+			{
+				AABB<T> aabb;
+				for (size_t i = 0; i < count; i++)
+					aabb.expand(points[i]);
+
+				return aabb;
+			}
+
+			constexpr bool isEmpty() const
+			{
+				return this->min.X() > this->max.X() || this->min.Y() > this->max.Y() || this->min.Z() > this->max.Z();
+			}
+
+			constexpr Vec3<T> center() const
+			{
+				return (this->min + this->max) * T(0.5);
+			}
+
+			// half size
+			constexpr Vec3<T> extents() const
+			{
+				return (this->max - this->min) * T(0.5);
+			}
+
+			constexpr Vec3<T> size() const
+			{
+				return this->max - this->min;
+			}
+
+			constexpr const T surfaceArea() const
+			{
+				if (this->isEmpty())
+					return 0;
+
+				const Vec3<T> size = this->size();
+				return 2 * ((size.X() * size.Y()) + (size.Y() * size.Z()) + (size.Z() * size.X()));
+			}
+
+			constexpr const T volume() const
+			{
+				if (this->isEmpty())
+					return 0;
+
+				const Vec3<T> size = this->size();
+				return size.X() * size.Y() * size.Z();
+			}
+
+			constexpr void expand(const Vec3<T>& point)
+			{
+				this->min = Vec3<T>(point.X() < this->min.X() ? point.X() : this->min.X(),
+									point.Y() < this->min.Y() ? point.Y() : this->min.Y(),
+									point.Z() < this->min.Z() ? point.Z() : this->min.Z());
+				this->max = Vec3<T>(point.X() > this->max.X() ? point.X() : this->max.X(),
+									point.Y() > this->max.Y() ? point.Y() : this->max.Y(),
+									point.Z() > this->max.Z() ? point.Z() : this->max.Z());
+			}
+
+			constexpr void expand(const AABB<T>& aabb)
+			{
+				if (aabb.isEmpty())
+					return;
+
+				this->expand(aabb.min);
+				this->expand(aabb.max);
+			}
+
+			static constexpr AABB<T> merge(const AABB<T>& a, const AABB<T>& b)
+			{
+				AABB<T> aabb(a);
+				aabb.expand(b);
+				return aabb;
+			}
+
+			constexpr bool contains(const Vec3<T>& point) const
+			{
+				return point.X() >= this->min.X() && point.X() <= this->max.X() &&
+					point.Y() >= this->min.Y() && point.Y() <= this->max.Y() &&
+					point.Z() >= this->min.Z() && point.Z() <= this->max.Z();
+			}
+
+			constexpr bool contains(const AABB<T>& aabb) const
+			{
+				return this->contains(aabb.min) && this->contains(aabb.max);
+			}
+
+			constexpr bool intersects(const AABB<T>& aabb) const
+			{
+				return this->min.X() <= aabb.max.X() && this->max.X() >= aabb.min.X() &&
+					this->min.Y() <= aabb.max.Y() && this->max.Y() >= aabb.min.Y() &&
+					this->min.Z() <= aabb.max.Z() && this->max.Z() >= aabb.min.Z();
+			}
+
+			// box around the transformed box: the center moves with the matrix, the extents go through |m|
+			constexpr AABB<T> transform(const Mat4<T>& mat4) const
+			{
+				if (this->isEmpty())
+					return *this;
+
+				if constexpr (simd::accelerated<T>)
+				{
+					if (!LM_IS_CONSTANT_EVALUATED())
+					{
+						AABB<T> aabb;
+						simd::transformBounds(mat4.data(), this->min.data(), this->max.data(), aabb.min.data(), aabb.max.data());
+						return aabb;
+					}
+				}
+
+				const Vec3<T> center = this->center();
+				const Vec3<T> extents = this->extents();
+
+				Vec3<T> newCenter(mat4[3].X(), mat4[3].Y(), mat4[3].Z());
+				Vec3<T> newExtents;
+				for (int i = 0; i < 3; i++)
+				{
+					const Vec4<T> column = mat4[i];
+					newCenter += Vec3<T>(column.X(), column.Y(), column.Z()) * center[i];
+					newExtents += Vec3<T>(cmath::abs(column.X()), cmath::abs(column.Y()), cmath::abs(column.Z())) * extents[i];
+				}
+
+				return fromCenterExtents(newCenter, newExtents);
+			}
+	};
+
+	typedef AABB<float> aabb;
+}
@@ -0,0 +1,698 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+#include <numeric>
+#include "Bounds.h"
+
+namespace lm
+{
+	// Dynamic bounding volume hierarchy over user ids, one object per leaf. build() splits with a binned
+	// surface area heuristic and lays the nodes out depth first, insert() walks down to the sibling that
+	// costs the least area (Box2D style), update() refits the ancestors of a leaf until their box stops
+	// changing. Refitting keeps the topology: after objects moved far, rebuild() restores the quality.
+	// Queries test the boxes only and report ids, exact tests belong to the caller.
+	template <typename T> class BVH
+	{
+		public:
+			static constexpr uint32_t invalid = UINT32_MAX;
+
+			struct Node
+			{
+				AABB<T> bounds;
+				int32_t parent;
+				// a leaf has no children, a free node has -2
+				int32_t left;
+				int32_t right;
+				uint32_t id;
+			};
+
+			// ids must be unique, they index a table inside the tree so keep them dense
+			void build(const uint32_t* ids, const AABB<T>* boxes, const size_t count)
+			{
+				this->clear();
+				if (count == 0)
+					return;
+
+				uint32_t maxId = 0;
+				for (size_t i = 0; i < count; i++)
+					maxId = ids[i] > maxId ? ids[i] : maxId;
+				this->leaves.assign(size_t(maxId) + 1, -1);
+				this->nodes.reserve(count * 2 - 1);
+
+				std::vector<uint32_t> items(count);
+				std::iota(items.begin(), items.end(), 0);
+				std::vector<Vec3<T>> centers(count);
+				for (size_t i = 0; i < count; i++)
+					centers[i] = boxes[i].center();
+
+				// the left child is built right after its parent, a node is followed by its subtree
+				struct Task
+				{
+					uint32_t begin;
+					uint32_t end;
+					int32_t parent;
+					bool right;
+				};
+
+				std::vector<Task> tasks;
+				tasks.push_back({ 0, uint32_t(count), -1, false });
+				while (!tasks.empty())
+				{
+					const Task task = tasks.back();
+					tasks.pop_back();
+
+					const int32_t node = int32_t(this->nodes.size());
+					this->nodes.push_back({ AABB<T>(), task.parent, -1, -1, invalid });
+					if (task.parent < 0)
+						this->root = node;
+					else if (task.right)
+						this->nodes[task.parent].right = node;
+					else
+						this->nodes[task.parent].left = node;
+
+					if (task.end - task.begin == 1)
+					{
+						const uint32_t item = items[task.begin];
+						this->nodes[node].bounds = boxes[item];
+						this->nodes[node].id = ids[item];
+						this->leaves[ids[item]] = node;
+						continue;
+					}
+
+					AABB<T> bounds;
+					AABB<T> centerBounds;
+					for (uint32_t i = task.begin; i < task.end; i++)
+					{
+						bounds.expand(boxes[items[i]]);
+						centerBounds.expand(centers[items[i]]);
+					}
+					this->nodes[node].bounds = bounds;
+
+					const uint32_t middle = split(items.data(), centers.data(), boxes, task.begin, task.end, centerBounds);
+					tasks.push_back({ middle, task.end, node, true });
+					tasks.push_back({ task.begin, middle, node, false });
+				}
+
+				this->count = count;
+				this->ordered = true;
+			}
+
+			void rebuild()
+			{
+				std::vector<uint32_t> ids;
+				std::vector<AABB<T>> boxes;
+				ids.reserve(this->count);
+				boxes.reserve(this->count);
+				for (const Node& node : this->nodes)
+				{
+					if (node.left == -1)
+					{
+						ids.push_back(node.id);
+						boxes.push_back(node.bounds);
+					}
+				}
+
+				this->build(ids.data(), boxes.data(), ids.size());
+			}
+
+			void insert(const uint32_t id, const AABB<T>& box)
+			{
+				if (id >= this->leaves.size())
+					this->leaves.resize(size_t(id) + 1, -1);
+
+				if (this->leaves[id] >= 0)
+				{
+					this->update(id, box);
+					return;
+				}
+
+				const int32_t leaf = this->allocate();
+				this->nodes[leaf] = { box, -1, -1, -1, id };
+				this->leaves[id] = leaf;
+				this->count++;
+
+				if (this->root < 0)
+				{
+					this->root = leaf;
+					return;
+				}
+
+				// the new parent, appended or reused, can come after the sibling it goes above
+				this->ordered = false;
+
+				// going down a child costs the growth of every box above it, stop where pairing is cheaper
+				int32_t sibling = this->root;
+				while (this->nodes[sibling].left >= 0)
+				{
+					const Node& node = this->nodes[sibling];
+					const T area = node.bounds.surfaceArea();
+					const T combined = AABB<T>::merge(node.bounds, box).surfaceArea();
+					const T cost = 2 * combined;
+					const T inheritance = 2 * (combined - area);
+
+					const T leftCost = this->descendCost(node.left, box) + inheritance;
+					const T rightCost = this->descendCost(node.right, box) + inheritance;
+					if (cost < leftCost && cost < rightCost)
+						break;
+
+					sibling = leftCost < rightCost ? node.left : node.right;
+				}
+
+				const int32_t parent = this->allocate();
+				const int32_t grandParent = this->nodes[sibling].parent;
+				this->nodes[parent] = { AABB<T>::merge(this->nodes[sibling].bounds, box), grandParent, sibling, leaf, invalid };
+				this->nodes[sibling].parent = parent;
+				this->nodes[leaf].parent = parent;
+
+				if (grandParent < 0)
+					this->root = parent;
+				else if (this->nodes[grandParent].left == sibling)
+					this->nodes[grandParent].left = parent;
+				else
+					this->nodes[grandParent].right = parent;
+
+				this->refit(grandParent);
+			}
+
+			void remove(const uint32_t id)
+			{
+				if (!this->contains(id))
+					return;
+
+				const int32_t leaf = this->leaves[id];
+				const int32_t parent = this->nodes[leaf].parent;
+				this->leaves[id] = -1;
+				this->count--;
+				this->release(leaf);
+
+				if (parent < 0)
+				{
+					this->root = -1;
+					return;
+				}
+
+				// the sibling takes the place of the parent
+				const int32_t sibling = this->nodes[parent].left == leaf ? this->nodes[parent].right : this->nodes[parent].left;
+				const int32_t grandParent = this->nodes[parent].parent;
+				this->nodes[sibling].parent = grandParent;
+				this->release(parent);
+
+				if (grandParent < 0)
+				{
+					this->root = sibling;
+					return;
+				}
+
+				if (this->nodes[grandParent].left == parent)
+					this->nodes[grandParent].left = sibling;
+				else
+					this->nodes[grandParent].right = sibling;
+
+				this->refit(grandParent);
+			}
+
+			void update(const uint32_t id, const AABB<T>& box)
+			{
+				const int32_t leaf = this->leaves[id];
+				this->nodes[leaf].bounds = box;
+				this->refit(this->nodes[leaf].parent);
+			}
+
+			// many leaves at once: past a fraction of the tree one pass over every node is cheaper
+			// than walking up from each leaf
+			void update(const uint32_t* ids, const AABB<T>* boxes, const size_t count)
+			{
+				if (count * 8 < this->count)
+				{
+					for (size_t i = 0; i < count; i++)
+						this->update(ids[i], boxes[i]);
+					return;
+				}
+
+				for (size_t i = 0; i < count; i++)
+					this->nodes[this->leaves[ids[i]]].bounds = boxes[i];
+				this->refitAll();
+			}
+
+			bool contains(const uint32_t id) const
+			{
+				return id < this->leaves.size() && this->leaves[id] >= 0;
+			}
+
+			const AABB<T>& bounds(const uint32_t id) const
+			{
+				return this->nodes[this->leaves[id]].bounds;
+			}
+
+			// box around everything, empty without objects
+			AABB<T> bounds() const
+			{
+				return this->root < 0 ? AABB<T>() : this->nodes[this->root].bounds;
+			}
+
+			size_t size() const
+			{
+				return this->count;
+			}
+
+			void clear()
+			{
+				this->nodes.clear();
+				this->freeNodes.clear();
+				this->leaves.clear();
+				this->root = -1;
+				this->count = 0;
+				this->ordered = true;
+			}
+
+			template <typename F> void query(const AABB<T>& box, F&& callback) const
+			{
+				this->traverse([&box](const AABB<T>& bounds) { return box.intersects(bounds); }, callback);
+			}
+
+			template <typename F> void query(const Sphere<T>& sphere, F&& callback) const
+			{
+				this->traverse([&sphere](const AABB<T>& bounds) { return sphere.intersects(bounds); }, callback);
+			}
+
+			// conservative like Frustum::intersects, a subtree inside every plane is reported without more tests
+			// and the planes a box is inside of are not tested again below it
+			template <typename F> void query(const Frustum<T>& frustum, F&& callback) const
+			{
+				if (this->root < 0)
+					return;
+
+				constexpr uint8_t allPlanes = (1 << Frustum<T>::planeCount) - 1;
+				Stack<std::pair<int32_t, uint8_t>> stack;
+				stack.push({ this->root, allPlanes });
+				while (!stack.empty())
+				{
+					const std::pair<int32_t, uint8_t> entry = stack.pop();
+					const Node& node = this->nodes[entry.first];
+
+					uint8_t straddled = entry.second;
+					if (!classify(frustum, node.bounds, straddled))
+						continue;
+
+					if (straddled == 0)
+						this->report(entry.first, callback);
+					else if (node.left < 0)
+						callback(node.id);
+					else
+					{
+						stack.push({ node.right, straddled });
+						stack.push({ node.left, straddled });
+					}
+				}
+			}
+
+			// front to back: callback(id, distance to the box) returns the distance the search is limited to
+			// from then on, maxDistance to see every box on the ray, the hit distance to look only for closer ones
+			template <typename F> void raycast(const Ray<T>& ray, T maxDistance, F&& callback) const
+			{
+				if (this->root < 0)
+					return;
+
+				// a zero component gives an infinite inverse, the slab test copes with it
+				const Vec3<T> inverse(T(1) / ray.direction.X(), T(1) / ray.direction.Y(), T(1) / ray.direction.Z());
+
+				T distance = 0;
+				if (!slab(this->nodes[this->root].bounds, ray.origin, inverse, maxDistance, distance))
+					return;
+
+				Stack<std::pair<int32_t, T>> stack;
+				stack.push({ this->root, distance });
+				while (!stack.empty())
+				{
+					const std::pair<int32_t, T> entry = stack.pop();
+					if (entry.second > maxDistance)
+						continue;
+
+					const Node& node = this->nodes[entry.first];
+					if (node.left < 0)
+					{
+						maxDistance = callback(node.id, entry.second);
+						continue;
+					}
+
+					T leftDistance = 0;
+					T rightDistance = 0;
+					const bool left = slab(this->nodes[node.left].bounds, ray.origin, inverse, maxDistance, leftDistance);
+					const bool right = slab(this->nodes[node.right].bounds, ray.origin, inverse, maxDistance, rightDistance);
+					if (left && right)
+					{
+						// the nearer child is popped first
+						if (leftDistance <= rightDistance)
+						{
+							stack.push({ node.right, rightDistance });
+							stack.push({ node.left, leftDistance });
+						}
+						else
+						{
+							stack.push({ node.left, leftDistance });
+							stack.push({ node.right, rightDistance });
+						}
+					}
+					else if (left)
+						stack.push({ node.left, leftDistance });
+					else if (right)
+						stack.push({ node.right, rightDistance });
+				}
+			}
+
+			// appends the ids of the boxes in the frustum
+			void query(const Frustum<T>& frustum, std::vector<uint32_t>& results) const
+			{
+				this->query(frustum, [&results](const uint32_t id) { results.push_back(id); });
+			}
+
+			// the ids overlapping boxes[i] are results[offsets[i]] to results[offsets[i + 1]]
+			void query(const AABB<T>* boxes, const size_t count, std::vector<uint32_t>& results, std::vector<uint32_t>& offsets) const
+			{
+				results.clear();
+				offsets.resize(count + 1);
+				offsets[0] = 0;
+				for (size_t i = 0; i < count; i++)
+				{
+					this->query(boxes[i], [&results](const uint32_t id) { results.push_back(id); });
+					offsets[i + 1] = uint32_t(results.size());
+				}
+			}
+
+			// nearest box along each ray, invalid and maxDistance when there is none
+			void raycast(const Ray<T>* rays, const size_t count, const T maxDistance, uint32_t* hits, T* distances) const
+			{
+				for (size_t i = 0; i < count; i++)
+				{
+					hits[i] = invalid;
+					distances[i] = maxDistance;
+					this->raycast(rays[i], maxDistance, [&hits, &distances, i](const uint32_t id, const T distance)
+						{
+							hits[i] = id;
+							distances[i] = distance;
+							return distance;
+						});
+				}
+			}
+
+		private:
+			std::vector<Node> nodes;
+			std::vector<int32_t> freeNodes;
+			// leaf of each id, -1 when the id is not in the tree
+			std::vector<int32_t> leaves;
+			int32_t root = -1;
+			size_t count = 0;
+			// every child comes after its parent, true after build() and until the next insert(); remove()
+			// keeps it, the sibling it lifts up already comes after its new parent
+			bool ordered = true;
+
+			// traversal stack, on the heap only past 64 entries
+			template <typename E> class Stack
+			{
+				public:
+					Stack() : data(this->local), capacity(64), top(0)
+					{
+					}
+
+					Stack(const Stack&) = delete;
+					Stack& operator=(const Stack&) = delete;
+
+					void push(const E& entry)
+					{
+						if (this->top == this->capacity)
+						{
+							if (this->heap.empty())
+								this->heap.assign(this->local, this->local + this->capacity);
+							this->heap.resize(this->capacity * 2);
+							this->data = this->heap.data();
+							this->capacity = this->heap.size();
+						}
+						this->data[this->top++] = entry;
+					}
+
+					E pop()
+					{
+						return this->data[--this->top];
+					}
+
+					bool empty() const
+					{
+						return this->top == 0;
+					}
+
+				private:
+					E local[64];
+					std::vector<E> heap;
+					E* data;
+					size_t capacity;
+					size_t top;
+			};
+
+			int32_t allocate()
+			{
+				if (!this->freeNodes.empty())
+				{
+					const int32_t node = this->freeNodes.back();
+					this->freeNodes.pop_back();
+					return node;
+				}
+
+				this->nodes.push_back({ AABB<T>(), -1, -1, -1, invalid });
+				return int32_t(this->nodes.size() - 1);
+			}
+
+			void release(const int32_t node)
+			{
+				this->nodes[node].left = -2;
+				this->nodes[node].right = -2;
+				this->freeNodes.push_back(node);
+			}
+
+			// area added below a node when box goes into its subtree
+			T descendCost(const int32_t node, const AABB<T>& box) const
+			{
+				const AABB<T>& bounds = this->nodes[node].bounds;
+				const T combined = AABB<T>::merge(bounds, box).surfaceArea();
+				return this->nodes[node].left < 0 ? combined : combined - bounds.surfaceArea();
+			}
+
+			static bool same(const AABB<T>& a, const AABB<T>& b)
+			{
+				return a.min.X() == b.min.X() && a.min.Y() == b.min.Y() && a.min.Z() == b.min.Z() &&
+					a.max.X() == b.max.X() && a.max.Y() == b.max.Y() && a.max.Z() == b.max.Z();
+			}
+
+			// from node up, the boxes above an unchanged one are already right
+			void refit(int32_t node)
+			{
+				while (node >= 0)
+				{
+					Node& current = this->nodes[node];
+					const AABB<T> bounds = AABB<T>::merge(this->nodes[current.left].bounds, this->nodes[current.right].bounds);
+					if (same(bounds, current.bounds))
+						return;
+
+					current.bounds = bounds;
+					node = current.parent;
+				}
+			}
+
+			void refitAll()
+			{
+				if (this->root < 0)
+					return;
+
+				if (this->ordered)
+				{
+					for (size_t i = this->nodes.size(); i-- > 0;)
+					{
+						Node& node = this->nodes[i];
+						if (node.left >= 0)
+							node.bounds = AABB<T>::merge(this->nodes[node.left].bounds, this->nodes[node.right].bounds);
+					}
+					return;
+				}
+
+				// children before parents: a node is pushed again under its children and merged on its second pop
+				Stack<std::pair<int32_t, bool>> stack;
+				stack.push({ this->root, false });
+				while (!stack.empty())
+				{
+					const std::pair<int32_t, bool> entry = stack.pop();
+					Node& node = this->nodes[entry.first];
+					if (node.left < 0)
+						continue;
+
+					if (entry.second)
+						node.bounds = AABB<T>::merge(this->nodes[node.left].bounds, this->nodes[node.right].bounds);
+					else
+					{
+						stack.push({ entry.first, true });
+						stack.push({ node.right, false });
+						stack.push({ node.left, false });
+					}
+				}
+			}
+
+			template <typename Test, typename F> void traverse(const Test& test, F& callback) const
+			{
+				if (this->root < 0)
+					return;
+
+				Stack<int32_t> stack;
+				stack.push(this->root);
+				while (!stack.empty())
+				{
+					const Node& node = this->nodes[stack.pop()];
+					if (!test(node.bounds))
+						continue;
+
+					if (node.left < 0)
+						callback(node.id);
+					else
+					{
+						stack.push(node.right);
+						stack.push(node.left);
+					}
+				}
+			}
+
+			// every leaf below node
+			template <typename F> void report(const int32_t node, F& callback) const
+			{
+				Stack<int32_t> stack;
+				stack.push(node);
+				while (!stack.empty())
+				{
+					const Node& current = this->nodes[stack.pop()];
+					if (current.left < 0)
+						callback(current.id);
+					else
+					{
+						stack.push(current.right);
+						stack.push(current.left);
+					}
+				}
+			}
+
+			// false when the box is outside one of the planes, otherwise clears the planes it is inside of
+			static bool classify(const Frustum<T>& frustum, const AABB<T>& bounds, uint8_t& straddled)
+			{
+				const Vec3<T> center = bounds.center();
+				const Vec3<T> extents = bounds.extents();
+				for (int i = 0; i < Frustum<T>::planeCount; i++)
+				{
+					if ((straddled & (1 << i)) == 0)
+						continue;
+
+					const Vec3<T>& normal = frustum.planes[i].normal;
+					const T radius = cmath::abs(normal.X()) * extents.X() + cmath::abs(normal.Y()) * extents.Y() + cmath::abs(normal.Z()) * extents.Z();
+					const T distance = frustum.planes[i].signedDistance(center);
+					if (distance < -radius)
+						return false;
+					if (distance >= radius)
+						straddled &= uint8_t(~(1 << i));
+				}
+				return true;
+			}
+
+			// with the inverse direction, a NaN from 0 * infinity fails both comparisons and leaves the interval alone
+			static void slabAxis(const T min, const T max, const T origin, const T inverse, T& near, T& far)
+			{
+				T t0 = (min - origin) * inverse;
+				T t1 = (max - origin) * inverse;
+				if (t0 > t1)
+					std::swap(t0, t1);
+				near = t0 > near ? t0 : near;
+				far = t1 < far ? t1 : far;
+			}
+
+			static bool slab(const AABB<T>& bounds, const Vec3<T>& origin, const Vec3<T>& inverse, const T maxDistance, T& distance)
+			{
+				T near = 0;
+				T far = maxDistance;
+				slabAxis(bounds.min.X(), bounds.max.X(), origin.X(), inverse.X(), near, far);
+				slabAxis(bounds.min.Y(), bounds.max.Y(), origin.Y(), inverse.Y(), near, far);
+				slabAxis(bounds.min.Z(), bounds.max.Z(), origin.Z(), inverse.Z(), near, far);
+				distance = near;
+				return near <= far;
+			}
+
+			// binned SAH on the longest axis of the centers, returns where the right half starts
+			static uint32_t split(uint32_t* items, const Vec3<T>* centers, const AABB<T>* boxes, const uint32_t begin, const uint32_t end, const AABB<T>& centerBounds)
+			{
+				const Vec3<T> extent = centerBounds.size();
+				int axis = 0;
+				if (extent.Y() > extent[axis])
+					axis = 1;
+				if (extent.Z() > extent[axis])
+					axis = 2;
+
+				const uint32_t middle = begin + (end - begin) / 2;
+				if (!(extent[axis] > 0))
+					return middle;
+
+				constexpr int binCount = 12;
+				const T low = centerBounds.min[axis];
+				const T scale = T(binCount) / extent[axis];
+				auto binOf = [centers, axis, low, scale](const uint32_t item)
+				{
+					const int bin = int((centers[item][axis] - low) * scale);
+					return bin < binCount ? bin : binCount - 1;
+				};
+
+				AABB<T> binBounds[binCount];
+				uint32_t binItems[binCount] = {};
+				for (uint32_t i = begin; i < end; i++)
+				{
+					const int bin = binOf(items[i]);
+					binBounds[bin].expand(boxes[items[i]]);
+					binItems[bin]++;
+				}
+
+				// cost of every split plane, the right side swept first
+				T rightCost[binCount] = {};
+				AABB<T> right;
+				uint32_t rightItems = 0;
+				for (int bin = binCount - 1; bin > 0; bin--)
+				{
+					right.expand(binBounds[bin]);
+					rightItems += binItems[bin];
+					rightCost[bin] = right.surfaceArea() * T(rightItems);
+				}
+
+				AABB<T> left;
+				uint32_t leftItems = 0;
+				T bestCost = std::numeric_limits<T>::max();
+				int best = -1;
+				for (int bin = 0; bin < binCount - 1; bin++)
+				{
+					left.expand(binBounds[bin]);
+					leftItems += binItems[bin];
+					if (leftItems == 0 || leftItems == end - begin)
+						continue;
+
+					const T cost = left.surfaceArea() * T(leftItems) + rightCost[bin + 1];
+					if (cost < bestCost)
+					{
+						bestCost = cost;
+						best = bin;
+					}
+				}
+
+				if (best >= 0)
+				{
+					uint32_t* split = std::partition(items + begin, items + end, [&binOf, best](const uint32_t item) { return binOf(item) <= best; });
+					return uint32_t(split - items);
+				}
+
+				std::nth_element(items + begin, items + middle, items + end, [centers, axis](const uint32_t a, const uint32_t b) { return centers[a][axis] < centers[b][axis]; });
+				return middle;
+			}
+	};
+
+	typedef BVH<float> bvh;
+}
@@ -0,0 +1,753 @@
+#pragma once
+#include <cstddef>
+#include <limits>
+
+#include "Vectors.h"
+#include "Matrices.h"
+#include "Bounds.h"
+#include "Quat/Quat.h"
+#include "FastMath/FastMath.h"
+
+namespace lm
+{
+	// Kernels over contiguous arrays of float math types.
+	// A kernel only reads its inputs and writes out[0, n), so a range can be split in
+	// disjoint chunks (pointer + offset, count) and processed on several threads.
+	namespace batch
+	{
+		// structure of arrays views, T is float or const float
+		template <typename T> struct Vec3SoA
+		{
+			T* x;
+			T* y;
+			T* z;
+		};
+
+		template <typename T> struct QuatSoA
+		{
+			T* w;
+			T* x;
+			T* y;
+			T* z;
+		};
+
+		// out[i] = a[i] * b[i]
+		inline void multiply(const mat4* a, const mat4* b, mat4* out, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+				simd::multiply(a[i].data(), b[i].data(), out[i].data());
+		}
+
+		// out[i] = a * b[i], e.g. one parent and its children
+		inline void multiply(const mat4& a, const mat4* b, mat4* out, size_t n)
+		{
+#if defined(LM_SIMD_SSE)
+			const __m128 c0 = _mm_load_ps(a.data());
+			const __m128 c1 = _mm_load_ps(a.data() + 4);
+			const __m128 c2 = _mm_load_ps(a.data() + 8);
+			const __m128 c3 = _mm_load_ps(a.data() + 12);
+
+			for (size_t i = 0; i < n; i++)
+			{
+				const float* src = b[i].data();
+				float* dst = out[i].data();
+
+				const __m128 b0 = _mm_load_ps(src);
+				const __m128 b1 = _mm_load_ps(src + 4);
+				const __m128 b2 = _mm_load_ps(src + 8);
+				const __m128 b3 = _mm_load_ps(src + 12);
+
+				_mm_store_ps(dst, simd::transform(c0, c1, c2, c3, b0));
+				_mm_store_ps(dst + 4, simd::transform(c0, c1, c2, c3, b1));
+				_mm_store_ps(dst + 8, simd::transform(c0, c1, c2, c3, b2));
+				_mm_store_ps(dst + 12, simd::transform(c0, c1, c2, c3, b3));
+			}
+#else
+			for (size_t i = 0; i < n; i++)
+				simd::multiply(a.data(), b[i].data(), out[i].data());
+#endif
+		}
+
+		// out[i] = a[i] * b, e.g. every bone global transform times the same offset
+		inline void multiply(const mat4* a, const mat4& b, mat4* out, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+				simd::multiply(a[i].data(), b.data(), out[i].data());
+		}
+
+		// out[i] = m[i] * v[i]
+		inline void transform(const mat4* m, const vec4* v, vec4* out, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+				simd::transform(m[i].data(), v[i].data(), out[i].data());
+		}
+
+		// out[i] = m * v[i]
+		inline void transform(const mat4& m, const vec4* v, vec4* out, size_t n)
+		{
+#if defined(LM_SIMD_SSE)
+			const __m128 c0 = _mm_load_ps(m.data());
+			const __m128 c1 = _mm_load_ps(m.data() + 4);
+			const __m128 c2 = _mm_load_ps(m.data() + 8);
+			const __m128 c3 = _mm_load_ps(m.data() + 12);
+
+			for (size_t i = 0; i < n; i++)
+				_mm_store_ps(out[i].data(), simd::transform(c0, c1, c2, c3, _mm_load_ps(v[i].data())));
+#else
+			for (size_t i = 0; i < n; i++)
+				simd::transform(m.data(), v[i].data(), out[i].data());
+#endif
+		}
+
+		// out[i] = (m * vec4(in[i], 1)).xyz, one lane per point
+		inline void transformPoints(const mat4& m, const Vec3SoA<const float>& in, const Vec3SoA<float>& out, size_t n)
+		{
+			const float* c = m.data();
+			size_t i = 0;
+
+#if defined(LM_SIMD_AVX2)
+			for (; i + 8 <= n; i += 8)
+			{
+				const __m256 x = _mm256_loadu_ps(in.x + i);
+				const __m256 y = _mm256_loadu_ps(in.y + i);
+				const __m256 z = _mm256_loadu_ps(in.z + i);
+
+				for (unsigned int row = 0; row < 3; row++)
+				{
+					__m256 r = _mm256_set1_ps(c[12 + row]);
+					r = _mm256_fmadd_ps(_mm256_set1_ps(c[row]), x, r);
+					r = _mm256_fmadd_ps(_mm256_set1_ps(c[4 + row]), y, r);
+					r = _mm256_fmadd_ps(_mm256_set1_ps(c[8 + row]), z, r);
+					_mm256_storeu_ps((row == 0 ? out.x : row == 1 ? out.y : out.z) + i, r);
+				}
+			}
+#endif
+#if defined(LM_SIMD_SSE)
+			for (; i + 4 <= n; i += 4)
+			{
+				const __m128 x = _mm_loadu_ps(in.x + i);
+				const __m128 y = _mm_loadu_ps(in.y + i);
+				const __m128 z = _mm_loadu_ps(in.z + i);
+
+				for (unsigned int row = 0; row < 3; row++)
+				{
+					__m128 r = _mm_set1_ps(c[12 + row]);
+					r = simd::madd(_mm_set1_ps(c[row]), x, r);
+					r = simd::madd(_mm_set1_ps(c[4 + row]), y, r);
+					r = simd::madd(_mm_set1_ps(c[8 + row]), z, r);
+					_mm_storeu_ps((row == 0 ? out.x : row == 1 ? out.y : out.z) + i, r);
+				}
+			}
+#endif
+			for (; i < n; i++)
+			{
+				const float x = in.x[i];
+				const float y = in.y[i];
+				const float z = in.z[i];
+				out.x[i] = c[0] * x + c[4] * y + c[8] * z + c[12];
+				out.y[i] = c[1] * x + c[5] * y + c[9] * z + c[13];
+				out.z[i] = c[2] * x + c[6] * y + c[10] * z + c[14];
+			}
+		}
+
+		// translation * rotation * scale written straight into out, same result as
+		// translation(t) * q.toMat4() * scale(s) without the intermediate products
+		inline void compose(const float tx, const float ty, const float tz,
+							const float qw, const float qx, const float qy, const float qz,
+							const float sx, const float sy, const float sz, mat4& out)
+		{
+			const float norm2 = qw * qw + qx * qx + qy * qy + qz * qz;
+			const float s = norm2 == 0 ? 0 : 2 / norm2;
+
+			const float xs = qx * s, ys = qy * s, zs = qz * s;
+			const float wx = qw * xs, wy = qw * ys, wz = qw * zs;
+			const float xx = qx * xs, xy = qx * ys, xz = qx * zs;
+			const float yy = qy * ys, yz = qy * zs, zz = qz * zs;
+
+			float* m = out.data();
+			m[0] = (1 - (yy + zz)) * sx;	m[1] = (xy + wz) * sx;			m[2] = (xz - wy) * sx;			m[3] = 0;
+			m[4] = (xy - wz) * sy;			m[5] = (1 - (xx + zz)) * sy;	m[6] = (yz + wx) * sy;			m[7] = 0;
+			m[8] = (xz + wy) * sz;			m[9] = (yz - wx) * sz;			m[10] = (1 - (xx + yy)) * sz;	m[11] = 0;
+			m[12] = tx;						m[13] = ty;						m[14] = tz;						m[15] = 1;
+		}
+
+		inline void compose(const vec3* translation, const quat* rotation, const vec3* scale, mat4* out, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+				compose(translation[i].X(), translation[i].Y(), translation[i].Z(),
+						rotation[i].W(), rotation[i].X(), rotation[i].Y(), rotation[i].Z(),
+						scale[i].X(), scale[i].Y(), scale[i].Z(), out[i]);
+		}
+
+		inline void compose(const Vec3SoA<const float>& translation, const QuatSoA<const float>& rotation, const Vec3SoA<const float>& scale, mat4* out, size_t n)
+		{
+			size_t i = 0;
+
+#if defined(LM_SIMD_SSE)
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 one = _mm_set1_ps(1);
+			const __m128 two = _mm_set1_ps(2);
+
+			for (; i + 4 <= n; i += 4)
+			{
+				const __m128 qw = _mm_loadu_ps(rotation.w + i);
+				const __m128 qx = _mm_loadu_ps(rotation.x + i);
+				const __m128 qy = _mm_loadu_ps(rotation.y + i);
+				const __m128 qz = _mm_loadu_ps(rotation.z + i);
+
+				const __m128 norm2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(qw, qw), _mm_mul_ps(qx, qx)), _mm_add_ps(_mm_mul_ps(qy, qy), _mm_mul_ps(qz, qz)));
+				const __m128 s = _mm_and_ps(_mm_div_ps(two, norm2), _mm_cmpneq_ps(norm2, zero));
+
+				const __m128 xs = _mm_mul_ps(qx, s), ys = _mm_mul_ps(qy, s), zs = _mm_mul_ps(qz, s);
+				const __m128 wx = _mm_mul_ps(qw, xs), wy = _mm_mul_ps(qw, ys), wz = _mm_mul_ps(qw, zs);
+				const __m128 xx = _mm_mul_ps(qx, xs), xy = _mm_mul_ps(qx, ys), xz = _mm_mul_ps(qx, zs);
+				const __m128 yy = _mm_mul_ps(qy, ys), yz = _mm_mul_ps(qy, zs), zz = _mm_mul_ps(qz, zs);
+
+				const __m128 sx = _mm_loadu_ps(scale.x + i);
+				const __m128 sy = _mm_loadu_ps(scale.y + i);
+				const __m128 sz = _mm_loadu_ps(scale.z + i);
+
+				// one register per matrix element, one lane per object, transposed back to columns
+				__m128 columns[4][4] =
+				{
+					{ _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(yy, zz)), sx), _mm_mul_ps(_mm_add_ps(xy, wz), sx), _mm_mul_ps(_mm_sub_ps(xz, wy), sx), zero },
+					{ _mm_mul_ps(_mm_sub_ps(xy, wz), sy), _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, zz)), sy), _mm_mul_ps(_mm_add_ps(yz, wx), sy), zero },
+					{ _mm_mul_ps(_mm_add_ps(xz, wy), sz), _mm_mul_ps(_mm_sub_ps(yz, wx), sz), _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, yy)), sz), zero },
+					{ _mm_loadu_ps(translation.x + i), _mm_loadu_ps(translation.y + i), _mm_loadu_ps(translation.z + i), one }
+				};
+
+				for (unsigned int col = 0; col < 4; col++)
+				{
+					_MM_TRANSPOSE4_PS(columns[col][0], columns[col][1], columns[col][2], columns[col][3]);
+					for (unsigned int k = 0; k < 4; k++)
+						_mm_store_ps(out[i + k].data() + 4 * col, columns[col][k]);
+				}
+			}
+#endif
+			for (; i < n; i++)
+				compose(translation.x[i], translation.y[i], translation.z[i],
+						rotation.w[i], rotation.x[i], rotation.y[i], rotation.z[i],
+						scale.x[i], scale.y[i], scale.z[i], out[i]);
+		}
+
+		// same result as Mat4::createTransformMatrix (euler angles in degrees, Y * X * Z order)
+		inline void composeEuler(const vec3& position, const vec3& rotation, const vec3& scale, mat4& out)
+		{
+			const float rx = float(degreesToRadians(double(rotation.X())));
+			const float ry = float(degreesToRadians(double(rotation.Y())));
+			const float rz = float(degreesToRadians(double(rotation.Z())));
+
+			const float cx = std::cos(rx), sx = std::sin(rx);
+			const float cy = std::cos(ry), sy = std::sin(ry);
+			const float cz = std::cos(rz), sz = std::sin(rz);
+
+			float* m = out.data();
+			m[0] = (cy * cz + sy * sx * sz) * scale.X();	m[1] = (cx * sz) * scale.X();	m[2] = (cy * sx * sz - sy * cz) * scale.X();	m[3] = 0;
+			m[4] = (sy * sx * cz - cy * sz) * scale.Y();	m[5] = (cx * cz) * scale.Y();	m[6] = (sy * sz + cy * sx * cz) * scale.Y();	m[7] = 0;
+			m[8] = (sy * cx) * scale.Z();					m[9] = -sx * scale.Z();			m[10] = (cy * cx) * scale.Z();					m[11] = 0;
+			m[12] = position.X();							m[13] = position.Y();			m[14] = position.Z();							m[15] = 1;
+		}
+
+		inline void composeEuler(const vec3* position, const vec3* rotation, const vec3* scale, mat4* out, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+				composeEuler(position[i], rotation[i], scale[i], out[i]);
+		}
+
+		// out[i] = mat3::normalMatrix(m[i]), identity for a singular input
+		inline void normalMatrix(const mat4* m, mat3* out, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+				simd::normalMatrix(m[i].data(), out[i].data());
+		}
+
+		// out[i] = m[i].affineInverse(), identity for a singular input
+		inline void affineInverse(const mat4* m, mat4* out, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				if (!simd::affineInverse(m[i].data(), out[i].data()))
+					out[i] = mat4::identity;
+			}
+		}
+
+#if defined(LM_SIMD_SSE)
+		// lanes of the quaternion kernels: a and b hold w, x, y, z registers, the result replaces a.
+		// acos is fastmath::acos and sin a Taylor series to x^11 on [0, pi / 2],
+		// the slerp mode is 4.4e-7 rad off Quat::slerp at worst, MathBench --accuracy holds it to 1e-6 (twice that, rounded up).
+		inline __m128 select(const __m128 mask, const __m128 a, const __m128 b)
+		{
+			return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+		}
+
+		inline __m128 sinHalfPi(const __m128 x)
+		{
+			const __m128 x2 = _mm_mul_ps(x, x);
+			__m128 p = _mm_set1_ps(-2.5052108e-8f);
+			p = simd::madd(p, x2, _mm_set1_ps(2.7557319e-6f));
+			p = simd::madd(p, x2, _mm_set1_ps(-1.9841270e-4f));
+			p = simd::madd(p, x2, _mm_set1_ps(8.3333333e-3f));
+			p = simd::madd(p, x2, _mm_set1_ps(-1.6666667e-1f));
+			p = simd::madd(p, x2, _mm_set1_ps(1));
+			return _mm_mul_ps(p, x);
+		}
+
+		inline void interpolate(__m128* a, __m128* b, __m128 t, const QuatInterpolation mode)
+		{
+			const __m128 one = _mm_set1_ps(1);
+
+			__m128 cosTheta = _mm_mul_ps(a[0], b[0]);
+			for (unsigned int k = 1; k < 4; k++)
+				cosTheta = simd::madd(a[k], b[k], cosTheta);
+
+			// short path
+			const __m128 sign = _mm_and_ps(cosTheta, _mm_set1_ps(-0.f));
+			cosTheta = _mm_xor_ps(cosTheta, sign);
+			for (unsigned int k = 0; k < 4; k++)
+				b[k] = _mm_xor_ps(b[k], sign);
+
+			if (mode == QuatInterpolation::CORRECTED_NLERP)
+			{
+				const __m128 d = cosTheta;
+				const __m128 half = _mm_sub_ps(t, _mm_set1_ps(0.5f));
+				__m128 ka = simd::madd(d, _mm_set1_ps(-1.43519f), _mm_set1_ps(3.55645f));
+				ka = simd::madd(d, ka, _mm_set1_ps(-3.2452f));
+				ka = simd::madd(d, ka, _mm_set1_ps(1.0904f));
+				__m128 kb = simd::madd(d, _mm_set1_ps(0.215638f), _mm_set1_ps(-1.06021f));
+				kb = simd::madd(d, kb, _mm_set1_ps(0.848013f));
+				const __m128 k = simd::madd(_mm_mul_ps(ka, half), half, kb);
+				t = simd::madd(_mm_mul_ps(_mm_mul_ps(t, half), _mm_sub_ps(t, one)), k, t);
+			}
+
+			__m128 wa = _mm_sub_ps(one, t);
+			__m128 wb = t;
+			if (mode == QuatInterpolation::SLERP)
+			{
+				const __m128 theta = fastmath::acos<fastmath::Precision::HIGH>(cosTheta);
+				const __m128 invSin = _mm_div_ps(one, sinHalfPi(theta));
+				const __m128 linear = _mm_cmpgt_ps(cosTheta, _mm_set1_ps(0.9995f));
+				wa = select(linear, wa, _mm_mul_ps(sinHalfPi(_mm_mul_ps(wa, theta)), invSin));
+				wb = select(linear, wb, _mm_mul_ps(sinHalfPi(_mm_mul_ps(wb, theta)), invSin));
+			}
+
+			__m128 norm2 = _mm_setzero_ps();
+			for (unsigned int k = 0; k < 4; k++)
+			{
+				a[k] = simd::madd(wb, b[k], _mm_mul_ps(wa, a[k]));
+				norm2 = simd::madd(a[k], a[k], norm2);
+			}
+
+			const __m128 invNorm = _mm_div_ps(one, _mm_sqrt_ps(norm2));
+			for (unsigned int k = 0; k < 4; k++)
+				a[k] = _mm_mul_ps(a[k], invNorm);
+		}
+#endif
+#if defined(LM_SIMD_AVX2)
+		inline __m256 select(const __m256 mask, const __m256 a, const __m256 b)
+		{
+			return _mm256_blendv_ps(b, a, mask);
+		}
+
+		inline __m256 sinHalfPi(const __m256 x)
+		{
+			const __m256 x2 = _mm256_mul_ps(x, x);
+			__m256 p = _mm256_set1_ps(-2.5052108e-8f);
+			p = _mm256_fmadd_ps(p, x2, _mm256_set1_ps(2.7557319e-6f));
+			p = _mm256_fmadd_ps(p, x2, _mm256_set1_ps(-1.9841270e-4f));
+			p = _mm256_fmadd_ps(p, x2, _mm256_set1_ps(8.3333333e-3f));
+			p = _mm256_fmadd_ps(p, x2, _mm256_set1_ps(-1.6666667e-1f));
+			p = _mm256_fmadd_ps(p, x2, _mm256_set1_ps(1));
+			return _mm256_mul_ps(p, x);
+		}
+
+		inline void interpolate(__m256* a, __m256* b, __m256 t, const QuatInterpolation mode)
+		{
+			const __m256 one = _mm256_set1_ps(1);
+
+			__m256 cosTheta = _mm256_mul_ps(a[0], b[0]);
+			for (unsigned int k = 1; k < 4; k++)
+				cosTheta = _mm256_fmadd_ps(a[k], b[k], cosTheta);
+
+			const __m256 sign = _mm256_and_ps(cosTheta, _mm256_set1_ps(-0.f));
+			cosTheta = _mm256_xor_ps(cosTheta, sign);
+			for (unsigned int k = 0; k < 4; k++)
+				b[k] = _mm256_xor_ps(b[k], sign);
+
+			if (mode == QuatInterpolation::CORRECTED_NLERP)
+			{
+				const __m256 d = cosTheta;
+				const __m256 half = _mm256_sub_ps(t, _mm256_set1_ps(0.5f));
+				__m256 ka = _mm256_fmadd_ps(d, _mm256_set1_ps(-1.43519f), _mm256_set1_ps(3.55645f));
+				ka = _mm256_fmadd_ps(d, ka, _mm256_set1_ps(-3.2452f));
+				ka = _mm256_fmadd_ps(d, ka, _mm256_set1_ps(1.0904f));
+				__m256 kb = _mm256_fmadd_ps(d, _mm256_set1_ps(0.215638f), _mm256_set1_ps(-1.06021f));
+				kb = _mm256_fmadd_ps(d, kb, _mm256_set1_ps(0.848013f));
+				const __m256 k = _mm256_fmadd_ps(_mm256_mul_ps(ka, half), half, kb);
+				t = _mm256_fmadd_ps(_mm256_mul_ps(_mm256_mul_ps(t, half), _mm256_sub_ps(t, one)), k, t);
+			}
+
+			__m256 wa = _mm256_sub_ps(one, t);
+			__m256 wb = t;
+			if (mode == QuatInterpolation::SLERP)
+			{
+				const __m256 theta = fastmath::acos<fastmath::Precision::HIGH>(cosTheta);
+				const __m256 invSin = _mm256_div_ps(one, sinHalfPi(theta));
+				const __m256 linear = _mm256_cmp_ps(cosTheta, _mm256_set1_ps(0.9995f), _CMP_GT_OQ);
+				wa = select(linear, wa, _mm256_mul_ps(sinHalfPi(_mm256_mul_ps(wa, theta)), invSin));
+				wb = select(linear, wb, _mm256_mul_ps(sinHalfPi(_mm256_mul_ps(wb, theta)), invSin));
+			}
+
+			__m256 norm2 = _mm256_setzero_ps();
+			for (unsigned int k = 0; k < 4; k++)
+			{
+				a[k] = _mm256_fmadd_ps(wb, b[k], _mm256_mul_ps(wa, a[k]));
+				norm2 = _mm256_fmadd_ps(a[k], a[k], norm2);
+			}
+
+			const __m256 invNorm = _mm256_div_ps(one, _mm256_sqrt_ps(norm2));
+			for (unsigned int k = 0; k < 4; k++)
+				a[k] = _mm256_mul_ps(a[k], invNorm);
+		}
+
+		// 4x4 transpose inside both 128 bit halves: quaternions i and i + 4 <-> w, x, y, z of 8 lanes
+		inline void transpose(__m256* r)
+		{
+			const __m256 t0 = _mm256_unpacklo_ps(r[0], r[1]);
+			const __m256 t1 = _mm256_unpackhi_ps(r[0], r[1]);
+			const __m256 t2 = _mm256_unpacklo_ps(r[2], r[3]);
+			const __m256 t3 = _mm256_unpackhi_ps(r[2], r[3]);
+			r[0] = _mm256_shuffle_ps(t0, t2, LM_SHUFFLE(0, 1, 0, 1));
+			r[1] = _mm256_shuffle_ps(t0, t2, LM_SHUFFLE(2, 3, 2, 3));
+			r[2] = _mm256_shuffle_ps(t1, t3, LM_SHUFFLE(0, 1, 0, 1));
+			r[3] = _mm256_shuffle_ps(t1, t3, LM_SHUFFLE(2, 3, 2, 3));
+		}
+
+		inline void load(const quat* q, __m256* r)
+		{
+			for (unsigned int k = 0; k < 4; k++)
+				r[k] = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(q[k].data())), _mm_loadu_ps(q[k + 4].data()), 1);
+			transpose(r);
+		}
+#endif
+
+		// out[i] = Quat::interpolate(a[i], b[i], t[i], mode), e.g. the rotation keys of every bone of a skeleton
+		inline void interpolate(const quat* a, const quat* b, const float* t, quat* out, size_t n, const QuatInterpolation mode = QuatInterpolation::SLERP)
+		{
+			size_t i = 0;
+
+#if defined(LM_SIMD_AVX2)
+			for (; i < (n & ~size_t(7)); i += 8)
+			{
+				__m256 qa[4], qb[4];
+				load(a + i, qa);
+				load(b + i, qb);
+				interpolate(qa, qb, _mm256_loadu_ps(t + i), mode);
+
+				transpose(qa);
+				for (unsigned int k = 0; k < 4; k++)
+				{
+					_mm_storeu_ps(out[i + k].data(), _mm256_castps256_ps128(qa[k]));
+					_mm_storeu_ps(out[i + k + 4].data(), _mm256_extractf128_ps(qa[k], 1));
+				}
+			}
+#endif
+#if defined(LM_SIMD_SSE)
+			for (; i < (n & ~size_t(3)); i += 4)
+			{
+				__m128 qa[4], qb[4];
+				for (unsigned int k = 0; k < 4; k++)
+				{
+					qa[k] = _mm_loadu_ps(a[i + k].data());
+					qb[k] = _mm_loadu_ps(b[i + k].data());
+				}
+				_MM_TRANSPOSE4_PS(qa[0], qa[1], qa[2], qa[3]);
+				_MM_TRANSPOSE4_PS(qb[0], qb[1], qb[2], qb[3]);
+
+				interpolate(qa, qb, _mm_loadu_ps(t + i), mode);
+
+				_MM_TRANSPOSE4_PS(qa[0], qa[1], qa[2], qa[3]);
+				for (unsigned int k = 0; k < 4; k++)
+					_mm_storeu_ps(out[i + k].data(), qa[k]);
+			}
+#endif
+			for (; i < n; i++)
+				out[i] = quat::interpolate(a[i], b[i], t[i], mode);
+		}
+
+		// out[i] = in[i].transform(m[i])
+		inline void transform(const mat4* m, const aabb* in, aabb* out, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+				simd::transformBounds(m[i].data(), in[i].min.data(), in[i].max.data(), out[i].min.data(), out[i].max.data());
+		}
+
+		// out[i] = in[i].transform(m), e.g. model space bounds of every instance of a mesh
+		inline void transform(const mat4& m, const aabb* in, aabb* out, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+				simd::transformBounds(m.data(), in[i].min.data(), in[i].max.data(), out[i].min.data(), out[i].max.data());
+		}
+
+		// visible[i] = f.intersects(boxes[i]), one lane per box against the 6 planes
+		inline void intersects(const frustum& f, const aabb* boxes, bool* visible, size_t n)
+		{
+			size_t i = 0;
+
+#if defined(LM_SIMD_AVX2)
+			{
+				__m256 nx[frustum::planeCount], ny[frustum::planeCount], nz[frustum::planeCount], d[frustum::planeCount];
+				__m256 ax[frustum::planeCount], ay[frustum::planeCount], az[frustum::planeCount];
+				for (int p = 0; p < frustum::planeCount; p++)
+				{
+					const plane& current = f.planes[p];
+					nx[p] = _mm256_set1_ps(current.normal.X());
+					ny[p] = _mm256_set1_ps(current.normal.Y());
+					nz[p] = _mm256_set1_ps(current.normal.Z());
+					d[p] = _mm256_set1_ps(current.distance);
+					ax[p] = _mm256_set1_ps(std::abs(current.normal.X()));
+					ay[p] = _mm256_set1_ps(std::abs(current.normal.Y()));
+					az[p] = _mm256_set1_ps(std::abs(current.normal.Z()));
+				}
+
+				const __m256 half = _mm256_set1_ps(0.5f);
+				for (; i + 8 <= n; i += 8)
+				{
+					const aabb* b = boxes + i;
+					const __m256 minX = _mm256_setr_ps(b[0].min.X(), b[1].min.X(), b[2].min.X(), b[3].min.X(), b[4].min.X(), b[5].min.X(), b[6].min.X(), b[7].min.X());
+					const __m256 minY = _mm256_setr_ps(b[0].min.Y(), b[1].min.Y(), b[2].min.Y(), b[3].min.Y(), b[4].min.Y(), b[5].min.Y(), b[6].min.Y(), b[7].min.Y());
+					const __m256 minZ = _mm256_setr_ps(b[0].min.Z(), b[1].min.Z(), b[2].min.Z(), b[3].min.Z(), b[4].min.Z(), b[5].min.Z(), b[6].min.Z(), b[7].min.Z());
+					const __m256 maxX = _mm256_setr_ps(b[0].max.X(), b[1].max.X(), b[2].max.X(), b[3].max.X(), b[4].max.X(), b[5].max.X(), b[6].max.X(), b[7].max.X());
+					const __m256 maxY = _mm256_setr_ps(b[0].max.Y(), b[1].max.Y(), b[2].max.Y(), b[3].max.Y(), b[4].max.Y(), b[5].max.Y(), b[6].max.Y(), b[7].max.Y());
+					const __m256 maxZ = _mm256_setr_ps(b[0].max.Z(), b[1].max.Z(), b[2].max.Z(), b[3].max.Z(), b[4].max.Z(), b[5].max.Z(), b[6].max.Z(), b[7].max.Z());
+
+					const __m256 cx = _mm256_mul_ps(_mm256_add_ps(minX, maxX), half);
+					const __m256 cy = _mm256_mul_ps(_mm256_add_ps(minY, maxY), half);
+					const __m256 cz = _mm256_mul_ps(_mm256_add_ps(minZ, maxZ), half);
+					const __m256 ex = _mm256_mul_ps(_mm256_sub_ps(maxX, minX), half);
+					const __m256 ey = _mm256_mul_ps(_mm256_sub_ps(maxY, minY), half);
+					const __m256 ez = _mm256_mul_ps(_mm256_sub_ps(maxZ, minZ), half);
+
+					// outside when distance(center) < -radius of the box along the normal
+					__m256 outside = _mm256_setzero_ps();
+					for (int p = 0; p < frustum::planeCount; p++)
+					{
+						__m256 distance = _mm256_fmadd_ps(nx[p], cx, d[p]);
+						distance = _mm256_fmadd_ps(ny[p], cy, distance);
+						distance = _mm256_fmadd_ps(nz[p], cz, distance);
+
+						__m256 radius = _mm256_mul_ps(ax[p], ex);
+						radius = _mm256_fmadd_ps(ay[p], ey, radius);
+						radius = _mm256_fmadd_ps(az[p], ez, radius);
+
+						outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(distance, radius), _mm256_setzero_ps(), _CMP_LT_OQ));
+					}
+
+					const int mask = _mm256_movemask_ps(outside);
+					for (int k = 0; k < 8; k++)
+						visible[i + k] = (mask & (1 << k)) == 0;
+				}
+			}
+#endif
+#if defined(LM_SIMD_SSE)
+			{
+				__m128 nx[frustum::planeCount], ny[frustum::planeCount], nz[frustum::planeCount], d[frustum::planeCount];
+				__m128 ax[frustum::planeCount], ay[frustum::planeCount], az[frustum::planeCount];
+				for (int p = 0; p < frustum::planeCount; p++)
+				{
+					const plane& current = f.planes[p];
+					nx[p] = _mm_set1_ps(current.normal.X());
+					ny[p] = _mm_set1_ps(current.normal.Y());
+					nz[p] = _mm_set1_ps(current.normal.Z());
+					d[p] = _mm_set1_ps(current.distance);
+					ax[p] = _mm_set1_ps(std::abs(current.normal.X()));
+					ay[p] = _mm_set1_ps(std::abs(current.normal.Y()));
+					az[p] = _mm_set1_ps(std::abs(current.normal.Z()));
+				}
+
+				const __m128 half = _mm_set1_ps(0.5f);
+				for (; i + 4 <= n; i += 4)
+				{
+					const aabb* b = boxes + i;
+					const __m128 minX = _mm_setr_ps(b[0].min.X(), b[1].min.X(), b[2].min.X(), b[3].min.X());
+					const __m128 minY = _mm_setr_ps(b[0].min.Y(), b[1].min.Y(), b[2].min.Y(), b[3].min.Y());
+					const __m128 minZ = _mm_setr_ps(b[0].min.Z(), b[1].min.Z(), b[2].min.Z(), b[3].min.Z());
+					const __m128 maxX = _mm_setr_ps(b[0].max.X(), b[1].max.X(), b[2].max.X(), b[3].max.X());
+					const __m128 maxY = _mm_setr_ps(b[0].max.Y(), b[1].max.Y(), b[2].max.Y(), b[3].max.Y());
+					const __m128 maxZ = _mm_setr_ps(b[0].max.Z(), b[1].max.Z(), b[2].max.Z(), b[3].max.Z());
+
+					const __m128 cx = _mm_mul_ps(_mm_add_ps(minX, maxX), half);
+					const __m128 cy = _mm_mul_ps(_mm_add_ps(minY, maxY), half);
+					const __m128 cz = _mm_mul_ps(_mm_add_ps(minZ, maxZ), half);
+					const __m128 ex = _mm_mul_ps(_mm_sub_ps(maxX, minX), half);
+					const __m128 ey = _mm_mul_ps(_mm_sub_ps(maxY, minY), half);
+					const __m128 ez = _mm_mul_ps(_mm_sub_ps(maxZ, minZ), half);
+
+					__m128 outside = _mm_setzero_ps();
+					for (int p = 0; p < frustum::planeCount; p++)
+					{
+						__m128 distance = simd::madd(nx[p], cx, d[p]);
+						distance = simd::madd(ny[p], cy, distance);
+						distance = simd::madd(nz[p], cz, distance);
+
+						__m128 radius = _mm_mul_ps(ax[p], ex);
+						radius = simd::madd(ay[p], ey, radius);
+						radius = simd::madd(az[p], ez, radius);
+
+						outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+					}
+
+					const int mask = _mm_movemask_ps(outside);
+					for (int k = 0; k < 4; k++)
+						visible[i + k] = (mask & (1 << k)) == 0;
+				}
+			}
+#endif
+			for (; i < n; i++)
+				visible[i] = f.intersects(boxes[i]);
+		}
+
+		// number of visible boxes, their indices are written to indices[0, count)
+		inline size_t cull(const frustum& f, const aabb* boxes, size_t* indices, size_t n)
+		{
+			size_t count = 0;
+			bool visible[64];
+			for (size_t first = 0; first < n; first += 64)
+			{
+				const size_t chunk = n - first < 64 ? n - first : 64;
+				intersects(f, boxes + first, visible, chunk);
+				for (size_t k = 0; k < chunk; k++)
+					if (visible[k])
+						indices[count++] = first + k;
+			}
+
+			return count;
+		}
+
+		// distances[i] = where r crosses triangle i before maxDistance, infinity when it does not.
+		// A triangle is a corner and the two edges from it, both faces count like Ray::intersects
+		inline void intersect(const ray& r, const float maxDistance, const Vec3SoA<const float>& corners, const Vec3SoA<const float>& edges1, const Vec3SoA<const float>& edges2, float* distances, size_t n)
+		{
+			size_t i = 0;
+
+#if defined(LM_SIMD_AVX2)
+			{
+				const __m256 ox = _mm256_set1_ps(r.origin.X()), oy = _mm256_set1_ps(r.origin.Y()), oz = _mm256_set1_ps(r.origin.Z());
+				const __m256 dx = _mm256_set1_ps(r.direction.X()), dy = _mm256_set1_ps(r.direction.Y()), dz = _mm256_set1_ps(r.direction.Z());
+				const __m256 zero = _mm256_setzero_ps();
+				const __m256 one = _mm256_set1_ps(1.f);
+				const __m256 limit = _mm256_set1_ps(maxDistance);
+				const __m256 miss = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+
+				for (; i + 8 <= n; i += 8)
+				{
+					const __m256 e1x = _mm256_loadu_ps(edges1.x + i), e1y = _mm256_loadu_ps(edges1.y + i), e1z = _mm256_loadu_ps(edges1.z + i);
+					const __m256 e2x = _mm256_loadu_ps(edges2.x + i), e2y = _mm256_loadu_ps(edges2.y + i), e2z = _mm256_loadu_ps(edges2.z + i);
+
+					// p = direction x edge2, determinant = edge1 . p
+					const __m256 px = _mm256_fmsub_ps(dy, e2z, _mm256_mul_ps(dz, e2y));
+					const __m256 py = _mm256_fmsub_ps(dz, e2x, _mm256_mul_ps(dx, e2z));
+					const __m256 pz = _mm256_fmsub_ps(dx, e2y, _mm256_mul_ps(dy, e2x));
+					const __m256 determinant = _mm256_fmadd_ps(e1z, pz, _mm256_fmadd_ps(e1y, py, _mm256_mul_ps(e1x, px)));
+					const __m256 inverse = _mm256_div_ps(one, determinant);
+
+					const __m256 sx = _mm256_sub_ps(ox, _mm256_loadu_ps(corners.x + i));
+					const __m256 sy = _mm256_sub_ps(oy, _mm256_loadu_ps(corners.y + i));
+					const __m256 sz = _mm256_sub_ps(oz, _mm256_loadu_ps(corners.z + i));
+					const __m256 u = _mm256_mul_ps(_mm256_fmadd_ps(sz, pz, _mm256_fmadd_ps(sy, py, _mm256_mul_ps(sx, px))), inverse);
+
+					// q = offset x edge1
+					const __m256 qx = _mm256_fmsub_ps(sy, e1z, _mm256_mul_ps(sz, e1y));
+					const __m256 qy = _mm256_fmsub_ps(sz, e1x, _mm256_mul_ps(sx, e1z));
+					const __m256 qz = _mm256_fmsub_ps(sx, e1y, _mm256_mul_ps(sy, e1x));
+					const __m256 v = _mm256_mul_ps(_mm256_fmadd_ps(dz, qz, _mm256_fmadd_ps(dy, qy, _mm256_mul_ps(dx, qx))), inverse);
+					const __m256 t = _mm256_mul_ps(_mm256_fmadd_ps(e2z, qz, _mm256_fmadd_ps(e2y, qy, _mm256_mul_ps(e2x, qx))), inverse);
+
+					// ordered compares, the NaN of a degenerate triangle misses
+					__m256 hit = _mm256_cmp_ps(determinant, zero, _CMP_NEQ_OQ);
+					hit = _mm256_and_ps(hit, _mm256_cmp_ps(u, zero, _CMP_GE_OQ));
+					hit = _mm256_and_ps(hit, _mm256_cmp_ps(v, zero, _CMP_GE_OQ));
+					hit = _mm256_and_ps(hit, _mm256_cmp_ps(_mm256_add_ps(u, v), one, _CMP_LE_OQ));
+					hit = _mm256_and_ps(hit, _mm256_cmp_ps(t, zero, _CMP_GE_OQ));
+					hit = _mm256_and_ps(hit, _mm256_cmp_ps(t, limit, _CMP_LE_OQ));
+					_mm256_storeu_ps(distances + i, _mm256_blendv_ps(miss, t, hit));
+				}
+			}
+#endif
+#if defined(LM_SIMD_SSE)
+			{
+				const __m128 ox = _mm_set1_ps(r.origin.X()), oy = _mm_set1_ps(r.origin.Y()), oz = _mm_set1_ps(r.origin.Z());
+				const __m128 dx = _mm_set1_ps(r.direction.X()), dy = _mm_set1_ps(r.direction.Y()), dz = _mm_set1_ps(r.direction.Z());
+				const __m128 zero = _mm_setzero_ps();
+				const __m128 one = _mm_set1_ps(1.f);
+				const __m128 limit = _mm_set1_ps(maxDistance);
+				const __m128 miss = _mm_set1_ps(std::numeric_limits<float>::infinity());
+
+				for (; i + 4 <= n; i += 4)
+				{
+					const __m128 e1x = _mm_loadu_ps(edges1.x + i), e1y = _mm_loadu_ps(edges1.y + i), e1z = _mm_loadu_ps(edges1.z + i);
+					const __m128 e2x = _mm_loadu_ps(edges2.x + i), e2y = _mm_loadu_ps(edges2.y + i), e2z = _mm_loadu_ps(edges2.z + i);
+
+					const __m128 px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+					const __m128 py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+					const __m128 pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+					const __m128 determinant = simd::madd(e1z, pz, simd::madd(e1y, py, _mm_mul_ps(e1x, px)));
+					const __m128 inverse = _mm_div_ps(one, determinant);
+
+					const __m128 sx = _mm_sub_ps(ox, _mm_loadu_ps(corners.x + i));
+					const __m128 sy = _mm_sub_ps(oy, _mm_loadu_ps(corners.y + i));
+					const __m128 sz = _mm_sub_ps(oz, _mm_loadu_ps(corners.z + i));
+					const __m128 u = _mm_mul_ps(simd::madd(sz, pz, simd::madd(sy, py, _mm_mul_ps(sx, px))), inverse);
+
+					const __m128 qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(sz, e1y));
+					const __m128 qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(sx, e1z));
+					const __m128 qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(sy, e1x));
+					const __m128 v = _mm_mul_ps(simd::madd(dz, qz, simd::madd(dy, qy, _mm_mul_ps(dx, qx))), inverse);
+					const __m128 t = _mm_mul_ps(simd::madd(e2z, qz, simd::madd(e2y, qy, _mm_mul_ps(e2x, qx))), inverse);
+
+					__m128 hit = _mm_cmpneq_ps(determinant, zero);
+					hit = _mm_and_ps(hit, _mm_cmpge_ps(u, zero));
+					hit = _mm_and_ps(hit, _mm_cmpge_ps(v, zero));
+					hit = _mm_and_ps(hit, _mm_cmple_ps(_mm_add_ps(u, v), one));
+					hit = _mm_and_ps(hit, _mm_cmpge_ps(t, zero));
+					hit = _mm_and_ps(hit, _mm_cmple_ps(t, limit));
+					_mm_storeu_ps(distances + i, select(hit, t, miss));
+				}
+			}
+#endif
+			for (; i < n; i++)
+			{
+				const vec3 corner(corners.x[i], corners.y[i], corners.z[i]);
+				const vec3 b(corner.X() + edges1.x[i], corner.Y() + edges1.y[i], corner.Z() + edges1.z[i]);
+				const vec3 c(corner.X() + edges2.x[i], corner.Y() + edges2.y[i], corner.Z() + edges2.z[i]);
+				float distance = 0;
+				distances[i] = r.intersects(corner, b, c, distance, maxDistance) ? distance : std::numeric_limits<float>::infinity();
+			}
+		}
+
+		// index of the nearest triangle r crosses before maxDistance, n when there is none;
+		// maxDistance becomes the distance to it
+		inline size_t nearest(const ray& r, float& maxDistance, const Vec3SoA<const float>& corners, const Vec3SoA<const float>& edges1, const Vec3SoA<const float>& edges2, size_t n)
+		{
+			size_t found = n;
+			float distances[64];
+			for (size_t first = 0; first < n; first += 64)
+			{
+				const size_t chunk = n - first < 64 ? n - first : 64;
+				const Vec3SoA<const float> corner = { corners.x + first, corners.y + first, corners.z + first };
+				const Vec3SoA<const float> edge1 = { edges1.x + first, edges1.y + first, edges1.z + first };
+				const Vec3SoA<const float> edge2 = { edges2.x + first, edges2.y + first, edges2.z + first };
+				intersect(r, maxDistance, corner, edge1, edge2, distances, chunk);
+				for (size_t k = 0; k < chunk; k++)
+				{
+					if (distances[k] != std::numeric_limits<float>::infinity() && (found == n || distances[k] < maxDistance))
+					{
+						maxDistance = distances[k];
+						found = first + k;
+					}
+				}
+			}
+
+			return found;
+		}
+	}
+}
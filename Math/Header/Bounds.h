@@ -0,0 +1,7 @@
+#pragma once
+
+#include "Plane/Plane.h"
+#include "AABB/AABB.h"
+#include "Sphere/Sphere.h"
+#include "Frustum/Frustum.h"
+#include "Ray/Ray.h"
@@ -0,0 +1,212 @@
+#pragma once
+#include <type_traits>
+
+#include "Vec3/Vec3.h"
+#include "Vec4/Vec4.h"
+#include "Mat4/Mat4.h"
+#include "Quat/Quat.h"
+
+namespace lm
+{
+	// Lazy products of 4x4 factors. lazy(a) * b * c builds a small tree instead of two Mat4
+	// temporaries, the result is computed one column at a time when it is assigned to a Mat4
+	// (column j of a * b * c is a * (b * c[j])), and expr * vec4 never builds a matrix at all.
+	// Structured factors skip the zeros: translate(t) * rotate(q) * scale(s) costs one 3x3
+	// product per column. A node keeps references to the Mat4 operands, evaluate it before they go away.
+	namespace expr
+	{
+		struct Node
+		{
+		};
+
+		template <typename E> constexpr bool isExpression = std::is_base_of<Node, E>::value;
+
+		template <typename T> constexpr Vec4<T> unit(const int column)
+		{
+			return Vec4<T>(column == 0 ? T(1) : T(0), column == 1 ? T(1) : T(0), column == 2 ? T(1) : T(0), column == 3 ? T(1) : T(0));
+		}
+
+		template <typename E, typename T> class Expression : public Node
+		{
+			public:
+				typedef T Scalar;
+
+				constexpr Mat4<T> eval() const
+				{
+					const E& expression = static_cast<const E&>(*this);
+					return Mat4<T>(expression.column(0), expression.column(1), expression.column(2), expression.column(3));
+				}
+
+				constexpr operator Mat4<T>() const
+				{
+					return this->eval();
+				}
+
+				constexpr Vec4<T> operator*(const Vec4<T>& vec4) const
+				{
+					return static_cast<const E&>(*this).apply(vec4);
+				}
+		};
+
+		template <typename T> class Matrix : public Expression<Matrix<T>, T>
+		{
+			private:
+				const Mat4<T>& matrix;
+
+			public:
+				constexpr Matrix(const Mat4<T>& matrix) : matrix(matrix)
+				{
+				}
+
+				constexpr Vec4<T> column(const int j) const
+				{
+					return this->matrix[j];
+				}
+
+				constexpr Vec4<T> apply(const Vec4<T>& vec4) const
+				{
+					return this->matrix * vec4;
+				}
+		};
+
+		template <typename T> class Translation : public Expression<Translation<T>, T>
+		{
+			private:
+				Vec3<T> translation;
+
+			public:
+				constexpr Translation(const Vec3<T>& translation) : translation(translation)
+				{
+				}
+
+				constexpr Vec4<T> column(const int j) const
+				{
+					return j == 3 ? Vec4<T>(this->translation, 1) : unit<T>(j);
+				}
+
+				constexpr Vec4<T> apply(const Vec4<T>& vec4) const
+				{
+					return Vec4<T>(vec4.X() + this->translation.X() * vec4.W(), vec4.Y() + this->translation.Y() * vec4.W(), vec4.Z() + this->translation.Z() * vec4.W(), vec4.W());
+				}
+		};
+
+		template <typename T> class Scale : public Expression<Scale<T>, T>
+		{
+			private:
+				Vec3<T> scale;
+
+			public:
+				constexpr Scale(const Vec3<T>& scale) : scale(scale)
+				{
+				}
+
+				constexpr Vec4<T> column(const int j) const
+				{
+					return j == 3 ? unit<T>(3) : unit<T>(j) * this->scale[j];
+				}
+
+				constexpr Vec4<T> apply(const Vec4<T>& vec4) const
+				{
+					return Vec4<T>(vec4.X() * this->scale.X(), vec4.Y() * this->scale.Y(), vec4.Z() * this->scale.Z(), vec4.W());
+				}
+		};
+
+		// only the 3x3 part is stored and applied
+		template <typename T> class Rotation : public Expression<Rotation<T>, T>
+		{
+			private:
+				Vec4<T> columns[3];
+
+			public:
+				// the columns of Quat::toMat4, scaled by 2 / norm instead of normalizing
+				constexpr Rotation(const Quat<T>& rotation) : columns()
+				{
+					const T qw = rotation.W(), qx = rotation.X(), qy = rotation.Y(), qz = rotation.Z();
+					const T norm2 = (qw * qw) + (qx * qx) + (qy * qy) + (qz * qz);
+					const T s = norm2 == 0 ? T(0) : T(2) / norm2;
+
+					const T xx = qx * qx * s, yy = qy * qy * s, zz = qz * qz * s;
+					const T xy = qx * qy * s, xz = qx * qz * s, yz = qy * qz * s;
+					const T wx = qw * qx * s, wy = qw * qy * s, wz = qw * qz * s;
+
+					this->columns[0] = Vec4<T>(1 - yy - zz, xy + wz, xz - wy, 0);
+					this->columns[1] = Vec4<T>(xy - wz, 1 - xx - zz, yz + wx, 0);
+					this->columns[2] = Vec4<T>(xz + wy, yz - wx, 1 - xx - yy, 0);
+				}
+
+				constexpr Vec4<T> column(const int j) const
+				{
+					return j == 3 ? unit<T>(3) : this->columns[j];
+				}
+
+				constexpr Vec4<T> apply(const Vec4<T>& vec4) const
+				{
+					Vec4<T> result = this->columns[0] * vec4.X() + this->columns[1] * vec4.Y() + this->columns[2] * vec4.Z();
+					result.W() = vec4.W();
+					return result;
+				}
+		};
+
+		template <typename L, typename R> class Product : public Expression<Product<L, R>, typename L::Scalar>
+		{
+			private:
+				L left;
+				R right;
+
+			public:
+				typedef typename L::Scalar T;
+
+				constexpr Product(const L& left, const R& right) : left(left), right(right)
+				{
+				}
+
+				constexpr Vec4<T> column(const int j) const
+				{
+					return this->left.apply(this->right.column(j));
+				}
+
+				constexpr Vec4<T> apply(const Vec4<T>& vec4) const
+				{
+					return this->left.apply(this->right.apply(vec4));
+				}
+		};
+
+		template <typename T> constexpr Matrix<T> lazy(const Mat4<T>& matrix)
+		{
+			return Matrix<T>(matrix);
+		}
+
+		template <typename T> constexpr Translation<T> translate(const Vec3<T>& translation)
+		{
+			return Translation<T>(translation);
+		}
+
+		template <typename T> constexpr Scale<T> scale(const Vec3<T>& scale)
+		{
+			return Scale<T>(scale);
+		}
+
+		template <typename T> constexpr Rotation<T> rotate(const Quat<T>& rotation)
+		{
+			return Rotation<T>(rotation);
+		}
+
+		template <typename L, typename R, typename = std::enable_if_t<isExpression<L> && isExpression<R>>>
+		constexpr Product<L, R> operator*(const L& left, const R& right)
+		{
+			return Product<L, R>(left, right);
+		}
+
+		template <typename L, typename T, typename = std::enable_if_t<isExpression<L>>>
+		constexpr Product<L, Matrix<T>> operator*(const L& left, const Mat4<T>& right)
+		{
+			return Product<L, Matrix<T>>(left, Matrix<T>(right));
+		}
+
+		template <typename T, typename R, typename = std::enable_if_t<isExpression<R>>>
+		constexpr Product<Matrix<T>, R> operator*(const Mat4<T>& left, const R& right)
+		{
+			return Product<Matrix<T>, R>(Matrix<T>(left), right);
+		}
+	}
+}
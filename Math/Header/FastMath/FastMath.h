@@ -0,0 +1,426 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "Utilities.h"
+#include "Simd/Simd.h"
+
+namespace lm
+{
+	// Polynomial sin / cos, acos, atan2 and rsqrt in float, for float, __m128 and __m256 lanes.
+	// Every kernel is written once over the lane operations below so a scalar call and a vector
+	// lane agree within the tier error, and the float version also works in constant expressions.
+	namespace fastmath
+	{
+		// bound on the absolute error in radians (relative for rsqrt), about 1.25 times the largest error
+		// MathBench --accuracy measures, which fails past them. rsqrt uses the 12 bits hardware estimate
+		// when SSE is on and a bit trick otherwise
+		//            sincos    acos      atan2     rsqrt (sse / scalar)
+		// LOW        4.0e-4    4.0e-3    2.0e-3    4.0e-4 / 2.2e-3
+		// MEDIUM     4.5e-6    8.5e-5    1.5e-5    3.0e-7 / 6.0e-6
+		// HIGH       1.1e-7    5.0e-7    3.5e-7    1.1e-7
+		enum class Precision
+		{
+			LOW,
+			MEDIUM,
+			HIGH
+		};
+
+		constexpr float pi = float(M_PI);
+		constexpr float halfPi = float(M_PI / 2);
+		constexpr float quarterPi = float(M_PI / 4);
+		constexpr float toRadians = float(M_PI / 180);
+		constexpr float toDegrees = float(180 / M_PI);
+
+		// the operations the kernels are written with, a mask is a bool for float and a lane of ones for registers
+		namespace lane
+		{
+			template <typename V> constexpr V set(const float value)
+			{
+				return value;
+			}
+
+			constexpr float load(const float* p, float)
+			{
+				return *p;
+			}
+
+			constexpr void store(float* p, const float v)
+			{
+				*p = v;
+			}
+
+			constexpr float add(const float a, const float b) { return a + b; }
+			constexpr float sub(const float a, const float b) { return a - b; }
+			constexpr float mul(const float a, const float b) { return a * b; }
+			constexpr float div(const float a, const float b) { return a / b; }
+			constexpr float madd(const float a, const float b, const float c) { return a * b + c; }
+			constexpr float min(const float a, const float b) { return a < b ? a : b; }
+			constexpr float max(const float a, const float b) { return a > b ? a : b; }
+			constexpr float abs(const float a) { return cmath::abs(a); }
+			constexpr float sqrt(const float a) { return cmath::sqrt(a); }
+			constexpr bool less(const float a, const float b) { return a < b; }
+			constexpr bool equal(const float a, const float b) { return a == b; }
+			constexpr float select(const bool mask, const float a, const float b) { return mask ? a : b; }
+			constexpr float negate(const bool mask, const float a) { return mask ? -a : a; }
+
+			// nearest integer, the kernels only reduce arguments far below the int range
+			constexpr float round(const float a)
+			{
+				return float(int64_t(a < 0 ? a - 0.5f : a + 0.5f));
+			}
+
+			// bit of an integer held in a float, two's complement so that -1 is the last quadrant
+			constexpr bool bit(const float a, const int bit)
+			{
+				return (int64_t(a) & bit) != 0;
+			}
+
+			// 12 bits estimate
+			constexpr float rsqrt(const float a)
+			{
+				if (LM_IS_CONSTANT_EVALUATED())
+					return 1 / cmath::sqrt(a);
+
+#if defined(LM_SIMD_SSE)
+				return _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(a)));
+#else
+				// bit trick with one newton step
+				uint32_t bits = 0;
+				std::memcpy(&bits, &a, sizeof(float));
+				bits = 0x5f375a86 - (bits >> 1);
+
+				float estimate = 0;
+				std::memcpy(&estimate, &bits, sizeof(float));
+				return estimate * (1.5f - 0.5f * a * estimate * estimate);
+#endif
+			}
+
+#if defined(LM_SIMD_SSE)
+			template <> inline __m128 set<__m128>(const float value) { return _mm_set1_ps(value); }
+
+			inline __m128 load(const float* p, __m128) { return _mm_loadu_ps(p); }
+			inline void store(float* p, const __m128 v) { _mm_storeu_ps(p, v); }
+
+			inline __m128 add(const __m128 a, const __m128 b) { return _mm_add_ps(a, b); }
+			inline __m128 sub(const __m128 a, const __m128 b) { return _mm_sub_ps(a, b); }
+			inline __m128 mul(const __m128 a, const __m128 b) { return _mm_mul_ps(a, b); }
+			inline __m128 div(const __m128 a, const __m128 b) { return _mm_div_ps(a, b); }
+			inline __m128 madd(const __m128 a, const __m128 b, const __m128 c) { return simd::madd(a, b, c); }
+			inline __m128 min(const __m128 a, const __m128 b) { return _mm_min_ps(a, b); }
+			inline __m128 max(const __m128 a, const __m128 b) { return _mm_max_ps(a, b); }
+			inline __m128 abs(const __m128 a) { return _mm_andnot_ps(_mm_set1_ps(-0.f), a); }
+			inline __m128 sqrt(const __m128 a) { return _mm_sqrt_ps(a); }
+			inline __m128 less(const __m128 a, const __m128 b) { return _mm_cmplt_ps(a, b); }
+			inline __m128 equal(const __m128 a, const __m128 b) { return _mm_cmpeq_ps(a, b); }
+			inline __m128 select(const __m128 mask, const __m128 a, const __m128 b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+			inline __m128 negate(const __m128 mask, const __m128 a) { return _mm_xor_ps(a, _mm_and_ps(mask, _mm_set1_ps(-0.f))); }
+			inline __m128 rsqrt(const __m128 a) { return _mm_rsqrt_ps(a); }
+
+			inline __m128 round(const __m128 a)
+			{
+				return _mm_cvtepi32_ps(_mm_cvtps_epi32(a));
+			}
+
+			inline __m128 bit(const __m128 a, const int bit)
+			{
+				const __m128i mask = _mm_set1_epi32(bit);
+				return _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(_mm_cvtps_epi32(a), mask), mask));
+			}
+#endif
+#if defined(LM_SIMD_AVX2)
+			template <> inline __m256 set<__m256>(const float value) { return _mm256_set1_ps(value); }
+
+			inline __m256 load(const float* p, __m256) { return _mm256_loadu_ps(p); }
+			inline void store(float* p, const __m256 v) { _mm256_storeu_ps(p, v); }
+
+			inline __m256 add(const __m256 a, const __m256 b) { return _mm256_add_ps(a, b); }
+			inline __m256 sub(const __m256 a, const __m256 b) { return _mm256_sub_ps(a, b); }
+			inline __m256 mul(const __m256 a, const __m256 b) { return _mm256_mul_ps(a, b); }
+			inline __m256 div(const __m256 a, const __m256 b) { return _mm256_div_ps(a, b); }
+			inline __m256 madd(const __m256 a, const __m256 b, const __m256 c) { return _mm256_fmadd_ps(a, b, c); }
+			inline __m256 min(const __m256 a, const __m256 b) { return _mm256_min_ps(a, b); }
+			inline __m256 max(const __m256 a, const __m256 b) { return _mm256_max_ps(a, b); }
+			inline __m256 abs(const __m256 a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.f), a); }
+			inline __m256 sqrt(const __m256 a) { return _mm256_sqrt_ps(a); }
+			inline __m256 less(const __m256 a, const __m256 b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+			inline __m256 equal(const __m256 a, const __m256 b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+			inline __m256 select(const __m256 mask, const __m256 a, const __m256 b) { return _mm256_blendv_ps(b, a, mask); }
+			inline __m256 negate(const __m256 mask, const __m256 a) { return _mm256_xor_ps(a, _mm256_and_ps(mask, _mm256_set1_ps(-0.f))); }
+			inline __m256 rsqrt(const __m256 a) { return _mm256_rsqrt_ps(a); }
+
+			inline __m256 round(const __m256 a)
+			{
+				return _mm256_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+			}
+
+			inline __m256 bit(const __m256 a, const int bit)
+			{
+				const __m256i mask = _mm256_set1_epi32(bit);
+				return _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(_mm256_cvtps_epi32(a), mask), mask));
+			}
+#endif
+
+			// kernel(i, V()) over [0, n), 8 then 4 then 1 float at a time
+			template <typename F> inline void forEach(const size_t n, F&& kernel)
+			{
+				size_t i = 0;
+#if defined(LM_SIMD_AVX2)
+				for (; i < (n & ~size_t(7)); i += 8)
+					kernel(i, __m256());
+#endif
+#if defined(LM_SIMD_SSE)
+				for (; i < (n & ~size_t(3)); i += 4)
+					kernel(i, __m128());
+#endif
+				for (; i < n; i++)
+					kernel(i, float());
+			}
+		}
+
+		// sin and cos of r in [-pi / 4, pi / 4], taylor series for LOW / MEDIUM and the cephes minimax polynomials for HIGH
+		template <Precision P, typename V> constexpr void sincosReduced(const V r, V& s, V& c)
+		{
+			using namespace lane;
+			const V r2 = mul(r, r);
+
+			V sp = set<V>(0);
+			V cp = set<V>(0);
+			if constexpr (P == Precision::LOW)
+			{
+				sp = madd(r2, set<V>(1.f / 120), set<V>(-1.f / 6));
+				cp = madd(r2, set<V>(1.f / 24), set<V>(-0.5f));
+			}
+			else if constexpr (P == Precision::MEDIUM)
+			{
+				sp = madd(r2, set<V>(-1.f / 5040), set<V>(1.f / 120));
+				sp = madd(sp, r2, set<V>(-1.f / 6));
+				cp = madd(r2, set<V>(-1.f / 720), set<V>(1.f / 24));
+				cp = madd(cp, r2, set<V>(-0.5f));
+			}
+			else
+			{
+				sp = madd(r2, set<V>(-1.9515295891e-4f), set<V>(8.3321608736e-3f));
+				sp = madd(sp, r2, set<V>(-1.6666654611e-1f));
+				cp = madd(r2, set<V>(2.443315711809948e-5f), set<V>(-1.388731625493765e-3f));
+				cp = madd(cp, r2, set<V>(4.166664568298827e-2f));
+				cp = madd(cp, r2, set<V>(-0.5f));
+			}
+
+			s = madd(mul(sp, r2), r, r);
+			c = madd(cp, r2, set<V>(1));
+		}
+
+		// r is the angle minus quadrant * pi / 2
+		template <Precision P, typename V> constexpr void sincosQuadrant(const V r, const V quadrant, V& s, V& c)
+		{
+			using namespace lane;
+			V rs = set<V>(0);
+			V rc = set<V>(0);
+			sincosReduced<P>(r, rs, rc);
+
+			const auto swap = bit(quadrant, 1);
+			s = negate(bit(quadrant, 2), select(swap, rc, rs));
+			c = negate(bit(add(quadrant, set<V>(1)), 2), select(swap, rs, rc));
+		}
+
+		// radians, pi / 2 is subtracted in three parts (Cody & Waite) so the error stays flat up to about 1e5
+		template <Precision P = Precision::HIGH, typename V> constexpr void sincos(const V x, V& s, V& c)
+		{
+			using namespace lane;
+			const V quadrant = round(mul(x, set<V>(float(2 / M_PI))));
+
+			V r = madd(quadrant, set<V>(-1.5703125f), x);
+			r = madd(quadrant, set<V>(-4.837512969970703125e-4f), r);
+			r = madd(quadrant, set<V>(-7.54978995489188216e-8f), r);
+			sincosQuadrant<P>(r, quadrant, s, c);
+		}
+
+		// degrees, the reduction is exact so multiples of 90 give exact zeros and ones
+		template <Precision P = Precision::HIGH, typename V> constexpr void sincosDeg(const V degrees, V& s, V& c)
+		{
+			using namespace lane;
+			const V quadrant = round(mul(degrees, set<V>(1.f / 90)));
+			const V r = mul(madd(quadrant, set<V>(-90), degrees), set<V>(toRadians));
+			sincosQuadrant<P>(r, quadrant, s, c);
+		}
+
+		// x in [-1, 1] (clamped), acos(x) = sqrt(1 - x) * p(x) on [0, 1] with A&S 4.4.45 / 4.4.46 for MEDIUM / HIGH
+		template <Precision P = Precision::HIGH, typename V> constexpr V acos(const V x)
+		{
+			using namespace lane;
+			const V a = min(abs(x), set<V>(1));
+
+			V p = set<V>(0);
+			if constexpr (P == Precision::LOW)
+			{
+				p = madd(a, set<V>(-0.168258065f), set<V>(1.567589363f));
+			}
+			else if constexpr (P == Precision::MEDIUM)
+			{
+				p = madd(a, set<V>(-0.0187293f), set<V>(0.0742610f));
+				p = madd(p, a, set<V>(-0.2121144f));
+				p = madd(p, a, set<V>(1.5707288f));
+			}
+			else
+			{
+				p = madd(a, set<V>(-0.0012624911f), set<V>(0.0066700901f));
+				p = madd(p, a, set<V>(-0.0170881256f));
+				p = madd(p, a, set<V>(0.0308918810f));
+				p = madd(p, a, set<V>(-0.0501743046f));
+				p = madd(p, a, set<V>(0.0889789874f));
+				p = madd(p, a, set<V>(-0.2145988016f));
+				p = madd(p, a, set<V>(1.5707963050f));
+			}
+
+			const V angle = mul(p, sqrt(sub(set<V>(1), a)));
+			return select(less(x, set<V>(0)), sub(set<V>(pi), angle), angle);
+		}
+
+		template <Precision P = Precision::HIGH, typename V> constexpr V acosDeg(const V x)
+		{
+			return lane::mul(acos<P>(x), lane::set<V>(toDegrees));
+		}
+
+		// atan of r in [0, 1]
+		template <Precision P, typename V> constexpr V atanUnit(const V r)
+		{
+			using namespace lane;
+			if constexpr (P == Precision::LOW)
+			{
+				// pi / 4 * r + r * (1 - r) * (0.2447 + 0.0663 * r)
+				const V p = madd(r, set<V>(0.0663f), set<V>(0.2447f));
+				return madd(mul(r, sub(set<V>(1), r)), p, mul(r, set<V>(quarterPi)));
+			}
+			else if constexpr (P == Precision::MEDIUM)
+			{
+				// A&S 4.4.49
+				const V r2 = mul(r, r);
+				V p = madd(r2, set<V>(0.0208351f), set<V>(-0.0851330f));
+				p = madd(p, r2, set<V>(0.1801410f));
+				p = madd(p, r2, set<V>(-0.3302995f));
+				p = madd(p, r2, set<V>(0.9998660f));
+				return mul(p, r);
+			}
+			else
+			{
+				// cephes, above tan(pi / 8) atan(r) = pi / 4 + atan((r - 1) / (r + 1))
+				const auto reduce = less(set<V>(0.4142135623730950f), r);
+				const V x = select(reduce, div(sub(r, set<V>(1)), add(r, set<V>(1))), r);
+				const V x2 = mul(x, x);
+
+				V p = madd(x2, set<V>(8.05374449538e-2f), set<V>(-1.38776856032e-1f));
+				p = madd(p, x2, set<V>(1.99777106478e-1f));
+				p = madd(p, x2, set<V>(-3.33329491539e-1f));
+				return add(madd(mul(p, x2), x, x), select(reduce, set<V>(quarterPi), set<V>(0)));
+			}
+		}
+
+		// finite inputs, atan2(0, 0) is 0 and a negative zero y counts as positive
+		template <Precision P = Precision::HIGH, typename V> constexpr V atan2(const V y, const V x)
+		{
+			using namespace lane;
+			const V ax = abs(x);
+			const V ay = abs(y);
+			const V high = max(ax, ay);
+			const V ratio = div(min(ax, ay), select(equal(high, set<V>(0)), set<V>(1), high));
+
+			V angle = atanUnit<P>(ratio);
+			angle = select(less(ax, ay), sub(set<V>(halfPi), angle), angle);
+			angle = select(less(x, set<V>(0)), sub(set<V>(pi), angle), angle);
+			return negate(less(y, set<V>(0)), angle);
+		}
+
+		template <Precision P = Precision::HIGH, typename V> constexpr V atan2Deg(const V y, const V x)
+		{
+			return lane::mul(atan2<P>(y, x), lane::set<V>(toDegrees));
+		}
+
+		// 1 / sqrt(x) for x > 0: the hardware estimate, plus a newton step for MEDIUM, a real division for HIGH
+		template <Precision P = Precision::HIGH, typename V> constexpr V rsqrt(const V x)
+		{
+			using namespace lane;
+			if constexpr (P == Precision::LOW)
+			{
+				return lane::rsqrt(x);
+			}
+			else if constexpr (P == Precision::MEDIUM)
+			{
+				// estimate * (1.5 - 0.5 * x * estimate^2)
+				const V estimate = lane::rsqrt(x);
+				const V half = mul(mul(x, set<V>(0.5f)), estimate);
+				return mul(estimate, madd(mul(half, estimate), set<V>(-1), set<V>(1.5f)));
+			}
+			else
+			{
+				return div(set<V>(1), sqrt(x));
+			}
+		}
+
+		// array versions, same contract as the lm::batch kernels: out[0, n) only depends on in[0, n)
+		template <Precision P = Precision::HIGH> inline void sincos(const float* x, float* s, float* c, size_t n)
+		{
+			lane::forEach(n, [&](const size_t i, auto tag)
+			{
+				decltype(tag) vs = tag;
+				decltype(tag) vc = tag;
+				sincos<P>(lane::load(x + i, tag), vs, vc);
+				lane::store(s + i, vs);
+				lane::store(c + i, vc);
+			});
+		}
+
+		template <Precision P = Precision::HIGH> inline void sincosDeg(const float* degrees, float* s, float* c, size_t n)
+		{
+			lane::forEach(n, [&](const size_t i, auto tag)
+			{
+				decltype(tag) vs = tag;
+				decltype(tag) vc = tag;
+				sincosDeg<P>(lane::load(degrees + i, tag), vs, vc);
+				lane::store(s + i, vs);
+				lane::store(c + i, vc);
+			});
+		}
+
+		template <Precision P = Precision::HIGH> inline void acos(const float* x, float* out, size_t n)
+		{
+			lane::forEach(n, [&](const size_t i, auto tag)
+			{
+				lane::store(out + i, acos<P>(lane::load(x + i, tag)));
+			});
+		}
+
+		template <Precision P = Precision::HIGH> inline void acosDeg(const float* x, float* out, size_t n)
+		{
+			lane::forEach(n, [&](const size_t i, auto tag)
+			{
+				lane::store(out + i, acosDeg<P>(lane::load(x + i, tag)));
+			});
+		}
+
+		template <Precision P = Precision::HIGH> inline void atan2(const float* y, const float* x, float* out, size_t n)
+		{
+			lane::forEach(n, [&](const size_t i, auto tag)
+			{
+				lane::store(out + i, atan2<P>(lane::load(y + i, tag), lane::load(x + i, tag)));
+			});
+		}
+
+		template <Precision P = Precision::HIGH> inline void atan2Deg(const float* y, const float* x, float* out, size_t n)
+		{
+			lane::forEach(n, [&](const size_t i, auto tag)
+			{
+				lane::store(out + i, atan2Deg<P>(lane::load(y + i, tag), lane::load(x + i, tag)));
+			});
+		}
+
+		template <Precision P = Precision::HIGH> inline void rsqrt(const float* x, float* out, size_t n)
+		{
+			lane::forEach(n, [&](const size_t i, auto tag)
+			{
+				lane::store(out + i, rsqrt<P>(lane::load(x + i, tag)));
+			});
+		}
+	}
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "Mat4/Mat4.h"
+#include "Plane/Plane.h"
+#include "AABB/AABB.h"
+#include "Sphere/Sphere.h"
+
+namespace lm
+{
+	// ZNEAR / ZFAR because windows.h defines near and far
+	enum class FrustumPlane
+	{
+		LEFT,
+		RIGHT,
+		BOTTOM,
+		TOP,
+		ZNEAR,
+		ZFAR
+	};
+
+	// six inward facing normalized planes, a point is inside when it is on the positive side of all of them
+	template <typename T> class Frustum
+	{
+		public:
+			static constexpr int planeCount = 6;
+
+			Plane<T> planes[planeCount];
+
+			constexpr Frustum() : planes()
+			{
+			}
+
+			constexpr Frustum(const Frustum<T>& frustum) = default;
+			constexpr Frustum(Frustum<T>&& frustum) noexcept = default;
+			constexpr Frustum<T>& operator=(const Frustum<T>& frustum) = default;
+			constexpr Frustum<T>& operator=(Frustum<T>&& frustum) noexcept = default;
+
+			// Gribb / Hartmann extraction from projection * view (world space planes),
+			// zeroToOne for a projection mapping depth to [0, 1] instead of [-1, 1]
+			static constexpr Frustum<T> fromMatrix(const Mat4<T>& viewProjection, const bool zeroToOne = false)
+			{
+				Vec4<T> rows[4];
+				for (int i = 0; i < 4; i++)
+					rows[i] = Vec4<T>(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+
+				Frustum<T> frustum;
+				frustum[FrustumPlane::LEFT] = Plane<T>(rows[3] + rows[0]).normalized();
+				frustum[FrustumPlane::RIGHT] = Plane<T>(rows[3] - rows[0]).normalized();
+				frustum[FrustumPlane::BOTTOM] = Plane<T>(rows[3] + rows[1]).normalized();
+				frustum[FrustumPlane::TOP] = Plane<T>(rows[3] - rows[1]).normalized();
+				frustum[FrustumPlane::ZNEAR] = Plane<T>(zeroToOne ? rows[2] : rows[3] + rows[2]).normalized();
+				frustum[FrustumPlane::ZFAR] = Plane<T>(rows[3] - rows[2]).normalized();
+				return frustum;
+			}
+
+			constexpr Plane<T>& operator[](const FrustumPlane plane)
+			{
+				return this->planes[static_cast<int>(plane)];
+			}
+
+			constexpr const Plane<T>& operator[](const FrustumPlane plane) const
+			{
+				return this->planes[static_cast<int>(plane)];
+			}
+
+			constexpr bool contains(const Vec3<T>& point) const
+			{
+				for (int i = 0; i < planeCount; i++)
+					if (this->planes[i].signedDistance(point) < 0)
+						return false;
+
+				return true;
+			}
+
+			constexpr bool intersects(const Sphere<T>& sphere) const
+			{
+				for (int i = 0; i < planeCount; i++)
+					if (this->planes[i].signedDistance(sphere.center) < -sphere.radius)
+						return false;
+
+				return true;
+			}
+
+			// conservative: a box outside of no single plane counts as visible
+			constexpr bool intersects(const AABB<T>& aabb) const
+			{
+				const Vec3<T> center = aabb.center();
+				const Vec3<T> extents = aabb.extents();
+
+				for (int i = 0; i < planeCount; i++)
+				{
+					const Vec3<T>& normal = this->planes[i].normal;
+					const T radius = cmath::abs(normal.X()) * extents.X() + cmath::abs(normal.Y()) * extents.Y() + cmath::abs(normal.Z()) * extents.Z();
+					if (this->planes[i].signedDistance(center) < -radius)
+						return false;
+				}
+
+				return true;
+			}
+	};
+
+	typedef Frustum<float> frustum;
+}
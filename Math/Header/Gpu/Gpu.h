@@ -0,0 +1,199 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "Vectors.h"
+#include "Matrices.h"
+
+namespace lm
+{
+	// host mirrors of the GLSL std140 (uniform blocks) and std430 (storage blocks) memory layouts
+	namespace gpu
+	{
+		enum class Layout
+		{
+			STD140,
+			STD430
+		};
+
+		constexpr size_t alignUp(const size_t value, const size_t alignment)
+		{
+			return (value + alignment - 1) / alignment * alignment;
+		}
+
+		// a GLSL mat3 is stored as three vec4 columns in both layouts
+		template <typename T> class alignas(4 * sizeof(T)) Mat3x4
+		{
+			public:
+				Vec4<T> columns[3];
+
+				constexpr Mat3x4() : columns{ Vec4<T>(1, 0, 0, 0), Vec4<T>(0, 1, 0, 0), Vec4<T>(0, 0, 1, 0) }
+				{
+				}
+
+				constexpr Mat3x4(const Mat3<T>& mat3) : columns{ Vec4<T>(mat3[0]), Vec4<T>(mat3[1]), Vec4<T>(mat3[2]) }
+				{
+				}
+
+				constexpr Mat3<T> toMat3() const
+				{
+					return Mat3<T>(Vec3<T>(this->columns[0].X(), this->columns[0].Y(), this->columns[0].Z()),
+								   Vec3<T>(this->columns[1].X(), this->columns[1].Y(), this->columns[1].Z()),
+								   Vec3<T>(this->columns[2].X(), this->columns[2].Y(), this->columns[2].Z()));
+				}
+		};
+
+		typedef Mat3x4<float> mat3x4;
+
+		// Storage is what ends up in the buffer, size the bytes it covers (a vec3 leaves its last 4 bytes to the next scalar)
+		template <typename S, size_t A, size_t Size, Layout L> struct Rules
+		{
+			typedef S Storage;
+			static constexpr size_t alignment = A;
+			static constexpr size_t size = Size;
+
+			// std140 rounds array elements up to a vec4
+			static constexpr size_t arrayAlignment = L == Layout::STD140 ? alignUp(A, 16) : A;
+			static constexpr size_t arrayStride = alignUp(Size, arrayAlignment);
+
+			template <typename T> static constexpr Storage store(const T& value)
+			{
+				return Storage(value);
+			}
+		};
+
+		template <typename T, Layout L> struct Traits;
+
+		template <Layout L> struct Traits<float, L> : Rules<float, 4, 4, L> {};
+		template <Layout L> struct Traits<int32_t, L> : Rules<int32_t, 4, 4, L> {};
+		template <Layout L> struct Traits<uint32_t, L> : Rules<uint32_t, 4, 4, L> {};
+		template <Layout L> struct Traits<bool, L> : Rules<uint32_t, 4, 4, L> {};
+		template <typename T, Layout L> struct Traits<Vec2<T>, L> : Rules<Vec2<T>, 2 * sizeof(T), 2 * sizeof(T), L> {};
+		template <typename T, Layout L> struct Traits<Vec3<T>, L> : Rules<Vec3<T>, 4 * sizeof(T), 3 * sizeof(T), L> {};
+		template <typename T, Layout L> struct Traits<Vec4<T>, L> : Rules<Vec4<T>, 4 * sizeof(T), 4 * sizeof(T), L> {};
+		template <typename T, Layout L> struct Traits<Mat3<T>, L> : Rules<Mat3x4<T>, 4 * sizeof(T), 12 * sizeof(T), L> {};
+		template <typename T, Layout L> struct Traits<Mat3x4<T>, L> : Rules<Mat3x4<T>, 4 * sizeof(T), 12 * sizeof(T), L> {};
+		template <typename T, Layout L> struct Traits<Mat4<T>, L> : Rules<Mat4<T>, 4 * sizeof(T), 16 * sizeof(T), L> {};
+
+		// block member with the GLSL alignment, a std140<vec3> takes 16 bytes so put scalars before it
+		template <typename T, Layout L> class Member
+		{
+			public:
+				typedef typename Traits<T, L>::Storage Storage;
+
+				alignas(Traits<T, L>::alignment) Storage value;
+
+				constexpr Member() : value()
+				{
+				}
+
+				constexpr Member(const T& value) : value(Traits<T, L>::store(value))
+				{
+				}
+
+				constexpr Member<T, L>& operator=(const T& value)
+				{
+					this->value = Traits<T, L>::store(value);
+					return *this;
+				}
+		};
+
+		// block array, every element sits at the GLSL array stride
+		template <typename T, size_t N, Layout L> class Array
+		{
+			public:
+				typedef typename Traits<T, L>::Storage Storage;
+
+				struct alignas(Traits<T, L>::arrayAlignment) Element
+				{
+					Storage value;
+				};
+
+				static_assert(sizeof(Element) == Traits<T, L>::arrayStride, "host padding does not match the GLSL array stride");
+
+				Element elements[N];
+
+				constexpr Storage& operator[](const size_t idx)
+				{
+					return this->elements[idx].value;
+				}
+
+				constexpr const Storage& operator[](const size_t idx) const
+				{
+					return this->elements[idx].value;
+				}
+
+				constexpr size_t size() const
+				{
+					return N;
+				}
+		};
+
+		template <typename T> using std140 = Member<T, Layout::STD140>;
+		template <typename T> using std430 = Member<T, Layout::STD430>;
+		template <typename T, size_t N> using std140Array = Array<T, N, Layout::STD140>;
+		template <typename T, size_t N> using std430Array = Array<T, N, Layout::STD430>;
+
+		template <typename T> constexpr size_t std140Alignment = Traits<T, Layout::STD140>::alignment;
+		template <typename T> constexpr size_t std430Alignment = Traits<T, Layout::STD430>::alignment;
+
+		// writes block members one after the other at their GLSL offsets, straight into mapped memory.
+		// Without a destination it only computes the offsets, which also works at compile time.
+		template <Layout L> class Packer
+		{
+			private:
+				unsigned char* mData;
+				size_t mOffset;
+
+			public:
+				constexpr Packer() : mData(nullptr), mOffset(0)
+				{
+				}
+
+				Packer(void* pData) : mData(static_cast<unsigned char*>(pData)), mOffset(0)
+				{
+				}
+
+				template <typename T> constexpr Packer<L>& write(const T& pValue)
+				{
+					this->mOffset = alignUp(this->mOffset, Traits<T, L>::alignment);
+					if (this->mData != nullptr)
+					{
+						const typename Traits<T, L>::Storage storage = Traits<T, L>::store(pValue);
+						std::memcpy(this->mData + this->mOffset, &storage, Traits<T, L>::size);
+					}
+
+					this->mOffset += Traits<T, L>::size;
+					return *this;
+				}
+
+				// the first pCount elements of an array member
+				template <typename T> constexpr Packer<L>& write(const T* pValues, const size_t pCount)
+				{
+					this->mOffset = alignUp(this->mOffset, Traits<T, L>::arrayAlignment);
+					if (this->mData != nullptr)
+					{
+						for (size_t i = 0; i < pCount; i++)
+						{
+							const typename Traits<T, L>::Storage storage = Traits<T, L>::store(pValues[i]);
+							std::memcpy(this->mData + this->mOffset + i * Traits<T, L>::arrayStride, &storage, Traits<T, L>::size);
+						}
+					}
+
+					this->mOffset += pCount * Traits<T, L>::arrayStride;
+					return *this;
+				}
+
+				// bytes written so far, what has to be flushed or copied
+				constexpr size_t offset() const
+				{
+					return this->mOffset;
+				}
+		};
+
+		typedef Packer<Layout::STD140> Std140Packer;
+		typedef Packer<Layout::STD430> Std430Packer;
+	}
+}
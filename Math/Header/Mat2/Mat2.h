@@ -12,65 +12,28 @@ namespace lm
 	public:
 		static const Mat2<T> identity;
 
-		Mat2()
+		constexpr Mat2() : matrix{ Vec2<T>(1, 0), Vec2<T>(0, 1) }
 		{
-			this->matrix[0] = Vec2<T>(1, 0);
-			this->matrix[1] = Vec2<T>(0, 1);
 		}
 
-		Mat2(const T init)
+		constexpr Mat2(const T init) : matrix{ Vec2<T>(init, 0), Vec2<T>(0, init) }
 		{
-			this->matrix[0] = Vec2<T>(init, 0);
-			this->matrix[1] = Vec2<T>(0, init);
 		}
 
-		Mat2(const T x, const T y, const T z, const T w)
+		constexpr Mat2(const T x, const T y, const T z, const T w) : matrix{ Vec2<T>(x, y), Vec2<T>(z, w) }
 		{
-			this->matrix[0] = Vec2<T>(x, y);
-			this->matrix[1] = Vec2<T>(z, w);
 		}
 
-		Mat2(const Vec2<T>& vec1, const Vec2<T>& vec2)
+		constexpr Mat2(const Vec2<T>& vec1, const Vec2<T>& vec2) : matrix{ vec1, vec2 }
 		{
-			this->matrix[0] = vec1;
-			this->matrix[1] = vec2;
 		}
 
-		Mat2(const Mat2<T>& mat2)
-		{
-			this->matrix[0] = mat2.matrix[0];
-			this->matrix[1] = mat2.matrix[1];
-		}
-
-		Mat2(Mat2<T>&& mat2)
-		{
-			this->matrix[0] = std::move(mat2.matrix[0]);
-			this->matrix[1] = std::move(mat2.matrix[1]);
-		}
-
-		Mat2<T>& operator=(const Mat2<T>& mat2)
-		{
-			if (this == &mat2)
-				return *this;
-
-			this->matrix[0] = mat2.matrix[0];
-			this->matrix[1] = mat2.matrix[1];
-
-			return *this;
-		}
-
-		Mat2<T>& operator=(Mat2<T>&& mat2) noexcept
-		{
-			if (this == &mat2)
-				return *this;
-
-			this->matrix[0] = std::move(mat2.matrix[0]);
-			this->matrix[1] = std::move(mat2.matrix[1]);
-
-			return *this;
-		}
+		constexpr Mat2(const Mat2<T>& mat2) = default;
+		constexpr Mat2(Mat2<T>&& mat2) noexcept = default;
+		constexpr Mat2<T>& operator=(const Mat2<T>& mat2) = default;
+		constexpr Mat2<T>& operator=(Mat2<T>&& mat2) noexcept = default;
 
-		const T operator[](int idx) const
+		constexpr const T operator[](int idx) const
 		{
 			unsigned int vecIdx = idx / 2;
 			idx = idx % 2;
@@ -98,7 +61,7 @@ namespace lm
 			}
 		}
 
-		const T operator[](const char* idx) const
+		constexpr const T operator[](const char* idx) const
 		{
 			unsigned int vecIdx = idx[1] - '1';
 			switch (idx[0])
@@ -110,7 +73,7 @@ namespace lm
 			}
 		}
 
-		T& operator[](const char* idx)
+		constexpr T& operator[](const char* idx)
 		{
 			unsigned int vecIdx = idx[1] - '1';
 			switch (idx[0])
@@ -122,7 +85,7 @@ namespace lm
 			}
 		}
 
-		Mat2<T> scale(const float scale) const
+		constexpr Mat2<T> scale(const float scale) const
 		{
 			Mat2<T> mat2(*this);
 			for (unsigned int i = 0; i < 2; i++)
@@ -145,7 +108,7 @@ namespace lm
 			return *this;
 		}
 
-		Mat2<T> dot_product(const Mat2<T>& mat2) const
+		constexpr Mat2<T> dot_product(const Mat2<T>& mat2) const
 		{
 			return Mat2<T>(((this->matrix[0].X() * mat2.matrix[0].X()) + (this->matrix[0].Y() * mat2.matrix[1].X())),
 						  ((this->matrix[0].X() * mat2.matrix[0].Y()) + (this->matrix[0].Y() * mat2.matrix[1].Y())),
@@ -153,22 +116,22 @@ namespace lm
 						  ((this->matrix[1].X() * mat2.matrix[0].Y()) + (this->matrix[1].Y() * mat2.matrix[1].Y())));
 		}
 
-		Mat2<T> transpose() const
+		constexpr Mat2<T> transpose() const
 		{
 			return Mat2<T>(this->matrix[0].X(), this->matrix[1].X(), this->matrix[0].Y(), this->matrix[1].Y());
 		}
 
-		const T determinant() const
+		constexpr const T determinant() const
 		{
 			return (this->matrix[0].X() * this->matrix[1].Y()) - (this->matrix[0].Y() * this->matrix[1].X());
 		}
 
-		Mat2<T> minor() const
+		constexpr Mat2<T> minor() const
 		{
 			return Mat2<T>(this->matrix[1].Y(), this->matrix[1].X(), this->matrix[0].Y(), this->matrix[0].X());
 		}
 
-		Mat2<T> cofactor() const
+		constexpr Mat2<T> cofactor() const
 		{
 			Mat2<T> min = this->minor();
 			min.matrix[0].Y() *= -1;
@@ -176,14 +139,14 @@ namespace lm
 			return min;
 		}
 
-		Mat2<T> adjugate() const
+		constexpr Mat2<T> adjugate() const
 		{
 			Mat2<T> cof = this->cofactor();
 			cof = cof.transpose();
 			return cof;
 		}
 
-		Mat2<T> inverse() const
+		constexpr Mat2<T> inverse() const
 		{
 			const T determinant = this->determinant();
 			const T div = 1.0f / determinant;
@@ -192,7 +155,7 @@ namespace lm
 			return Mat2<T>(mat2.matrix[0].X() * div, mat2.matrix[0].Y() * div, mat2.matrix[1].X() * div, mat2.matrix[1].Y() * div);
 		}
 
-		Mat2<T> operator*(const float scale) const
+		constexpr Mat2<T> operator*(const float scale) const
 		{
 			return this->scale(scale);
 		}
@@ -202,7 +165,7 @@ namespace lm
 			*this = this->scale(scale);
 		}
 
-		Mat2<T> operator*(const Mat2<T>& mat2) const
+		constexpr Mat2<T> operator*(const Mat2<T>& mat2) const
 		{
 			return this->dot_product(mat2);
 		}
@@ -224,7 +187,7 @@ namespace lm
 		}
 	};
 
-	template<class T> const Mat2<T> Mat2<T>::identity = Mat2<T>();
+	template<class T> constexpr Mat2<T> Mat2<T>::identity = Mat2<T>();
 
 	typedef Mat2<float> mat2;
 }
\ No newline at end of file
@@ -13,82 +13,44 @@ namespace lm
 		public:
 			static const Mat3<T> identity;
 
-			Mat3()
+			constexpr Mat3() : matrix{ Vec3<T>(1, 0, 0), Vec3<T>(0, 1, 0), Vec3<T>(0, 0, 1) }
 			{
-				this->matrix[0] = Vec3<T>(1, 0, 0);
-				this->matrix[1] = Vec3<T>(0, 1, 0);
-				this->matrix[2] = Vec3<T>(0, 0, 1);
 			}
 
-			Mat3(const T init)
+			constexpr Mat3(const T init) : matrix{ Vec3<T>(init, 0, 0), Vec3<T>(0, init, 0), Vec3<T>(0, 0, init) }
 			{
-				this->matrix[0] = Vec3<T>(init, 0, 0);
-				this->matrix[1] = Vec3<T>(0, init, 0);
-				this->matrix[2] = Vec3<T>(0, 0, init);
 			}
 
-			Mat3(const Vec3<T>& v1, const Vec3<T>& v2, const Vec3<T>& v3)
+			constexpr Mat3(const Vec3<T>& v1, const Vec3<T>& v2, const Vec3<T>& v3) : matrix{ v1, v2, v3 }
 			{
-				this->matrix[0] = v1;
-				this->matrix[1] = v2;
-				this->matrix[2] = v3;
 			}
 
-			Mat3(const Mat3<T>& mat3)
+			constexpr Mat3(const Mat4<T>& mat4) : matrix{ Vec3<T>(mat4[0].X(), mat4[0].Y(), mat4[0].Z()),
+														Vec3<T>(mat4[1].X(), mat4[1].Y(), mat4[1].Z()),
+														Vec3<T>(mat4[2].X(), mat4[2].Y(), mat4[2].Z()) }
 			{
-				for (unsigned int i = 0; i < 3; i++)
-					this->matrix[i] = mat3.matrix[i];
-			}
-
-			Mat3(const Mat4<T>& mat4)
-			{
-				for (unsigned int i = 0; i < 3; i++)
-					this->matrix[i] = Vec3<T>(mat4[i].X(), mat4[i].Y(), mat4[i].Z());
-			}
-
-			Mat3(Mat3<T>&& mat3) noexcept
-			{
-				for (unsigned int i = 0; i < 3; i++)
-					this->matrix[i] = std::move(mat3.matrix[i]);
-			}
-
-			Mat3<T>& operator=(const Mat3<T>& mat3)
-			{
-				if (this == &mat3)
-					return *this;
-
-				for (unsigned int i = 0; i < 3; i++)
-					this->matrix[i] = mat3.matrix[i];
-
-				return *this;
 			}
 
-			Mat3<T>& operator=(Mat3<T>&& mat3) noexcept
-			{
-				if (this == &mat3)
-					return *this;
-
-				for (unsigned int i = 0; i < 3; i++)
-					this->matrix[i] = std::move(mat3.matrix[i]);
-
-				return *this;
-			}
+			constexpr Mat3(const Mat3<T>& mat3) = default;
+			constexpr Mat3(Mat3<T>&& mat3) noexcept = default;
+			constexpr Mat3<T>& operator=(const Mat3<T>& mat3) = default;
+			constexpr Mat3<T>& operator=(Mat3<T>&& mat3) noexcept = default;
 
-			const Vec3<T> operator[](int idx) const
+			constexpr const Vec3<T> operator[](int idx) const
 			{
 				if (idx >= 0 && idx < 3)
 					return this->matrix[idx];
 				return this->matrix[0];
 			}
 
-			Vec3<T>& operator[](int idx)
+			constexpr Vec3<T>& operator[](int idx)
 			{
 				if (idx >= 0 && idx < 3)
 					return this->matrix[idx];
 				return this->matrix[0];
 			}
 
-			const T operator[](const char* idx) const
+			constexpr const T operator[](const char* idx) const
 			{
 				unsigned int vecIdx = idx[1] - '1';
 				switch (idx[0])
@@ -101,7 +63,7 @@ namespace lm
 				}
 			}
 
-			T& operator[](const char* idx)
+			constexpr T& operator[](const char* idx)
 			{
 				unsigned int vecIdx = idx[1] - '1';
 				switch (idx[0])
@@ -114,7 +76,52 @@ namespace lm
 				}
 			}
 
-			Mat3<T> scale(const float scale) const
+			constexpr T* data()
+			{
+				return this->matrix[0].data();
+			}
+
+			constexpr const T* data() const
+			{
+				return this->matrix[0].data();
+			}
+
+			// inverse transpose of the upper 3x3 of an affine matrix, same result as
+			// Mat3(mat4).inverse().transpose() from three cross products
+			static constexpr Mat3<T> normalMatrix(const Mat4<T>& mat4)
+			{
+				Mat3<T> normal;
+				if constexpr (simd::accelerated<T>)
+				{
+					if (!LM_IS_CONSTANT_EVALUATED())
+					{
+						simd::normalMatrix(mat4.data(), normal.data());
+						return normal;
+					}
+				}
+
+				const Vec3<T> c0(mat4[0].X(), mat4[0].Y(), mat4[0].Z());
+				const Vec3<T> c1(mat4[1].X(), mat4[1].Y(), mat4[1].Z());
+				const Vec3<T> c2(mat4[2].X(), mat4[2].Y(), mat4[2].Z());
+
+				normal.matrix[0] = c1.crossProduct(c2);
+				normal.matrix[1] = c2.crossProduct(c0);
+				normal.matrix[2] = c0.crossProduct(c1);
+
+				const T det = c0.dotProduct(normal.matrix[0]);
+				if (det == 0)
+					return Mat3<T>::identity;
+
+				return normal.scale(T(1) / det);
+			}
+
+			// normal matrix of rotation * scale(pScale) when both parts are known: rotation * scale(1 / pScale)
+			static constexpr Mat3<T> normalMatrix(const Mat3<T>& rotation, const Vec3<T>& pScale)
+			{
+				return Mat3<T>(rotation.matrix[0] / pScale.X(), rotation.matrix[1] / pScale.Y(), rotation.matrix[2] / pScale.Z());
+			}
+
+			constexpr Mat3<T> scale(const float scale) const
 			{
 				Mat3<T> mat3(*this);
 				for (unsigned int i = 0; i < 3; i++)
@@ -127,7 +134,7 @@ namespace lm
 				return mat3;
 			}
 
-			Mat3<T>& scale(const float scale)
+			constexpr Mat3<T>& scale(const float scale)
 			{
 				for (unsigned int i = 0; i < 3; i++)
 				{
@@ -139,7 +146,7 @@ namespace lm
 				return *this;
 			}
 
-			Mat3<T> dotProduct(const Mat3<T>& mat3) const
+			constexpr Mat3<T> dotProduct(const Mat3<T>& mat3) const
 			{
 				Mat3<T> newMat3;
 
@@ -158,21 +165,21 @@ namespace lm
 				return newMat3;
 			}
 
-			Mat3<T> transpose() const
+			constexpr Mat3<T> transpose() const
 			{
 				return Mat3<T>(Vec3<T>(this->matrix[0].X(), this->matrix[1].X(), this->matrix[2].X()),
 								Vec3<T>(this->matrix[0].Y(), this->matrix[1].Y(), this->matrix[2].Y()),
 								Vec3<T>(this->matrix[0].Z(), this->matrix[1].Z(), this->matrix[2].Z()));
 			}
 
-			const T determinant() const
+			constexpr const T determinant() const
 			{
 				return ((this->matrix[0].X() * ((this->matrix[1].Y() * this->matrix[2].Z()) - (this->matrix[1].Z() * this->matrix[2].Y()))) -
 					    (this->matrix[0].Y() * ((this->matrix[1].X() * this->matrix[2].Z()) - (this->matrix[1].Z() * this->matrix[2].X()))) +
 					    (this->matrix[0].Z() * ((this->matrix[1].X() * this->matrix[2].Y()) - (this->matrix[1].Y() * this->matrix[2].X()))));
 			}
 
-			Mat3<T> minor() const
+			constexpr Mat3<T> minor() const
 			{
 				Mat3<T> newMat3;
 				newMat3.matrix[0].X() = ((this->matrix[1].Y() * this->matrix[2].Z()) - (this->matrix[1].Z() * this->matrix[2].Y()));
@@ -190,7 +197,7 @@ namespace lm
 				return newMat3;
 			}
 
-			Mat3<T> cofactor() const
+			constexpr Mat3<T> cofactor() const
 			{
 				Mat3<T> min = this->minor();
 				min.matrix[0].Y() *= -1;
@@ -200,14 +207,14 @@ namespace lm
 				return min;
 			}
 
-			Mat3<T> adjugate() const
+			constexpr Mat3<T> adjugate() const
 			{
 				Mat3<T> cof = this->cofactor();
 				cof = cof.transpose();
 				return cof;
 			}
 
-			Mat3<T> inverse() const
+			constexpr Mat3<T> inverse() const
 			{
 				const T determinant = this->determinant();
 				const T div = 1.0f / determinant;
@@ -218,22 +225,22 @@ namespace lm
 								Vec3<T>(mat3.matrix[2].X() * div, mat3.matrix[2].Y() * div, mat3.matrix[2].Z() * div));
 			}
 
-			Mat3<T> operator*(const float scale) const
+			constexpr Mat3<T> operator*(const float scale) const
 			{
 				return this->scale(scale);
 			}
 
-			void operator*=(const float scale)
+			constexpr void operator*=(const float scale)
 			{
 				*this = this->scale(scale);
 			}
 
-			Mat3<T> operator*(const Mat3<T>& mat3) const
+			constexpr Mat3<T> operator*(const Mat3<T>& mat3) const
 			{
 				return this->dotProduct(mat3);
 			}
 
-			Vec3<T> operator*(const Vec3<T>& vec3)
+			constexpr Vec3<T> operator*(const Vec3<T>& vec3) const
 			{
 				Vec3<T> newVec3;
 				newVec3.X() = (this->matrix[0].X() * vec3.X()) + (this->matrix[1].X() * vec3.Y()) + (this->matrix[2].X() * vec3.Z());
@@ -242,7 +249,7 @@ namespace lm
 				return newVec3;
 			}
 			
-			void operator*=(const Mat3<T>& mat3)
+			constexpr void operator*=(const Mat3<T>& mat3)
 			{
 				*this = this->dotProduct(mat3);
 			}
@@ -265,7 +272,7 @@ namespace lm
 			}
 	};
 
-	template<class T> const Mat3<T> Mat3<T>::identity = Mat3<T>();
+	template<class T> constexpr Mat3<T> Mat3<T>::identity = Mat3<T>();
 
 	typedef Mat3<float> mat3;
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Vec4/Vec4.h"
+#include "FastMath/FastMath.h"
 
 namespace lm
 {
@@ -12,79 +13,38 @@ namespace lm
 	public:
 		static const Mat4<T> identity;
 
-		Mat4()
+		constexpr Mat4() : matrix{ Vec4<T>(1, 0, 0, 0), Vec4<T>(0, 1, 0, 0), Vec4<T>(0, 0, 1, 0), Vec4<T>(0, 0, 0, 1) }
 		{
-			this->matrix[0] = Vec4<T>(1, 0, 0, 0);
-			this->matrix[1] = Vec4<T>(0, 1, 0, 0);
-			this->matrix[2] = Vec4<T>(0, 0, 1, 0);
-			this->matrix[3] = Vec4<T>(0, 0, 0, 1);
 		}
 
-		Mat4(const T init)
+		constexpr Mat4(const T init) : matrix{ Vec4<T>(init, 0, 0, 0), Vec4<T>(0, init, 0, 0), Vec4<T>(0, 0, init, 0), Vec4<T>(0, 0, 0, 1) }
 		{
-			this->matrix[0] = Vec4<T>(init, 0, 0, 0);
-			this->matrix[1] = Vec4<T>(0, init, 0, 0);
-			this->matrix[2] = Vec4<T>(0, 0, init, 0);
-			this->matrix[3] = Vec4<T>(0, 0, 0, 1);
 		}
 
-		Mat4(const Vec4<T>& v1, const Vec4<T>& v2, const Vec4<T>& v3, const Vec4<T>& v4)
+		constexpr Mat4(const Vec4<T>& v1, const Vec4<T>& v2, const Vec4<T>& v3, const Vec4<T>& v4) : matrix{ v1, v2, v3, v4 }
 		{
-			this->matrix[0] = v1;
-			this->matrix[1] = v2;
-			this->matrix[2] = v3;
-			this->matrix[3] = v4;
 		}
 
-		Mat4(const Mat4<T>& mat4)
-		{
-			for (unsigned int i = 0; i < 4; i++)
-				this->matrix[i] = mat4.matrix[i];
-		}
-
-		Mat4(Mat4<T>&& mat4) noexcept
-		{
-			for (unsigned int i = 0; i < 4; i++)
-				this->matrix[i] = std::move(mat4.matrix[i]);
-		}
-
-		Mat4<T>& operator=(const Mat4<T>& mat4)
-		{
-			if (this == &mat4)
-				return *this;
-
-			for (unsigned int i = 0; i < 4; i++)
-				this->matrix[i] = mat4.matrix[i];
-
-			return *this;
-		}
-
-		Mat4<T>& operator=(Mat4<T>&& mat4) noexcept
-		{
-			if (this == &mat4)
-				return *this;
-
-			for (unsigned int i = 0; i < 4; i++)
-				this->matrix[i] = std::move(mat4.matrix[i]);
-
-			return *this;
-		}
+		constexpr Mat4(const Mat4<T>& mat4) = default;
+		constexpr Mat4(Mat4<T>&& mat4) noexcept = default;
+		constexpr Mat4<T>& operator=(const Mat4<T>& mat4) = default;
+		constexpr Mat4<T>& operator=(Mat4<T>&& mat4) noexcept = default;
 
-		const Vec4<T> operator[](int idx) const
+		constexpr const Vec4<T> operator[](int idx) const
 		{
 			if (idx >= 0 && idx < 4)
 				return this->matrix[idx];
 			return this->matrix[0];
 		}
 
-		Vec4<T>& operator[](int idx)
+		constexpr Vec4<T>& operator[](int idx)
 		{
 			if (idx >= 0 && idx < 4)
 				return this->matrix[idx];
 			return this->matrix[0];
 		}
 
-		const T operator[](const char* idx) const
+		constexpr const T operator[](const char* idx) const
 		{
 			unsigned int vecIdx = idx[1] - '1';
 			switch (idx[0])
@@ -98,7 +58,7 @@ namespace lm
 			}
 		}
 
-		T& operator[](const char* idx)
+		constexpr T& operator[](const char* idx)
 		{
 			unsigned int vecIdx = idx[1] - '0';
 			switch (idx[0])
@@ -112,27 +72,32 @@ namespace lm
 			}
 		}
 
-		Mat4<T> operator*(const Mat4<T>& mat4) const
+		constexpr T* data()
 		{
-			Mat4<T> newMat4;
+			return this->matrix[0].data();
+		}
 
-			for (unsigned int i = 0; i < 4; i++)
+		constexpr const T* data() const
+		{
+			return this->matrix[0].data();
+		}
+
+		constexpr Mat4<T> operator*(const Mat4<T>& mat4) const
+		{
+			if constexpr (simd::accelerated<T>)
 			{
-				Vec4<T> vec4;
-				for (unsigned int j = 0; j < 4; j++)
+				if (!LM_IS_CONSTANT_EVALUATED())
 				{
-					vec4[j] = this->matrix[0][j] * mat4.matrix[i].X()
-						+ this->matrix[1][j] * mat4.matrix[i].Y()
-						+ this->matrix[2][j] * mat4.matrix[i].Z()
-						+ this->matrix[3][j] * mat4.matrix[i].W();
+					Mat4<T> newMat4;
+					simd::multiply(this->data(), mat4.data(), newMat4.data());
+					return newMat4;
 				}
-				newMat4.matrix[i] = vec4;
 			}
-			
-			return newMat4;
+
+			return scalarMultiply(*this, mat4);
 		}
 
-		Mat4<T> operator+(const Mat4<T>& mat4)
+		constexpr Mat4<T> operator+(const Mat4<T>& mat4) const
 		{
 			Mat4<T> newMat4 = *this;
 
@@ -144,22 +109,32 @@ namespace lm
 			return newMat4;
 		}
 		
-		Vec4<T> operator*(const Vec4<T>& vec4) const
+		constexpr Vec4<T> operator*(const Vec4<T>& vec4) const
 		{
-			Vec4<T> newVec4;
-			newVec4.X() = (this->matrix[0][0] * vec4.X()) + (this->matrix[1].X() * vec4.Y()) + (this->matrix[2].X() * vec4.Z()) + (this->matrix[3].X() * vec4.W());
-			newVec4.Y() = (this->matrix[0][1] * vec4.X()) + (this->matrix[1].Y() * vec4.Y()) + (this->matrix[2].Y() * vec4.Z()) + (this->matrix[3].Y() * vec4.W());
-			newVec4.Z() = (this->matrix[0].Z() * vec4.X()) + (this->matrix[1].Z() * vec4.Y()) + (this->matrix[2].Z() * vec4.Z()) + (this->matrix[3].Z() * vec4.W());
-			newVec4.W() = (this->matrix[0].W() * vec4.X()) + (this->matrix[1].W() * vec4.Y()) + (this->matrix[2].W() * vec4.Z()) + (this->matrix[3].W() * vec4.W());
-			return newVec4;
+			if constexpr (simd::accelerated<T>)
+			{
+				if (!LM_IS_CONSTANT_EVALUATED())
+				{
+					Vec4<T> newVec4;
+					simd::transform(this->data(), vec4.data(), newVec4.data());
+					return newVec4;
+				}
+			}
+
+			return scalarTransform(*this, vec4);
 		}
 
-		static Mat4<T> createTransformMatrix(const Vec3<T>& position, const Vec3<T>& rotation, const Vec3<T>& scaleVec)
+		static constexpr Mat4<T> createTransformMatrix(const Vec3<T>& position, const Vec3<T>& rotation, const Vec3<T>& scaleVec)
 		{
 			return translation(position) * yRotation(rotation.Y()) * xRotation(rotation.X()) * zRotation(rotation.Z()) * scale(scaleVec);
 		}
 
-		static Mat4<T> lookAt(const lm::vec3& eye, const lm::vec3& center, const lm::vec3& up)
+		template <fastmath::Precision P> static constexpr Mat4<T> createTransformMatrix(const Vec3<T>& position, const Vec3<T>& rotation, const Vec3<T>& scaleVec)
+		{
+			return translation(position) * yRotation<P>(rotation.Y()) * xRotation<P>(rotation.X()) * zRotation<P>(rotation.Z()) * scale(scaleVec);
+		}
+
+		static constexpr Mat4<T> lookAt(const lm::vec3& eye, const lm::vec3& center, const lm::vec3& up)
 		{
 			lm::vec3  f = (center - eye).normalized();
 			lm::vec3  u = up.normalized();
@@ -187,23 +162,80 @@ namespace lm
 
 		Mat4<T> transpose()
 		{
-			std::swap(this->matrix[0].Y(), this->matrix[1].X());
-			std::swap(this->matrix[0].Z(), this->matrix[2].X());
-			std::swap(this->matrix[0].W(), this->matrix[3].X());
-
-			std::swap(this->matrix[1].Z(), this->matrix[2].Y());
-			std::swap(this->matrix[1].W(), this->matrix[3].Y());
+			if constexpr (simd::accelerated<T>)
+			{
+				simd::transpose(this->data(), this->data());
+				return *this;
+			}
 
-			std::swap(this->matrix[2].W(), this->matrix[3].Z());
+			*this = scalarTranspose(*this);
 			return *this;
 		}
 
 		Mat4<T> inverse()
 		{
-			const float m[16] = { matrix[0][0],  matrix[0][1], matrix[0][2], matrix[0][3], 
-									matrix[1][0], matrix[1][1], matrix[1][2], matrix[1][3],
-									matrix[2][0], matrix[2][1], matrix[2][2], matrix[2][3],
-									matrix[3][0], matrix[3][1], matrix[3][2], matrix[3][3] };
+			if constexpr (simd::accelerated<T>)
+			{
+				lm::Mat4<T> inverted;
+				if (!simd::inverse(this->data(), inverted.data()))
+					return lm::Mat4<T>::identity;
+
+				return inverted;
+			}
+
+			return scalarInverse(*this);
+		}
+
+		// the plain code of the operations above, what every T runs without intrinsics (LM_FORCE_SCALAR,
+		// double, constant evaluation); MathBench --parity checks the simd kernels against it
+		static constexpr Mat4<T> scalarMultiply(const Mat4<T>& a, const Mat4<T>& b)
+		{
+			Mat4<T> newMat4;
+			for (unsigned int i = 0; i < 4; i++)
+			{
+				Vec4<T> vec4;
+				for (unsigned int j = 0; j < 4; j++)
+				{
+					vec4[j] = a.matrix[0][j] * b.matrix[i].X()
+						+ a.matrix[1][j] * b.matrix[i].Y()
+						+ a.matrix[2][j] * b.matrix[i].Z()
+						+ a.matrix[3][j] * b.matrix[i].W();
+				}
+				newMat4.matrix[i] = vec4;
+			}
+			
+			return newMat4;
+		}
+
+		static constexpr Vec4<T> scalarTransform(const Mat4<T>& m, const Vec4<T>& vec4)
+		{
+			Vec4<T> newVec4;
+			newVec4.X() = (m.matrix[0][0] * vec4.X()) + (m.matrix[1].X() * vec4.Y()) + (m.matrix[2].X() * vec4.Z()) + (m.matrix[3].X() * vec4.W());
+			newVec4.Y() = (m.matrix[0][1] * vec4.X()) + (m.matrix[1].Y() * vec4.Y()) + (m.matrix[2].Y() * vec4.Z()) + (m.matrix[3].Y() * vec4.W());
+			newVec4.Z() = (m.matrix[0].Z() * vec4.X()) + (m.matrix[1].Z() * vec4.Y()) + (m.matrix[2].Z() * vec4.Z()) + (m.matrix[3].Z() * vec4.W());
+			newVec4.W() = (m.matrix[0].W() * vec4.X()) + (m.matrix[1].W() * vec4.Y()) + (m.matrix[2].W() * vec4.Z()) + (m.matrix[3].W() * vec4.W());
+			return newVec4;
+		}
+
+		static Mat4<T> scalarTranspose(Mat4<T> m)
+		{
+			std::swap(m.matrix[0].Y(), m.matrix[1].X());
+			std::swap(m.matrix[0].Z(), m.matrix[2].X());
+			std::swap(m.matrix[0].W(), m.matrix[3].X());
+
+			std::swap(m.matrix[1].Z(), m.matrix[2].Y());
+			std::swap(m.matrix[1].W(), m.matrix[3].Y());
+
+			std::swap(m.matrix[2].W(), m.matrix[3].Z());
+			return m;
+		}
+
+		static Mat4<T> scalarInverse(const Mat4<T>& mat)
+		{
+			const float m[16] = { mat.matrix[0][0], mat.matrix[0][1], mat.matrix[0][2], mat.matrix[0][3],
+									mat.matrix[1][0], mat.matrix[1][1], mat.matrix[1][2], mat.matrix[1][3],
+									mat.matrix[2][0], mat.matrix[2][1], mat.matrix[2][2], mat.matrix[2][3],
+									mat.matrix[3][0], mat.matrix[3][1], mat.matrix[3][2], mat.matrix[3][3] };
 
 			float inv[16];
 
@@ -350,6 +382,47 @@ namespace lm
 			return inverted;
 		}
 
+		// inverse of an affine matrix (last row 0, 0, 0, 1), e.g. any TRS world matrix
+		constexpr Mat4<T> affineInverse() const
+		{
+			lm::Mat4<T> inverted;
+			if constexpr (simd::accelerated<T>)
+			{
+				if (!LM_IS_CONSTANT_EVALUATED())
+				{
+					if (!simd::affineInverse(this->data(), inverted.data()))
+						return lm::Mat4<T>::identity;
+
+					return inverted;
+				}
+			}
+
+			const Vec3<T> c0(this->matrix[0].X(), this->matrix[0].Y(), this->matrix[0].Z());
+			const Vec3<T> c1(this->matrix[1].X(), this->matrix[1].Y(), this->matrix[1].Z());
+			const Vec3<T> c2(this->matrix[2].X(), this->matrix[2].Y(), this->matrix[2].Z());
+			const Vec3<T> t(this->matrix[3].X(), this->matrix[3].Y(), this->matrix[3].Z());
+
+			// rows of the inverted 3x3 are the cofactor columns over the determinant
+			Vec3<T> r0 = c1.crossProduct(c2);
+			Vec3<T> r1 = c2.crossProduct(c0);
+			Vec3<T> r2 = c0.crossProduct(c1);
+
+			const T det = c0.dotProduct(r0);
+			if (det == 0)
+				return lm::Mat4<T>::identity;
+
+			const T invDet = T(1) / det;
+			r0 *= invDet;
+			r1 *= invDet;
+			r2 *= invDet;
+
+			inverted.matrix[0] = Vec4<T>(r0.X(), r1.X(), r2.X(), 0);
+			inverted.matrix[1] = Vec4<T>(r0.Y(), r1.Y(), r2.Y(), 0);
+			inverted.matrix[2] = Vec4<T>(r0.Z(), r1.Z(), r2.Z(), 0);
+			inverted.matrix[3] = Vec4<T>(-r0.dotProduct(t), -r1.dotProduct(t), -r2.dotProduct(t), 1);
+			return inverted;
+		}
+
 		Mat4<T> getInverse()
 		{
 			float test = this->matrix[2].X();
@@ -363,7 +436,7 @@ namespace lm
 			return *this;
 		}
 
-		static Mat4<T> translation(const Vec3<T>& translation)
+		static constexpr Mat4<T> translation(const Vec3<T>& translation)
 		{
 			Mat4<T> translate;
 			translate["x3"] = translation.X();
@@ -372,7 +445,7 @@ namespace lm
 			return translate;
 		}
 
-		static Mat4<T> scale(const Vec3<T>& scale)
+		static constexpr Mat4<T> scale(const Vec3<T>& scale)
 		{
 			Mat4<T> matrixScale;
 			matrixScale["x0"] = scale.X();
@@ -381,54 +454,76 @@ namespace lm
 			return matrixScale;
 		}
 
-		static Mat4<T> xRotation(float angle)
+		static constexpr Mat4<T> xRotation(float angle)
 		{
 			float rad = float(Vec4<T>::degreesToRadians(double(angle)));
 
 			Mat4<T> matrixScale;
-			matrixScale["y1"] = std::cosf(rad);
-			matrixScale["y2"] = -std::sinf(rad);
+			matrixScale["y1"] = cmath::cos(rad);
+			matrixScale["y2"] = -cmath::sin(rad);
 
-			matrixScale["z1"] = std::sinf(rad);
-			matrixScale["z2"] = std::cosf(rad);
+			matrixScale["z1"] = cmath::sin(rad);
+			matrixScale["z2"] = cmath::cos(rad);
 			
 			return matrixScale;
 		}
 
-		static Mat4<T> yRotation(float angle)
+		static constexpr Mat4<T> yRotation(float angle)
 		{
 			float rad = float(Vec4<T>::degreesToRadians(double(angle)));
 
 			Mat4<T> matrixRotation;
-			matrixRotation["x0"] = std::cosf(rad);
-			matrixRotation["x2"] = std::sinf(rad);
+			matrixRotation["x0"] = cmath::cos(rad);
+			matrixRotation["x2"] = cmath::sin(rad);
 
-			matrixRotation["z0"] = -std::sinf(rad);
-			matrixRotation["z2"] = std::cosf(rad);
+			matrixRotation["z0"] = -cmath::sin(rad);
+			matrixRotation["z2"] = cmath::cos(rad);
 
 			return matrixRotation;
 		}
 
-		static Mat4<T> zRotation(float angle)
+		static constexpr Mat4<T> zRotation(float angle)
 		{
 			float rad = float(Vec4<T>::degreesToRadians(double(angle)));
 
 			Mat4<T> matrixScale;
-			matrixScale["x0"] = std::cosf(rad);
-			matrixScale["x1"] = -std::sinf(rad);
+			matrixScale["x0"] = cmath::cos(rad);
+			matrixScale["x1"] = -cmath::sin(rad);
 
-			matrixScale["y0"] = std::sinf(rad);
-			matrixScale["y1"] = std::cosf(rad);
+			matrixScale["y0"] = cmath::sin(rad);
+			matrixScale["y1"] = cmath::cos(rad);
 
 			return matrixScale;
 		}
 
-		static lm::Vec3<T> getTranslationMatrix(const Mat4<T>& mat4)
+		// the same rotations through fastmath::sincosDeg, in float with the error of the chosen precision
+		template <fastmath::Precision P> static constexpr Mat4<T> xRotation(float angle)
+		{
+			float sin = 0, cos = 0;
+			fastmath::sincosDeg<P>(angle, sin, cos);
+			return Mat4<T>(Vec4<T>(1, 0, 0, 0), Vec4<T>(0, cos, sin, 0), Vec4<T>(0, -sin, cos, 0), Vec4<T>(0, 0, 0, 1));
+		}
+
+		template <fastmath::Precision P> static constexpr Mat4<T> yRotation(float angle)
+		{
+			float sin = 0, cos = 0;
+			fastmath::sincosDeg<P>(angle, sin, cos);
+			return Mat4<T>(Vec4<T>(cos, 0, -sin, 0), Vec4<T>(0, 1, 0, 0), Vec4<T>(sin, 0, cos, 0), Vec4<T>(0, 0, 0, 1));
+		}
+
+		template <fastmath::Precision P> static constexpr Mat4<T> zRotation(float angle)
+		{
+			float sin = 0, cos = 0;
+			fastmath::sincosDeg<P>(angle, sin, cos);
+			return Mat4<T>(Vec4<T>(cos, sin, 0, 0), Vec4<T>(-sin, cos, 0, 0), Vec4<T>(0, 0, 1, 0), Vec4<T>(0, 0, 0, 1));
+		}
+
+		static constexpr lm::Vec3<T> getTranslationMatrix(const Mat4<T>& mat4)
 		{
 			return lm::Vec3<T>(mat4[3].X(), mat4[3].Y(), mat4[3].Z());
 		}
 
-		static lm::Vec3<T> getScaleMatrix(const Mat4<T>& mat4)
+		static constexpr lm::Vec3<T> getScaleMatrix(const Mat4<T>& mat4)
 		{
 			lm::Vec3<T> x = lm::Vec3(mat4[0][0], mat4[0][1], mat4[0][2]);
 			lm::Vec3<T> y = lm::Vec3(mat4[1][0], mat4[1][1], mat4[1][2]);
@@ -441,9 +536,9 @@ namespace lm
 			return lm::Vec3<T>(xLength, yLength, zLength);
 		}
 
-		static Mat4<T> perspectiveProjection(float pFovy, float pAspect, float pNear, float pFar)
+		static constexpr Mat4<T> perspectiveProjection(float pFovy, float pAspect, float pNear, float pFar)
 		{
-			float scale = pNear * tanf(pFovy * float(M_PI / 360));
+			float scale = pNear * cmath::tan(pFovy * float(M_PI / 360));
 			float r = pAspect * scale;
 			float l = -r;
 			float t = scale;
@@ -484,7 +579,7 @@ namespace lm
 		}
 	};
 
-	template<class T> const Mat4<T> Mat4<T>::identity = Mat4<T>();
+	template<class T> constexpr Mat4<T> Mat4<T>::identity = Mat4<T>();
 
 	typedef Mat4<float> mat4;
 }
\ No newline at end of file
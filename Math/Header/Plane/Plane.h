@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Vec3/Vec3.h"
+#include "Vec4/Vec4.h"
+
+namespace lm
+{
+	// points p with normal.dotProduct(p) + distance == 0, the normal side is the positive one
+	template <typename T> class Plane
+	{
+		public:
+			Vec3<T> normal;
+			T distance;
+
+			constexpr Plane() : normal(0, 1, 0), distance(0)
+			{
+			}
+
+			constexpr Plane(const Vec3<T>& normal, const T distance) : normal(normal), distance(distance)
+			{
+			}
+
+			// (a, b, c, d) of ax + by + cz + d = 0, e.g. a combination of projection matrix rows
+			constexpr Plane(const Vec4<T>& coefficients) : normal(coefficients.X(), coefficients.Y(), coefficients.Z()), distance(coefficients.W())
+			{
+			}
+
+			constexpr Plane(const Plane<T>& plane) = default;
+			constexpr Plane(Plane<T>&& plane) noexcept = default;
+			constexpr Plane<T>& operator=(const Plane<T>& plane) = default;
+			constexpr Plane<T>& operator=(Plane<T>&& plane) noexcept = default;
+
+			static constexpr Plane<T> fromPoint(const Vec3<T>& normal, const Vec3<T>& point)
+			{
+				return Plane<T>(normal, -normal.dotProduct(point));
+			}
+
+			// counter clockwise triangle, the normal faces the viewer
+			static constexpr Plane<T> fromPoints(const Vec3<T>& a, const Vec3<T>& b, const Vec3<T>& c)
+			{
+				return fromPoint((b - a).crossProduct(c - a).normalized(), a);
+			}
+
+			constexpr Plane<T> normalized() const
+			{
+				const T length = this->normal.length();
+				if (length == 0)
+					return *this;
+
+				return Plane<T>(this->normal / length, this->distance / length);
+			}
+
+			constexpr void normalize()
+			{
+				*this = this->normalized();
+			}
+
+			// signed, in units of the normal length
+			constexpr const T signedDistance(const Vec3<T>& point) const
+			{
+				return this->normal.dotProduct(point) + this->distance;
+			}
+
+			constexpr Vec3<T> project(const Vec3<T>& point) const
+			{
+				return point - this->normal * (this->signedDistance(point) / this->normal.length2());
+			}
+	};
+
+	typedef Plane<float> plane;
+}
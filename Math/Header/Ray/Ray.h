@@ -0,0 +1,149 @@
+#pragma once
+
+#include <limits>
+#include "Vec3/Vec3.h"
+#include "Plane/Plane.h"
+#include "AABB/AABB.h"
+#include "Sphere/Sphere.h"
+
+namespace lm
+{
+	// origin + direction * t for t >= 0, distances are in units of the direction length
+	template <typename T> class Ray
+	{
+		public:
+			Vec3<T> origin;
+			Vec3<T> direction;
+
+			constexpr Ray() : origin(), direction(0, 0, 1)
+			{
+			}
+
+			constexpr Ray(const Vec3<T>& origin, const Vec3<T>& direction) : origin(origin), direction(direction)
+			{
+			}
+
+			constexpr Ray(const Ray<T>& ray) = default;
+			constexpr Ray(Ray<T>&& ray) noexcept = default;
+			constexpr Ray<T>& operator=(const Ray<T>& ray) = default;
+			constexpr Ray<T>& operator=(Ray<T>&& ray) noexcept = default;
+
+			static constexpr Ray<T> fromPoints(const Vec3<T>& from, const Vec3<T>& to)
+			{
+				return Ray<T>(from, (to - from).normalized());
+			}
+
+			constexpr Vec3<T> at(const T distance) const
+			{
+				return this->origin + this->direction * distance;
+			}
+
+			// slab test, distance is where the ray enters the box (0 when it starts inside)
+			constexpr bool intersects(const AABB<T>& aabb, T& distance, const T maxDistance = std::numeric_limits<T>::max()) const
+			{
+				T near = 0;
+				T far = maxDistance;
+				for (int i = 0; i < 3; i++)
+				{
+					if (this->direction[i] == 0)
+					{
+						if (this->origin[i] < aabb.min[i] || this->origin[i] > aabb.max[i])
+							return false;
+						continue;
+					}
+
+					T t0 = (aabb.min[i] - this->origin[i]) / this->direction[i];
+					T t1 = (aabb.max[i] - this->origin[i]) / this->direction[i];
+					if (t0 > t1)
+					{
+						const T swap = t0;
+						t0 = t1;
+						t1 = swap;
+					}
+
+					near = t0 > near ? t0 : near;
+					far = t1 < far ? t1 : far;
+					if (near > far)
+						return false;
+				}
+
+				distance = near;
+				return true;
+			}
+
+			constexpr bool intersects(const Sphere<T>& sphere, T& distance, const T maxDistance = std::numeric_limits<T>::max()) const
+			{
+				const Vec3<T> offset = this->origin - sphere.center;
+				const T a = this->direction.length2();
+				const T b = offset.dotProduct(this->direction);
+				const T c = offset.length2() - sphere.radius * sphere.radius;
+				const T discriminant = b * b - a * c;
+				if (a == 0 || discriminant < 0)
+					return false;
+
+				// the origin inside the sphere counts as a hit at 0
+				const T root = cmath::sqrt(discriminant);
+				T t = (-b - root) / a;
+				if (t < 0)
+					t = c <= 0 ? 0 : (-b + root) / a;
+
+				if (t < 0 || t > maxDistance)
+					return false;
+
+				distance = t;
+				return true;
+			}
+
+			constexpr bool intersects(const Plane<T>& plane, T& distance, const T maxDistance = std::numeric_limits<T>::max()) const
+			{
+				const T denominator = plane.normal.dotProduct(this->direction);
+				if (denominator == 0)
+					return false;
+
+				const T t = -plane.signedDistance(this->origin) / denominator;
+				if (t < 0 || t > maxDistance)
+					return false;
+
+				distance = t;
+				return true;
+			}
+
+			// Moller-Trumbore, both faces count, a ray in the plane of the triangle misses it
+			constexpr bool intersects(const Vec3<T>& a, const Vec3<T>& b, const Vec3<T>& c, T& distance, const T maxDistance = std::numeric_limits<T>::max()) const
+			{
+				const Vec3<T> edge1 = b - a;
+				const Vec3<T> edge2 = c - a;
+				const Vec3<T> p = this->direction.crossProduct(edge2);
+				const T determinant = edge1.dotProduct(p);
+				if (determinant == 0)
+					return false;
+
+				const T inverse = T(1) / determinant;
+				const Vec3<T> offset = this->origin - a;
+				const T u = offset.dotProduct(p) * inverse;
+				if (u < 0 || u > 1)
+					return false;
+
+				const Vec3<T> q = offset.crossProduct(edge1);
+				const T v = this->direction.dotProduct(q) * inverse;
+				if (v < 0 || u + v > 1)
+					return false;
+
+				const T t = edge2.dotProduct(q) * inverse;
+				if (t < 0 || t > maxDistance)
+					return false;
+
+				distance = t;
+				return true;
+			}
+
+			constexpr Ray<T> transform(const Mat4<T>& mat4) const
+			{
+				const Vec4<T> origin = mat4 * Vec4<T>(this->origin, 1);
+				const Vec4<T> direction = mat4 * Vec4<T>(this->direction, 0);
+				return Ray<T>(Vec3<T>(origin.X(), origin.Y(), origin.Z()), Vec3<T>(direction.X(), direction.Y(), direction.Z()));
+			}
+	};
+
+	typedef Ray<float> ray;
+}
@@ -0,0 +1,458 @@
+#pragma once
+
+// Backend selection for the float kernels used by Vec4 / Mat4.
+// LM_SIMD_AVX2 : AVX2 + FMA (two columns per 256 bit register)
+// LM_SIMD_SSE  : SSE2 baseline (always available on x64)
+// otherwise the scalar code of the math types is used as is.
+// Define LM_FORCE_SCALAR to disable every intrinsic path.
+
+#if !defined(LM_FORCE_SCALAR)
+	#if defined(__AVX2__)
+		#define LM_SIMD_AVX2
+	#endif
+
+	#if defined(LM_SIMD_AVX2) || defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define LM_SIMD_SSE
+	#endif
+#endif
+
+#if defined(LM_SIMD_SSE)
+	#include <immintrin.h>
+#endif
+
+#include <cmath>
+#include <type_traits>
+
+namespace lm
+{
+	namespace simd
+	{
+#if defined(LM_SIMD_SSE)
+		constexpr bool enabled = true;
+#else
+		constexpr bool enabled = false;
+#endif
+
+		// true when Vec4<T> / Mat4<T> dispatch to the kernels below
+		template <typename T> constexpr bool accelerated = enabled && std::is_same<T, float>::value;
+
+		// every kernel works on column major float[16] matrices and float[4] vectors,
+		// 16 bytes aligned (the alignment of lm::Vec4<float>)
+#if defined(LM_SIMD_SSE)
+
+		#define LM_SHUFFLE(x, y, z, w) ((x) | ((y) << 2) | ((z) << 4) | ((w) << 6))
+
+		inline __m128 madd(const __m128 a, const __m128 b, const __m128 c)
+		{
+#if defined(LM_SIMD_AVX2)
+			return _mm_fmadd_ps(a, b, c);
+#else
+			return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+		}
+
+		// the mask is a template argument so that it stays an immediate in unoptimized builds
+		template <int mask> inline __m128 swizzle(const __m128 v)
+		{
+			return _mm_castsi128_ps(_mm_shuffle_epi32(_mm_castps_si128(v), mask));
+		}
+
+		inline __m128 transform(const __m128 c0, const __m128 c1, const __m128 c2, const __m128 c3, const __m128 v)
+		{
+			__m128 r = _mm_mul_ps(c0, swizzle<LM_SHUFFLE(0, 0, 0, 0)>(v));
+			r = madd(c1, swizzle<LM_SHUFFLE(1, 1, 1, 1)>(v), r);
+			r = madd(c2, swizzle<LM_SHUFFLE(2, 2, 2, 2)>(v), r);
+			return madd(c3, swizzle<LM_SHUFFLE(3, 3, 3, 3)>(v), r);
+		}
+
+		inline void transform(const float* m, const float* v, float* out)
+		{
+			_mm_store_ps(out, transform(_mm_load_ps(m), _mm_load_ps(m + 4), _mm_load_ps(m + 8), _mm_load_ps(m + 12), _mm_load_ps(v)));
+		}
+
+		inline void multiply(const float* a, const float* b, float* out)
+		{
+#if defined(LM_SIMD_AVX2)
+			const __m256 c0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a));
+			const __m256 c1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 4));
+			const __m256 c2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 8));
+			const __m256 c3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 12));
+
+			const __m256 b01 = _mm256_loadu_ps(b);
+			const __m256 b23 = _mm256_loadu_ps(b + 8);
+
+			__m256 r01 = _mm256_mul_ps(c0, _mm256_shuffle_ps(b01, b01, LM_SHUFFLE(0, 0, 0, 0)));
+			r01 = _mm256_fmadd_ps(c1, _mm256_shuffle_ps(b01, b01, LM_SHUFFLE(1, 1, 1, 1)), r01);
+			r01 = _mm256_fmadd_ps(c2, _mm256_shuffle_ps(b01, b01, LM_SHUFFLE(2, 2, 2, 2)), r01);
+			r01 = _mm256_fmadd_ps(c3, _mm256_shuffle_ps(b01, b01, LM_SHUFFLE(3, 3, 3, 3)), r01);
+
+			__m256 r23 = _mm256_mul_ps(c0, _mm256_shuffle_ps(b23, b23, LM_SHUFFLE(0, 0, 0, 0)));
+			r23 = _mm256_fmadd_ps(c1, _mm256_shuffle_ps(b23, b23, LM_SHUFFLE(1, 1, 1, 1)), r23);
+			r23 = _mm256_fmadd_ps(c2, _mm256_shuffle_ps(b23, b23, LM_SHUFFLE(2, 2, 2, 2)), r23);
+			r23 = _mm256_fmadd_ps(c3, _mm256_shuffle_ps(b23, b23, LM_SHUFFLE(3, 3, 3, 3)), r23);
+
+			_mm256_storeu_ps(out, r01);
+			_mm256_storeu_ps(out + 8, r23);
+#else
+			const __m128 c0 = _mm_load_ps(a);
+			const __m128 c1 = _mm_load_ps(a + 4);
+			const __m128 c2 = _mm_load_ps(a + 8);
+			const __m128 c3 = _mm_load_ps(a + 12);
+
+			const __m128 b0 = _mm_load_ps(b);
+			const __m128 b1 = _mm_load_ps(b + 4);
+			const __m128 b2 = _mm_load_ps(b + 8);
+			const __m128 b3 = _mm_load_ps(b + 12);
+
+			_mm_store_ps(out, transform(c0, c1, c2, c3, b0));
+			_mm_store_ps(out + 4, transform(c0, c1, c2, c3, b1));
+			_mm_store_ps(out + 8, transform(c0, c1, c2, c3, b2));
+			_mm_store_ps(out + 12, transform(c0, c1, c2, c3, b3));
+#endif
+		}
+
+		inline void transpose(const float* m, float* out)
+		{
+			__m128 c0 = _mm_load_ps(m);
+			__m128 c1 = _mm_load_ps(m + 4);
+			__m128 c2 = _mm_load_ps(m + 8);
+			__m128 c3 = _mm_load_ps(m + 12);
+
+			_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+			_mm_store_ps(out, c0);
+			_mm_store_ps(out + 4, c1);
+			_mm_store_ps(out + 8, c2);
+			_mm_store_ps(out + 12, c3);
+		}
+
+		// 2x2 helpers of the block inverse, a 2x2 block is stored as (m00, m01, m10, m11)
+		inline __m128 mat2Mul(const __m128 a, const __m128 b)
+		{
+			return _mm_add_ps(_mm_mul_ps(a, swizzle<LM_SHUFFLE(0, 3, 0, 3)>(b)),
+							  _mm_mul_ps(swizzle<LM_SHUFFLE(1, 0, 3, 2)>(a), swizzle<LM_SHUFFLE(2, 1, 2, 1)>(b)));
+		}
+
+		inline __m128 mat2AdjMul(const __m128 a, const __m128 b)
+		{
+			return _mm_sub_ps(_mm_mul_ps(swizzle<LM_SHUFFLE(3, 3, 0, 0)>(a), b),
+							  _mm_mul_ps(swizzle<LM_SHUFFLE(1, 1, 2, 2)>(a), swizzle<LM_SHUFFLE(2, 3, 0, 1)>(b)));
+		}
+
+		inline __m128 mat2MulAdj(const __m128 a, const __m128 b)
+		{
+			return _mm_sub_ps(_mm_mul_ps(a, swizzle<LM_SHUFFLE(3, 0, 3, 0)>(b)),
+							  _mm_mul_ps(swizzle<LM_SHUFFLE(1, 0, 3, 2)>(a), swizzle<LM_SHUFFLE(2, 1, 2, 1)>(b)));
+		}
+
+		// block matrix inverse, returns false (out untouched) when the determinant rounds to exactly 0;
+		// a singular matrix whose determinant comes out as a tiny nonzero value, as it mostly does in
+		// float, gets a huge inverse here and in Mat4's cofactor loops alike
+		inline bool inverse(const float* m, float* out)
+		{
+			const __m128 c0 = _mm_load_ps(m);
+			const __m128 c1 = _mm_load_ps(m + 4);
+			const __m128 c2 = _mm_load_ps(m + 8);
+			const __m128 c3 = _mm_load_ps(m + 12);
+
+			const __m128 a = _mm_movelh_ps(c0, c1);
+			const __m128 b = _mm_movehl_ps(c1, c0);
+			const __m128 c = _mm_movelh_ps(c2, c3);
+			const __m128 d = _mm_movehl_ps(c3, c2);
+
+			// (|A|, |B|, |C|, |D|)
+			const __m128 detSub = _mm_sub_ps(
+				_mm_mul_ps(_mm_shuffle_ps(c0, c2, LM_SHUFFLE(0, 2, 0, 2)), _mm_shuffle_ps(c1, c3, LM_SHUFFLE(1, 3, 1, 3))),
+				_mm_mul_ps(_mm_shuffle_ps(c0, c2, LM_SHUFFLE(1, 3, 1, 3)), _mm_shuffle_ps(c1, c3, LM_SHUFFLE(0, 2, 0, 2))));
+
+			const __m128 detA = swizzle<LM_SHUFFLE(0, 0, 0, 0)>(detSub);
+			const __m128 detB = swizzle<LM_SHUFFLE(1, 1, 1, 1)>(detSub);
+			const __m128 detC = swizzle<LM_SHUFFLE(2, 2, 2, 2)>(detSub);
+			const __m128 detD = swizzle<LM_SHUFFLE(3, 3, 3, 3)>(detSub);
+
+			const __m128 dc = mat2AdjMul(d, c);
+			const __m128 ab = mat2AdjMul(a, b);
+
+			__m128 x = _mm_sub_ps(_mm_mul_ps(detD, a), mat2Mul(b, dc));
+			__m128 w = _mm_sub_ps(_mm_mul_ps(detA, d), mat2Mul(c, ab));
+			__m128 y = _mm_sub_ps(_mm_mul_ps(detB, c), mat2MulAdj(d, ab));
+			__m128 z = _mm_sub_ps(_mm_mul_ps(detC, b), mat2MulAdj(a, dc));
+
+			__m128 tr = _mm_mul_ps(ab, swizzle<LM_SHUFFLE(0, 2, 1, 3)>(dc));
+			tr = _mm_add_ps(tr, swizzle<LM_SHUFFLE(2, 3, 0, 1)>(tr));
+			tr = _mm_add_ps(tr, swizzle<LM_SHUFFLE(1, 0, 3, 2)>(tr));
+
+			const __m128 det = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), tr);
+			if (_mm_cvtss_f32(det) == 0)
+				return false;
+
+			const __m128 invDet = _mm_div_ps(_mm_setr_ps(1.f, -1.f, -1.f, 1.f), det);
+			x = _mm_mul_ps(x, invDet);
+			y = _mm_mul_ps(y, invDet);
+			z = _mm_mul_ps(z, invDet);
+			w = _mm_mul_ps(w, invDet);
+
+			_mm_store_ps(out, _mm_shuffle_ps(x, y, LM_SHUFFLE(3, 1, 3, 1)));
+			_mm_store_ps(out + 4, _mm_shuffle_ps(x, y, LM_SHUFFLE(2, 0, 2, 0)));
+			_mm_store_ps(out + 8, _mm_shuffle_ps(z, w, LM_SHUFFLE(3, 1, 3, 1)));
+			_mm_store_ps(out + 12, _mm_shuffle_ps(z, w, LM_SHUFFLE(2, 0, 2, 0)));
+			return true;
+		}
+
+		inline __m128 cross(const __m128 a, const __m128 b)
+		{
+			const __m128 r = _mm_sub_ps(_mm_mul_ps(a, swizzle<LM_SHUFFLE(1, 2, 0, 3)>(b)), _mm_mul_ps(swizzle<LM_SHUFFLE(1, 2, 0, 3)>(a), b));
+			return swizzle<LM_SHUFFLE(1, 2, 0, 3)>(r);
+		}
+
+		inline __m128 dot3(const __m128 a, const __m128 b)
+		{
+			const __m128 p = _mm_mul_ps(a, b);
+			return _mm_add_ps(_mm_add_ps(swizzle<LM_SHUFFLE(0, 0, 0, 0)>(p), swizzle<LM_SHUFFLE(1, 1, 1, 1)>(p)), swizzle<LM_SHUFFLE(2, 2, 2, 2)>(p));
+		}
+
+		// cofactor columns of the upper 3x3 divided by its determinant, i.e. inverse(m3)^T
+		inline bool normalColumns(const float* m, __m128& n0, __m128& n1, __m128& n2)
+		{
+			const __m128 c0 = _mm_load_ps(m);
+			const __m128 c1 = _mm_load_ps(m + 4);
+			const __m128 c2 = _mm_load_ps(m + 8);
+
+			n0 = cross(c1, c2);
+			n1 = cross(c2, c0);
+			n2 = cross(c0, c1);
+
+			const __m128 det = dot3(c0, n0);
+			if (_mm_cvtss_f32(det) == 0)
+				return false;
+
+			const __m128 invDet = _mm_div_ps(_mm_set1_ps(1), det);
+			n0 = _mm_mul_ps(n0, invDet);
+			n1 = _mm_mul_ps(n1, invDet);
+			n2 = _mm_mul_ps(n2, invDet);
+			return true;
+		}
+
+		// out is a column major float[9] (lm::Mat3<float>), identity when singular
+		inline bool normalMatrix(const float* m, float* out)
+		{
+			__m128 n0, n1, n2;
+			if (!normalColumns(m, n0, n1, n2))
+			{
+				n0 = _mm_setr_ps(1, 0, 0, 0);
+				n1 = _mm_setr_ps(0, 1, 0, 0);
+				n2 = _mm_setr_ps(0, 0, 1, 0);
+			}
+
+			_mm_storeu_ps(out, n0);
+			_mm_storeu_ps(out + 3, n1);
+			_mm_storel_pi(reinterpret_cast<__m64*>(out + 6), n2);
+			_mm_store_ss(out + 8, _mm_movehl_ps(n2, n2));
+			return true;
+		}
+
+		// inverse of a matrix whose last row is (0, 0, 0, 1)
+		inline bool affineInverse(const float* m, float* out)
+		{
+			__m128 r0, r1, r2;
+			if (!normalColumns(m, r0, r1, r2))
+				return false;
+
+			__m128 r3 = _mm_setzero_ps();
+			_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+			const __m128 t = _mm_load_ps(m + 12);
+			__m128 translation = _mm_mul_ps(r0, swizzle<LM_SHUFFLE(0, 0, 0, 0)>(t));
+			translation = madd(r1, swizzle<LM_SHUFFLE(1, 1, 1, 1)>(t), translation);
+			translation = madd(r2, swizzle<LM_SHUFFLE(2, 2, 2, 2)>(t), translation);
+			translation = _mm_sub_ps(_mm_setr_ps(0, 0, 0, 1), translation);
+
+			_mm_store_ps(out, r0);
+			_mm_store_ps(out + 4, r1);
+			_mm_store_ps(out + 8, r2);
+			_mm_store_ps(out + 12, translation);
+			return true;
+		}
+
+		// box around the transformed box, center * m and extents * |m|; min and max are 3 floats
+		inline void transformBounds(const float* m, const float* min, const float* max, float* outMin, float* outMax)
+		{
+			const __m128 half = _mm_set1_ps(0.5f);
+			const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+			const __m128 lo = _mm_setr_ps(min[0], min[1], min[2], 0);
+			const __m128 hi = _mm_setr_ps(max[0], max[1], max[2], 0);
+			const __m128 center = _mm_mul_ps(_mm_add_ps(lo, hi), half);
+			const __m128 extents = _mm_mul_ps(_mm_sub_ps(hi, lo), half);
+
+			const __m128 c0 = _mm_loadu_ps(m);
+			const __m128 c1 = _mm_loadu_ps(m + 4);
+			const __m128 c2 = _mm_loadu_ps(m + 8);
+
+			__m128 newCenter = madd(c0, swizzle<LM_SHUFFLE(0, 0, 0, 0)>(center), _mm_loadu_ps(m + 12));
+			newCenter = madd(c1, swizzle<LM_SHUFFLE(1, 1, 1, 1)>(center), newCenter);
+			newCenter = madd(c2, swizzle<LM_SHUFFLE(2, 2, 2, 2)>(center), newCenter);
+
+			__m128 newExtents = _mm_mul_ps(_mm_and_ps(c0, absMask), swizzle<LM_SHUFFLE(0, 0, 0, 0)>(extents));
+			newExtents = madd(_mm_and_ps(c1, absMask), swizzle<LM_SHUFFLE(1, 1, 1, 1)>(extents), newExtents);
+			newExtents = madd(_mm_and_ps(c2, absMask), swizzle<LM_SHUFFLE(2, 2, 2, 2)>(extents), newExtents);
+
+			const __m128 newMin = _mm_sub_ps(newCenter, newExtents);
+			const __m128 newMax = _mm_add_ps(newCenter, newExtents);
+			_mm_storel_pi(reinterpret_cast<__m64*>(outMin), newMin);
+			_mm_store_ss(outMin + 2, _mm_movehl_ps(newMin, newMin));
+			_mm_storel_pi(reinterpret_cast<__m64*>(outMax), newMax);
+			_mm_store_ss(outMax + 2, _mm_movehl_ps(newMax, newMax));
+		}
+
+#else
+
+		inline void transform(const float* m, const float* v, float* out)
+		{
+			float r[4];
+			for (unsigned int j = 0; j < 4; j++)
+				r[j] = m[j] * v[0] + m[4 + j] * v[1] + m[8 + j] * v[2] + m[12 + j] * v[3];
+
+			for (unsigned int j = 0; j < 4; j++)
+				out[j] = r[j];
+		}
+
+		inline void multiply(const float* a, const float* b, float* out)
+		{
+			float r[16];
+			for (unsigned int i = 0; i < 4; i++)
+				transform(a, b + 4 * i, r + 4 * i);
+
+			for (unsigned int i = 0; i < 16; i++)
+				out[i] = r[i];
+		}
+
+		inline void transpose(const float* m, float* out)
+		{
+			float r[16];
+			for (unsigned int i = 0; i < 4; i++)
+				for (unsigned int j = 0; j < 4; j++)
+					r[4 * j + i] = m[4 * i + j];
+
+			for (unsigned int i = 0; i < 16; i++)
+				out[i] = r[i];
+		}
+
+		inline bool inverse(const float* m, float* out)
+		{
+			// same 2x2 block decomposition as the intrinsic path, one lane at a time
+			const float s0 = m[0] * m[5] - m[4] * m[1];
+			const float s1 = m[0] * m[6] - m[4] * m[2];
+			const float s2 = m[0] * m[7] - m[4] * m[3];
+			const float s3 = m[1] * m[6] - m[5] * m[2];
+			const float s4 = m[1] * m[7] - m[5] * m[3];
+			const float s5 = m[2] * m[7] - m[6] * m[3];
+
+			const float c5 = m[10] * m[15] - m[14] * m[11];
+			const float c4 = m[9] * m[15] - m[13] * m[11];
+			const float c3 = m[9] * m[14] - m[13] * m[10];
+			const float c2 = m[8] * m[15] - m[12] * m[11];
+			const float c1 = m[8] * m[14] - m[12] * m[10];
+			const float c0 = m[8] * m[13] - m[12] * m[9];
+
+			const float det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+			if (det == 0)
+				return false;
+
+			const float invDet = 1.f / det;
+
+			out[0] = (m[5] * c5 - m[6] * c4 + m[7] * c3) * invDet;
+			out[1] = (-m[1] * c5 + m[2] * c4 - m[3] * c3) * invDet;
+			out[2] = (m[13] * s5 - m[14] * s4 + m[15] * s3) * invDet;
+			out[3] = (-m[9] * s5 + m[10] * s4 - m[11] * s3) * invDet;
+
+			out[4] = (-m[4] * c5 + m[6] * c2 - m[7] * c1) * invDet;
+			out[5] = (m[0] * c5 - m[2] * c2 + m[3] * c1) * invDet;
+			out[6] = (-m[12] * s5 + m[14] * s2 - m[15] * s1) * invDet;
+			out[7] = (m[8] * s5 - m[10] * s2 + m[11] * s1) * invDet;
+
+			out[8] = (m[4] * c4 - m[5] * c2 + m[7] * c0) * invDet;
+			out[9] = (-m[0] * c4 + m[1] * c2 - m[3] * c0) * invDet;
+			out[10] = (m[12] * s4 - m[13] * s2 + m[15] * s0) * invDet;
+			out[11] = (-m[8] * s4 + m[9] * s2 - m[11] * s0) * invDet;
+
+			out[12] = (-m[4] * c3 + m[5] * c1 - m[6] * c0) * invDet;
+			out[13] = (m[0] * c3 - m[1] * c1 + m[2] * c0) * invDet;
+			out[14] = (-m[12] * s3 + m[13] * s1 - m[14] * s0) * invDet;
+			out[15] = (m[8] * s3 - m[9] * s1 + m[10] * s0) * invDet;
+			return true;
+		}
+
+		inline bool normalMatrix(const float* m, float* out)
+		{
+			const float n[9] =
+			{
+				m[5] * m[10] - m[6] * m[9], m[6] * m[8] - m[4] * m[10], m[4] * m[9] - m[5] * m[8],
+				m[9] * m[2] - m[10] * m[1], m[10] * m[0] - m[8] * m[2], m[8] * m[1] - m[9] * m[0],
+				m[1] * m[6] - m[2] * m[5], m[2] * m[4] - m[0] * m[6], m[0] * m[5] - m[1] * m[4]
+			};
+
+			const float det = m[0] * n[0] + m[1] * n[1] + m[2] * n[2];
+			if (det == 0)
+			{
+				for (unsigned int i = 0; i < 9; i++)
+					out[i] = (i % 4 == 0) ? 1.f : 0.f;
+				return true;
+			}
+
+			const float invDet = 1.f / det;
+			for (unsigned int i = 0; i < 9; i++)
+				out[i] = n[i] * invDet;
+			return true;
+		}
+
+		inline bool affineInverse(const float* m, float* out)
+		{
+			float n[9];
+			const float det = m[0] * (m[5] * m[10] - m[6] * m[9]) + m[1] * (m[6] * m[8] - m[4] * m[10]) + m[2] * (m[4] * m[9] - m[5] * m[8]);
+			if (det == 0)
+				return false;
+
+			normalMatrix(m, n);
+
+			float r[16];
+			for (unsigned int i = 0; i < 3; i++)
+			{
+				for (unsigned int j = 0; j < 3; j++)
+					r[4 * i + j] = n[3 * j + i];
+				r[4 * i + 3] = 0;
+			}
+
+			for (unsigned int j = 0; j < 3; j++)
+				r[12 + j] = -(r[j] * m[12] + r[4 + j] * m[13] + r[8 + j] * m[14]);
+			r[15] = 1;
+
+			for (unsigned int i = 0; i < 16; i++)
+				out[i] = r[i];
+			return true;
+		}
+
+		inline void transformBounds(const float* m, const float* min, const float* max, float* outMin, float* outMax)
+		{
+			float center[3] = { m[12], m[13], m[14] };
+			float extents[3] = { 0, 0, 0 };
+			for (unsigned int i = 0; i < 3; i++)
+			{
+				const float c = (min[i] + max[i]) * 0.5f;
+				const float e = (max[i] - min[i]) * 0.5f;
+				for (unsigned int j = 0; j < 3; j++)
+				{
+					center[j] += m[4 * i + j] * c;
+					extents[j] += std::abs(m[4 * i + j]) * e;
+				}
+			}
+
+			for (unsigned int j = 0; j < 3; j++)
+			{
+				outMin[j] = center[j] - extents[j];
+				outMax[j] = center[j] + extents[j];
+			}
+		}
+
+#endif
+	}
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Vec3/Vec3.h"
+#include "Mat4/Mat4.h"
+#include "AABB/AABB.h"
+
+namespace lm
+{
+	template <typename T> class Sphere
+	{
+		public:
+			Vec3<T> center;
+			T radius;
+
+			constexpr Sphere() : center(), radius(0)
+			{
+			}
+
+			constexpr Sphere(const Vec3<T>& center, const T radius) : center(center), radius(radius)
+			{
+			}
+
+			constexpr Sphere(const Sphere<T>& sphere) = default;
+			constexpr Sphere(Sphere<T>&& sphere) noexcept = default;
+			constexpr Sphere<T>& operator=(const Sphere<T>& sphere) = default;
+			constexpr Sphere<T>& operator=(Sphere<T>&& sphere) noexcept = default;
+
+			// sphere through the corners of the box
+			static constexpr Sphere<T> fromAABB(const AABB<T>& aabb)
+			{
+				return Sphere<T>(aabb.center(), aabb.extents().length());
+			}
+
+			constexpr AABB<T> toAABB() const
+			{
+				return AABB<T>::fromCenterExtents(this->center, Vec3<T>(this->radius));
+			}
+
+			constexpr bool contains(const Vec3<T>& point) const
+			{
+				return (point - this->center).length2() <= this->radius * this->radius;
+			}
+
+			constexpr bool intersects(const Sphere<T>& sphere) const
+			{
+				const T radius = this->radius + sphere.radius;
+				return (sphere.center - this->center).length2() <= radius * radius;
+			}
+
+			constexpr bool intersects(const AABB<T>& aabb) const
+			{
+				T distance2 = 0;
+				for (int i = 0; i < 3; i++)
+				{
+					const T value = this->center[i];
+					if (value < aabb.min[i])
+						distance2 += (aabb.min[i] - value) * (aabb.min[i] - value);
+					else if (value > aabb.max[i])
+						distance2 += (value - aabb.max[i]) * (value - aabb.max[i]);
+				}
+
+				return distance2 <= this->radius * this->radius;
+			}
+
+			// the radius grows with the largest axis scale so the result still bounds the shape
+			constexpr Sphere<T> transform(const Mat4<T>& mat4) const
+			{
+				const Vec4<T> center = mat4 * Vec4<T>(this->center, 1);
+
+				T scale2 = 0;
+				for (int i = 0; i < 3; i++)
+				{
+					const Vec4<T> column = mat4[i];
+					const T length2 = column.X() * column.X() + column.Y() * column.Y() + column.Z() * column.Z();
+					scale2 = length2 > scale2 ? length2 : scale2;
+				}
+
+				return Sphere<T>(Vec3<T>(center.X(), center.Y(), center.Z()), this->radius * cmath::sqrt(scale2));
+			}
+	};
+
+	typedef Sphere<float> sphere;
+}
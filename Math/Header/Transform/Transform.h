@@ -0,0 +1,129 @@
+#pragma once
+
+#include "Vec3/Vec3.h"
+#include "Mat4/Mat4.h"
+#include "Quat/Quat.h"
+
+namespace lm
+{
+	// translation, rotation and scale kept apart, the matrix is translation * rotation * scale
+	template <typename T> class Transform
+	{
+		public:
+			Vec3<T> position;
+			Quat<T> rotation;
+			Vec3<T> scale;
+
+			static const Transform<T> identity;
+
+			constexpr Transform() : position(0, 0, 0), rotation(1, 0, 0, 0), scale(1, 1, 1)
+			{
+			}
+
+			constexpr Transform(const Vec3<T>& position, const Quat<T>& rotation, const Vec3<T>& scale) : position(position), rotation(rotation), scale(scale)
+			{
+			}
+
+			constexpr Transform(const Transform<T>& transform) = default;
+			constexpr Transform(Transform<T>&& transform) noexcept = default;
+			constexpr Transform<T>& operator=(const Transform<T>& transform) = default;
+			constexpr Transform<T>& operator=(Transform<T>&& transform) noexcept = default;
+
+			// same arguments as Mat4::createTransformMatrix, euler angles in degrees
+			static constexpr Transform<T> fromEuler(const Vec3<T>& position, const Vec3<T>& rotation, const Vec3<T>& scale)
+			{
+				return Transform<T>(position, Quat<T>::fromEuler(rotation), scale);
+			}
+
+			// inverse of toMat4 for matrices without shear, a mirrored matrix gets a negative x scale
+			static Transform<T> fromMat4(const Mat4<T>& mat4)
+			{
+				Vec3<T> axis[3] = { Vec3<T>(mat4[0].X(), mat4[0].Y(), mat4[0].Z()),
+									Vec3<T>(mat4[1].X(), mat4[1].Y(), mat4[1].Z()),
+									Vec3<T>(mat4[2].X(), mat4[2].Y(), mat4[2].Z()) };
+
+				Vec3<T> scale(axis[0].length(), axis[1].length(), axis[2].length());
+				if (axis[0].dotProduct(axis[1].crossProduct(axis[2])) < 0)
+					scale.X() = -scale.X();
+
+				Mat4<T> rotation;
+				for (unsigned int i = 0; i < 3; i++)
+				{
+					if (scale[i] != 0)
+						axis[i] /= scale[i];
+					rotation[i] = Vec4<T>(axis[i], 0);
+				}
+
+				return Transform<T>(Mat4<T>::getTranslationMatrix(mat4), Quat<T>::toQuat(rotation).normalized(), scale);
+			}
+
+			// closed form of translation(position) * rotation.toMat4() * scale(scale)
+			constexpr Mat4<T> toMat4() const
+			{
+				const T qw = this->rotation.W(), qx = this->rotation.X(), qy = this->rotation.Y(), qz = this->rotation.Z();
+				const T norm2 = (qw * qw) + (qx * qx) + (qy * qy) + (qz * qz);
+				const T s = norm2 == 0 ? T(0) : T(2) / norm2;
+
+				const T xx = qx * qx * s, yy = qy * qy * s, zz = qz * qz * s;
+				const T xy = qx * qy * s, xz = qx * qz * s, yz = qy * qz * s;
+				const T wx = qw * qx * s, wy = qw * qy * s, wz = qw * qz * s;
+
+				return Mat4<T>(Vec4<T>((1 - yy - zz) * this->scale.X(), (xy + wz) * this->scale.X(), (xz - wy) * this->scale.X(), 0),
+								Vec4<T>((xy - wz) * this->scale.Y(), (1 - xx - zz) * this->scale.Y(), (yz + wx) * this->scale.Y(), 0),
+								Vec4<T>((xz + wy) * this->scale.Z(), (yz - wx) * this->scale.Z(), (1 - xx - yy) * this->scale.Z(), 0),
+								Vec4<T>(this->position, 1));
+			}
+
+			// the same matrix as 3 rows of 4 (row major), the last row (0, 0, 0, 1) is left out
+			constexpr void toMat3x4(T* out) const
+			{
+				const Mat4<T> mat4 = this->toMat4();
+				for (unsigned int row = 0; row < 3; row++)
+					for (unsigned int column = 0; column < 4; column++)
+						out[4 * row + column] = mat4[column][row];
+			}
+
+			constexpr Vec3<T> transformPoint(const Vec3<T>& point) const
+			{
+				return this->position + this->rotation.rotate(point.scaled(this->scale));
+			}
+
+			constexpr Vec3<T> transformVector(const Vec3<T>& vector) const
+			{
+				return this->rotation.rotate(vector.scaled(this->scale));
+			}
+
+			// parent * child, exact as long as the parent scale is uniform or the child is not rotated
+			constexpr Transform<T> operator*(const Transform<T>& child) const
+			{
+				return Transform<T>(this->transformPoint(child.position), this->rotation * child.rotation, this->scale.scaled(child.scale));
+			}
+
+			constexpr void operator*=(const Transform<T>& child)
+			{
+				*this = *this * child;
+			}
+
+			// same limits as the composition, the rotation must be a unit quaternion
+			constexpr Transform<T> inverse() const
+			{
+				const Vec3<T> inverseScale(this->scale.X() == 0 ? T(0) : 1 / this->scale.X(),
+											this->scale.Y() == 0 ? T(0) : 1 / this->scale.Y(),
+											this->scale.Z() == 0 ? T(0) : 1 / this->scale.Z());
+				const Quat<T> inverseRotation = this->rotation.conjugate();
+
+				return Transform<T>(inverseRotation.rotate(-this->position).scaled(inverseScale), inverseRotation, inverseScale);
+			}
+
+			static Transform<T> lerp(const Transform<T>& a, const Transform<T>& b, float t)
+			{
+				return Transform<T>(a.position + (b.position - a.position) * t,
+									Quat<T>::slerp(a.rotation, b.rotation, t),
+									a.scale + (b.scale - a.scale) * t);
+			}
+	};
+
+	template<class T> constexpr Transform<T> Transform<T>::identity = Transform<T>();
+
+	typedef Transform<float> transform;
+}
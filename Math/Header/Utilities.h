@@ -0,0 +1,100 @@
+#pragma once
+#define _USE_MATH_DEFINES
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+#ifndef M_PI
+	#define M_PI 3.14159265358979323846
+#endif
+
+// true while the enclosing constexpr function is evaluated by the compiler,
+// lets a function keep its intrinsic / libm path for runtime calls
+#if defined(__cpp_lib_is_constant_evaluated)
+	#define LM_IS_CONSTANT_EVALUATED() std::is_constant_evaluated()
+#elif defined(__GNUC__) || defined(__clang__) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+	#define LM_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#else
+	#define LM_IS_CONSTANT_EVALUATED() false
+#endif
+
+namespace lm
+{
+	// <cmath> functions usable in constant expressions, the std version is called at runtime
+	namespace cmath
+	{
+		template <typename T> constexpr T abs(const T x)
+		{
+			return x < 0 ? -x : x;
+		}
+
+		template <typename T> constexpr T sqrt(const T x)
+		{
+			if (!LM_IS_CONSTANT_EVALUATED())
+				return std::sqrt(x);
+
+			if (x < 0)
+				return std::numeric_limits<T>::quiet_NaN();
+
+			if (x == 0 || x == std::numeric_limits<T>::infinity())
+				return x;
+
+			// newton iterations in double until the estimate stops moving
+			double estimate = x < 1 ? 1.0 : double(x);
+			for (unsigned int i = 0; i < 128; i++)
+			{
+				const double next = 0.5 * (estimate + double(x) / estimate);
+				if (next == estimate)
+					break;
+
+				estimate = next;
+			}
+
+			return T(estimate);
+		}
+
+		template <typename T> constexpr T sin(const T x)
+		{
+			if (!LM_IS_CONSTANT_EVALUATED())
+				return std::sin(x);
+
+			// reduce to [-pi, pi] then taylor series, the x^27 term is below double precision
+			const double turns = double(x) / (2 * M_PI);
+			const double rounded = double((long long)(turns + (turns < 0 ? -0.5 : 0.5)));
+			const double r = double(x) - rounded * (2 * M_PI);
+
+			double term = r;
+			double sum = r;
+			for (unsigned int i = 1; i < 14; i++)
+			{
+				term *= -(r * r) / double((2 * i) * (2 * i + 1));
+				sum += term;
+			}
+
+			return T(sum);
+		}
+
+		template <typename T> constexpr T cos(const T x)
+		{
+			if (!LM_IS_CONSTANT_EVALUATED())
+				return std::cos(x);
+
+			return T(sin(double(x) + M_PI / 2));
+		}
+
+		template <typename T> constexpr T tan(const T x)
+		{
+			if (!LM_IS_CONSTANT_EVALUATED())
+				return std::tan(x);
+
+			return T(sin(double(x)) / cos(double(x)));
+		}
+	}
+
+	// the comparison of the static_assert suites in Source/, the library stops building when one fails;
+	// each check states the tolerance it holds to
+	constexpr bool nearlyEqual(const float a, const float b, const float epsilon)
+	{
+		return cmath::abs(a - b) <= epsilon;
+	}
+}
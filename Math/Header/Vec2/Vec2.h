@@ -17,12 +17,12 @@
 
 namespace lm
 {
-	const double static radiansToDegrees(const double rad)
+	static constexpr double radiansToDegrees(const double rad)
 	{
 		return rad * (HALF_CIRCLE / M_PI);
 	}
 
-	const double static degreesToRadians(const double deg)
+	static constexpr double degreesToRadians(const double deg)
 	{
 		return deg * (M_PI / HALF_CIRCLE);
 	}
@@ -41,96 +41,57 @@ namespace lm
 		static const Vec2<T> left;
 		static const Vec2<T> right;
 
-		Vec2()
+		constexpr Vec2() : x(0), y(0)
 		{
-			this->x = 0;
-			this->y = 0;
 		}
 
-		Vec2(const T init)
+		constexpr Vec2(const T init) : x(init), y(init)
 		{
-			this->x = init;
-			this->y = init;
 		}
 
-		Vec2(const T x, const T y)
+		constexpr Vec2(const T x, const T y) : x(x), y(y)
 		{
-			this->x = x;
-			this->y = y;
 		}
 
-		Vec2(const Vec2<T>& vec2)
+		constexpr Vec2(const Vec4<T>& vec4) : x(vec4.X()), y(vec4.Y())
 		{
-			this->x = vec2.x;
-			this->y = vec2.y;
 		}
 
-		Vec2(const Vec4<T>& vec4)
+		constexpr Vec2(const Vec3<T>& vec3) : x(vec3.X()), y(vec3.Y())
 		{
-			this->x = vec4.X();
-			this->y = vec4.Y();
 		}
 
-		Vec2(const Vec3<T>& vec3)
-		{
-			this->x = vec3.X();
-			this->y = vec3.Y();
-		}
-
-		Vec2(Vec2<T>&& vec2) noexcept
-		{
-			this->x = std::move(vec2.x);
-			this->y = std::move(vec2.y);
-		}
-
-		Vec2<T>& operator=(const Vec2<T>& vec2)
-		{
-			if (this == &vec2)
-				return *this;
-
-			this->x = vec2.x;
-			this->y = vec2.y;
-
-			return *this;
-		}
-		
-		Vec2<T>& operator=(Vec2<T>&& vec2) noexcept
-		{
-			if (this == &vec2)
-				return *this;
-
-			this->x = std::move(vec2.x);
-			this->y = std::move(vec2.y);
-
-			return *this;
-		}
+		constexpr Vec2(const Vec2<T>& vec2) = default;
+		constexpr Vec2(Vec2<T>&& vec2) noexcept = default;
+		constexpr Vec2<T>& operator=(const Vec2<T>& vec2) = default;
+		constexpr Vec2<T>& operator=(Vec2<T>&& vec2) noexcept = default;
 
-		T& X()
+		constexpr T& X()
 		{
 			return this->x;
 		}
 
-		T& Y()
+		constexpr T& Y()
 		{
 			return this->y;
 		}
 
-		T X() const
+		constexpr T X() const
 		{
 			return this->x;
 		}
 
-		T Y() const
+		constexpr T Y() const
 		{
 			return this->y;
 		}
 
-		const T length() const
+		constexpr const T length() const
 		{
-			return sqrt((this->x * this->x) + (this->y * this->y));
+			return cmath::sqrt((this->x * this->x) + (this->y * this->y));
 		}
 
-		const T length2() const
+		constexpr const T length2() const
 		{
 			return (this->x * this->x) + (this->y * this->y);
 		}
@@ -142,12 +103,12 @@ namespace lm
 			return true;
 		}
 
-		const T dotProduct(const Vec2<T>& vec2) const
+		constexpr const T dotProduct(const Vec2<T>& vec2) const
 		{
 			return (this->x * vec2.x) + (this->y * vec2.y);
 		}
 
-		const T crossProduct(const Vec2<T>& vec2) const
+		constexpr const T crossProduct(const Vec2<T>& vec2) const
 		{
 			return (this->x * vec2.y) - (this->y * vec2.x);
 		}
@@ -170,7 +131,7 @@ namespace lm
 			return radiansToDegrees(this->radAngle(vec2));	
 		}
 
-		Vec2<T> project(const Vec2<T>& vec2) const
+		constexpr Vec2<T> project(const Vec2<T>& vec2) const
 		{
 			const T product = this->dotProduct(vec2);
 			const T length = vec2.length2();
@@ -195,49 +156,49 @@ namespace lm
 			return Vec2<T>(this->x - vecProduct.x, this->y - vecProduct.y);
 		}
 
-		Vec2<T> perpendicular(const Vec2<T>& vec2) const
+		constexpr Vec2<T> perpendicular(const Vec2<T>& vec2) const
 		{
 			const Vec2<T> proj = this->project(vec2);
 			return Vec2<T>(this->x - proj.x, this->y - proj.y);
 		}
 
-		Vec2<T> add(const Vec2<T>& vec2) const
+		constexpr Vec2<T> add(const Vec2<T>& vec2) const
 		{
 			return Vec2<T>(this->x + vec2.x, this->y + vec2.y);
 		}
 
-		Vec2<T>& add(const Vec2<T>& vec2)
+		constexpr Vec2<T>& add(const Vec2<T>& vec2)
 		{
 			this->x += vec2.x;
 			this->y += vec2.y;
 			return *this;
 		}
 
-		Vec2<T> scale(const T scale) const
+		constexpr Vec2<T> scale(const T scale) const
 		{
 			return Vec2<T>(this->x * scale, this->y * scale);
 		}
 
-		Vec2<T>& scale(const T scale)
+		constexpr Vec2<T>& scale(const T scale)
 		{
 			this->x *= scale;
 			this->y *= scale;
 			return *this;
 		}
 
-		Vec2<T> normalized() const
+		constexpr Vec2<T> normalized() const
 		{
 			return Vec2<T>(this->x / this->length(), this->y / this->length());
 		}
 
-		void normalize()
+		constexpr void normalize()
 		{
 			T length = this->length();
 			this->x /= length;
 			this->y /= length;
 		}
 
-		T& operator[](const int idx)
+		constexpr T& operator[](const int idx)
 		{
 			switch (idx)
 			{
@@ -251,7 +212,7 @@ namespace lm
 			}
 		}
 
-		T& operator[](const char* idx)
+		constexpr T& operator[](const char* idx)
 		{
 			switch (idx[0])
 			{
@@ -262,7 +223,7 @@ namespace lm
 			}
 		}
 
-		const T operator[](const char* idx) const
+		constexpr const T operator[](const char* idx) const
 		{
 			switch (idx[0])
 			{
@@ -308,59 +269,59 @@ namespace lm
 			return !(*this <= vec2);
 		}
 
-		Vec2<T> operator+(const Vec2<T>& vec2) const
+		constexpr Vec2<T> operator+(const Vec2<T>& vec2) const
 		{
 			return Vec2(this->x + vec2.x, this->y + vec2.y);
 		}
 
-		void operator+=(const Vec2<T>& vec2)
+		constexpr void operator+=(const Vec2<T>& vec2)
 		{
 			this->x += vec2.x;
 			this->y += vec2.y;
 		}
 
-		Vec2<T> operator-(const Vec2<T>& vec2) const
+		constexpr Vec2<T> operator-(const Vec2<T>& vec2) const
 		{
 			return Vec2(this->x - vec2.x, this->y - vec2.y);
 		}
 
-		void operator-=(const Vec2<T>& vec2)
+		constexpr void operator-=(const Vec2<T>& vec2)
 		{
 			this->x -= vec2.x;
 			this->y -= vec2.y;
 		}
 
-		Vec2<T> operator-() const
+		constexpr Vec2<T> operator-() const
 		{
 			return Vec2(-this->x, -this->y);
 		}
 
-		Vec2<T> operator*(const T value) const
+		constexpr Vec2<T> operator*(const T value) const
 		{
 			return this->scale(value);
 		}
 
-		void operator*=(const T value)
+		constexpr void operator*=(const T value)
 		{
 			*this = this->scale(value);
 		}
 
-		Vec2<T> operator*(const Vec2<T>& vec2) const
+		constexpr Vec2<T> operator*(const Vec2<T>& vec2) const
 		{
 			return this->crossProduct(vec2);
 		}
 
-		void operator*=(const Vec2<T>& vec2)
+		constexpr void operator*=(const Vec2<T>& vec2)
 		{
 			*this = this->crossProduct(vec2);
 		}
 
-		Vec2<T> operator/(const T value) const
+		constexpr Vec2<T> operator/(const T value) const
 		{
 			return Vec2(this->x / value, this->y / value);
 		}
 
-		void operator/=(const T value)
+		constexpr void operator/=(const T value)
 		{
 			this->x /= value;
 			this->y /= value;
@@ -424,27 +385,27 @@ namespace lm
 		str += "x:" + std::to_string(vec2.X()) + ", y : " + std::to_string(vec2.Y());
 	}
 
-	template<class T> Vec2<T> operator*(const double value, const Vec2<T>& vec2)
+	template<class T> constexpr Vec2<T> operator*(const double value, const Vec2<T>& vec2)
 	{
 		return vec2 * T(value);
 	}
 
-	template<class T> Vec2<T> operator/(const double value, const Vec2<T>& vec2)
+	template<class T> constexpr Vec2<T> operator/(const double value, const Vec2<T>& vec2)
 	{
 		return Vec2<T>(T(value / vec2.X()), T(value / vec2.Y()));
 	}
 
-	template<class T> const T operator,(const Vec2<T>& vec1, const Vec2<T>& vec2)
+	template<class T> constexpr const T operator,(const Vec2<T>& vec1, const Vec2<T>& vec2)
 	{
 		return vec1.dotProduct(vec2);
 	}
 
-	template<class T> const Vec2<T> Vec2<T>::zero = Vec2();
-	template<class T> const Vec2<T> Vec2<T>::up(0, 1);
-	template<class T> const Vec2<T> Vec2<T>::down(0, -1);
-	template<class T> const Vec2<T> Vec2<T>::left(-1, 0);
-	template<class T> const Vec2<T> Vec2<T>::right(1, 0);
-	template<class T> const T Vec2<T>::unitVal = 1;
+	template<class T> constexpr Vec2<T> Vec2<T>::zero = Vec2();
+	template<class T> constexpr Vec2<T> Vec2<T>::up(0, 1);
+	template<class T> constexpr Vec2<T> Vec2<T>::down(0, -1);
+	template<class T> constexpr Vec2<T> Vec2<T>::left(-1, 0);
+	template<class T> constexpr Vec2<T> Vec2<T>::right(1, 0);
+	template<class T> constexpr T Vec2<T>::unitVal = 1;
 
 	typedef Vec2<float> vec2;
 }
\ No newline at end of file
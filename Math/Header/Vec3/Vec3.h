@@ -5,6 +5,7 @@
 
 #include <limits>
 #include <algorithm>
+#include "Utilities.h"
 
 #ifndef HALF_CIRCLE
 	#define HALF_CIRCLE 180.0f
@@ -15,12 +16,12 @@ namespace lm
 	template <typename T> class Vec3
 	{
 		public:
-			const double static radiansToDegrees(const double rad)
+			static constexpr double radiansToDegrees(const double rad)
 			{
 				return rad * (HALF_CIRCLE / M_PI);
 			}
 
-			const double static degreesToRadians(const double deg)
+			static constexpr double degreesToRadians(const double deg)
 			{
 				return deg * (M_PI / HALF_CIRCLE);
 			}
@@ -40,101 +41,69 @@ namespace lm
 			static const Vec3<T> forward;
 			static const Vec3<T> backward;
 
-			Vec3()
+			constexpr Vec3() : x(0), y(0), z(0)
 			{
-				this->x = 0;
-				this->y = 0;
-				this->z = 0;
 			}
 
-			Vec3(const T init)
+			constexpr Vec3(const T init) : x(init), y(init), z(init)
 			{
-				this->x = init;
-				this->y = init;
-				this->z = init;
 			}
 
-			Vec3(const T x, const T y, const T z)
+			constexpr Vec3(const T x, const T y, const T z) : x(x), y(y), z(z)
 			{
-				this->x = x;
-				this->y = y;
-				this->z = z;
 			}
 
-			Vec3(const Vec3<T>& vec3)
+			constexpr Vec3(const Vec3<T>& vec3) = default;
+			constexpr Vec3(Vec3<T>&& vec3) noexcept = default;
+			constexpr Vec3& operator=(const Vec3<T>& vec3) = default;
+			constexpr Vec3& operator=(Vec3<T>&& vec3) noexcept = default;
+			
+			constexpr T& X()
 			{
-				this->x = vec3.x;
-				this->y = vec3.y;
-				this->z = vec3.z;
+				return this->x;
 			}
 
-			Vec3(Vec3<T>&& vec3) noexcept
+			constexpr T& Y()
 			{
-				this->x = std::move(vec3.x);
-				this->y = std::move(vec3.y);
-				this->z = std::move(vec3.z);
+				return this->y;
 			}
 
-			Vec3& operator=(const Vec3<T>& vec3)
+			constexpr T& Z()
 			{
-				if (this == &vec3)
-					return *this;
-
-				this->x = vec3.x;
-				this->y = vec3.y;
-				this->z = vec3.z;
-
-				return *this;
+				return this->z;
 			}
 
-			Vec3& operator=(Vec3<T>&& vec3) noexcept
-			{
-				if (this == &vec3)
-					return *this;
-
-				this->x = std::move(vec3.x);
-				this->y = std::move(vec3.y);
-				this->z = std::move(vec3.z);
-
-				return *this;
-			}
-			
-			T& X()
+			constexpr const T X() const
 			{
 				return this->x;
 			}
 
-			T& Y()
+			constexpr const T Y() const
 			{
 				return this->y;
 			}
 
-			T& Z()
+			constexpr const T Z() const
 			{
 				return this->z;
 			}
 
-			const T X() const
-			{
-				return this->x;
-			}
-
-			const T Y() const
+			constexpr T* data()
 			{
-				return this->y;
+				return &this->x;
 			}
 
-			const T Z() const
+			constexpr const T* data() const
 			{
-				return this->z;
+				return &this->x;
 			}
 
-			const T length() const
+			constexpr const T length() const
 			{
-				return sqrt((this->x * this->x) + (this->y * this->y) + (this->z * this->z));
+				return cmath::sqrt((this->x * this->x) + (this->y * this->y) + (this->z * this->z));
 			}
 
-			const T length2() const
+			constexpr const T length2() const
 			{
 				return (this->x * this->x) + (this->y * this->y) + (this->z * this->z);
 			}
@@ -146,12 +115,12 @@ namespace lm
 				return true;
 			}
 
-			const T dotProduct(const Vec3<T>& vec3) const
+			constexpr const T dotProduct(const Vec3<T>& vec3) const
 			{
 				return (this->x * vec3.x) + (this->y * vec3.y) + (this->z * vec3.z);
 			}
 
-			const Vec3<T> crossProduct(const Vec3<T>& vec3) const
+			constexpr const Vec3<T> crossProduct(const Vec3<T>& vec3) const
 			{
 				return Vec3<T>( (this->y * vec3.z) - (this->z * vec3.y), 
 								(this->z * vec3.x) - (this->x * vec3.z),
@@ -177,7 +146,7 @@ namespace lm
 				return radiansToDegrees(this->radAngle(vec3));
 			}
 
-			Vec3<T> project(const Vec3<T>& vec3) const
+			constexpr Vec3<T> project(const Vec3<T>& vec3) const
 			{
 				const T product = this->dotProduct(vec3);
 				const T length = vec3.length2();
@@ -202,13 +171,13 @@ namespace lm
 				return Vec3<T>(this->x - vecProduct.x, this->y - vecProduct.y, this->z - vecProduct.z);
 			}
 
-			Vec3<T> perpendicular(const Vec3<T>& vec3) const
+			constexpr Vec3<T> perpendicular(const Vec3<T>& vec3) const
 			{
 				const Vec3<T> proj = this->project(vec3);
 				return Vec3<T>(this->x - proj.x, this->y - proj.y, this->z - proj.z);
 			}
 
-			static Vec3<T> lerp(const Vec3<T>& a, const Vec3<T>& b, float t) {
+			static constexpr Vec3<T> lerp(const Vec3<T>& a, const Vec3<T>& b, float t) {
 				return a * t + b * (1.f - t);
 			}
 
@@ -224,12 +193,12 @@ namespace lm
 				return ((a * std::cos(theta)) + (relativeVec * std::sin(theta)));
 			}
 
-			Vec3<T> add(const Vec3<T>& vec3) const
+			constexpr Vec3<T> add(const Vec3<T>& vec3) const
 			{
 				return Vec3<T>(this->x + vec3.x, this->y + vec3.y, this->z + vec3.z);
 			}
 
-			Vec3<T>& add(const Vec3<T>& vec3)
+			constexpr Vec3<T>& add(const Vec3<T>& vec3)
 			{
 				this->x += vec3.x;
 				this->y += vec3.y;
@@ -237,12 +206,12 @@ namespace lm
 				return *this;
 			}
 
-			Vec3<T> scale(const T scale) const
+			constexpr Vec3<T> scale(const T scale) const
 			{
 				return Vec3<T>(this->x * scale, this->y * scale, this->z * scale);
 			}
 
-			Vec3<T>& scale(const T scale)
+			constexpr Vec3<T>& scale(const T scale)
 			{
 				this->x *= scale;
 				this->y *= scale;
@@ -250,7 +219,7 @@ namespace lm
 				return *this;
 			}
 
-			Vec3<T>& scale(const Vec3<T>& vec3)
+			constexpr Vec3<T>& scale(const Vec3<T>& vec3)
 			{
 				this->x *= vec3.X();
 				this->y *= vec3.Y();
@@ -258,17 +227,17 @@ namespace lm
 				return *this;
 			}
 
-			Vec3<T> scaled(const Vec3<T>& vec3) const
+			constexpr Vec3<T> scaled(const Vec3<T>& vec3) const
 			{
 				return lm::Vec3<T>(this->x * vec3.X(), this->y * vec3.Y(), this->z * vec3.Z());
 			}
 
-			float distance(const Vec3<T>& vec3) const
+			constexpr float distance(const Vec3<T>& vec3) const
 			{
-				return std::sqrt( ((this->x - vec3.x) * (this->x - vec3.x)) + ((this->y - vec3.y) * (this->y - vec3.y)) + ((this->z - vec3.z) * (this->z - vec3.z)));
+				return cmath::sqrt( ((this->x - vec3.x) * (this->x - vec3.x)) + ((this->y - vec3.y) * (this->y - vec3.y)) + ((this->z - vec3.z) * (this->z - vec3.z)));
 			}
 
-			Vec3<T> normalized() const
+			constexpr Vec3<T> normalized() const
 			{
 				T length = this->length();
 				if (length == 0)
@@ -276,7 +245,7 @@ namespace lm
 				return Vec3<T>(this->x / length, this->y / length, this->z / length);
 			}
 
-			void normalize()
+			constexpr void normalize()
 			{
 				T length = this->length();
 				if (length == 0)
@@ -292,7 +261,7 @@ namespace lm
 				this->z /= length;
 			}
 
-			T& operator[](const int idx)
+			constexpr T& operator[](const int idx)
 			{
 				switch (idx)
 				{
@@ -308,7 +277,7 @@ namespace lm
 				}
 			}
 
-			const T operator[](const int idx) const
+			constexpr const T operator[](const int idx) const
 			{
 				switch (idx)
 				{
@@ -324,7 +293,7 @@ namespace lm
 				}
 			}
 
-			T& operator[](const char* idx)
+			constexpr T& operator[](const char* idx)
 			{
 				switch (idx[0])
 				{
@@ -336,7 +305,7 @@ namespace lm
 				}
 			}
 
-			const T operator[](const char* idx) const
+			constexpr const T operator[](const char* idx) const
 			{
 				switch (idx[0])
 				{
@@ -383,61 +352,61 @@ namespace lm
 				return !(*this <= vec3);
 			}
 
-			Vec3<T> operator+(const Vec3<T>& vec3) const
+			constexpr Vec3<T> operator+(const Vec3<T>& vec3) const
 			{
 				return Vec3(this->x + vec3.x, this->y + vec3.y, this->z + vec3.z);
 			}
 
-			void operator+=(const Vec3<T>& vec3)
+			constexpr void operator+=(const Vec3<T>& vec3)
 			{
 				this->x += vec3.x;
 				this->y += vec3.y;
 				this->z += vec3.z;
 			}
 
-			Vec3<T> operator-(const Vec3<T>& vec3) const
+			constexpr Vec3<T> operator-(const Vec3<T>& vec3) const
 			{
 				return Vec3(this->x - vec3.x, this->y - vec3.y, this->z - vec3.z);
 			}
 
-			void operator-=(const Vec3<T>& vec3)
+			constexpr void operator-=(const Vec3<T>& vec3)
 			{
 				this->x -= vec3.x;
 				this->y -= vec3.y;
 				this->z -= vec3.z;
 			}
 
-			Vec3<T> operator-() const
+			constexpr Vec3<T> operator-() const
 			{
 				return Vec3(-this->x, -this->y, -this->z);
 			}
 
-			Vec3<T> operator*(const T value) const
+			constexpr Vec3<T> operator*(const T value) const
 			{
 				return this->scale(value);
 			}
 
-			void operator*=(const T value)
+			constexpr void operator*=(const T value)
 			{
 				*this = this->scale(value);
 			}
 
-			Vec3<T> operator*(const Vec3<T>& vec3) const
+			constexpr Vec3<T> operator*(const Vec3<T>& vec3) const
 			{
 				return this->crossProduct(vec3);
 			}
 
-			void operator*=(const Vec3<T>& vec3)
+			constexpr void operator*=(const Vec3<T>& vec3)
 			{
 				*this = this->crossProduct(vec3);
 			}
 
-			Vec3<T> operator/(const T value) const
+			constexpr Vec3<T> operator/(const T value) const
 			{
 				return Vec3(this->x / value, this->y / value, this->z / value);
 			}
 
-			void operator/=(const T value)
+			constexpr void operator/=(const T value)
 			{
 				this->x /= value;
 				this->y /= value;
@@ -460,35 +429,35 @@ namespace lm
 				this->z *= (length - 1) / length;
 			}
 
-			static lm::Vec3<T> lerp(lm::Vec3<T>& a, lm::Vec3<T>& b, float t)
+			static constexpr lm::Vec3<T> lerp(lm::Vec3<T>& a, lm::Vec3<T>& b, float t)
 			{
 				return a + (b - a) * t;
 			}
 	};
 
-	template<class T> Vec3<T> operator*(const double value, const Vec3<T>& vec3)
+	template<class T> constexpr Vec3<T> operator*(const double value, const Vec3<T>& vec3)
 	{
 		return vec3 * T(value);
 	}
 
-	template<class T> Vec3<T> operator/(const double value, const Vec3<T>& vec3)
+	template<class T> constexpr Vec3<T> operator/(const double value, const Vec3<T>& vec3)
 	{
 		return Vec3<T>(T(value / vec3.X()), T(value / vec3.Y()), T(value / vec3.Z()));
 	}
 
-	template<class T> const T operator,(const Vec3<T>& vec1, const Vec3<T>& vec2)
+	template<class T> constexpr const T operator,(const Vec3<T>& vec1, const Vec3<T>& vec2)
 	{
 		return vec1.dotProduct(vec2);
 	}
 
-	template<class T> const Vec3<T> Vec3<T>::zero = Vec3();
-	template<class T> const Vec3<T> Vec3<T>::up(0, 1, 0);
-	template<class T> const Vec3<T> Vec3<T>::down(0, -1, 0);
-	template<class T> const Vec3<T> Vec3<T>::left(-1, 0, 0);
-	template<class T> const Vec3<T> Vec3<T>::right(1, 0, 0);
-	template<class T> const Vec3<T> Vec3<T>::forward(0, 0, -1);
-	template<class T> const Vec3<T> Vec3<T>::backward(0, 0, 1);
-	template<class T> const T Vec3<T>::unitVal = 1;
+	template<class T> constexpr Vec3<T> Vec3<T>::zero = Vec3();
+	template<class T> constexpr Vec3<T> Vec3<T>::up(0, 1, 0);
+	template<class T> constexpr Vec3<T> Vec3<T>::down(0, -1, 0);
+	template<class T> constexpr Vec3<T> Vec3<T>::left(-1, 0, 0);
+	template<class T> constexpr Vec3<T> Vec3<T>::right(1, 0, 0);
+	template<class T> constexpr Vec3<T> Vec3<T>::forward(0, 0, -1);
+	template<class T> constexpr Vec3<T> Vec3<T>::backward(0, 0, 1);
+	template<class T> constexpr T Vec3<T>::unitVal = 1;
 
 	typedef Vec3<float> vec3;
 }
\ No newline at end of file
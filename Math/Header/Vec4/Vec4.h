@@ -2,6 +2,7 @@
 #include <limits>
 #include <algorithm>
 #include "Vec3/Vec3.h"
+#include "Simd/Simd.h"
 
 #ifndef HALF_CIRCLE
 	#define HALF_CIRCLE 180.0f
@@ -9,7 +10,7 @@
 
 namespace lm
 {
-	template <typename T> class Vec4
+	template <typename T> class alignas(4 * sizeof(T)) Vec4
 	{
 	private:
 		T x;
@@ -18,12 +19,12 @@ namespace lm
 		T w;
 
 	public:
-		const double static radiansToDegrees(const double rad)
+		static constexpr double radiansToDegrees(const double rad)
 		{
 			return rad * (HALF_CIRCLE / M_PI);
 		}
 
-		const double static degreesToRadians(const double deg)
+		static constexpr double degreesToRadians(const double deg)
 		{
 			return deg * (M_PI / HALF_CIRCLE);
 		}
@@ -37,126 +38,83 @@ namespace lm
 		static const Vec4<T> forward;
 		static const Vec4<T> backward;
 
-		Vec4()
+		constexpr Vec4() : x(0), y(0), z(0), w(0)
 		{
-			this->x = 0;
-			this->y = 0;
-			this->z = 0;
-			this->w = 0;
 		}
 
-		Vec4(const T init)
+		constexpr Vec4(const T init) : x(init), y(init), z(init), w(0)
 		{
-			this->x = init;
-			this->y = init;
-			this->z = init;
-			this->w = 0;
 		}
 
-		Vec4(const T x, const T y, const T z, const T w = 0)
+		constexpr Vec4(const T x, const T y, const T z, const T w = 0) : x(x), y(y), z(z), w(w)
 		{
-			this->x = x;
-			this->y = y;
-			this->z = z;
-			this->w = w;
 		}
 
-		Vec4(const Vec3<T>& vec3, float w = 0)
+		constexpr Vec4(const Vec3<T>& vec3, float w = 0) : x(vec3.X()), y(vec3.Y()), z(vec3.Z()), w(w)
 		{
-			this->x = vec3.X();
-			this->y = vec3.Y();
-			this->z = vec3.Z();
-			this->w = w;
 		}
 
-		Vec4(const Vec4<T>& vec4)
+		constexpr Vec4(const Vec4<T>& vec4) = default;
+		constexpr Vec4(Vec4<T>&& vec4) noexcept = default;
+		constexpr Vec4& operator=(const Vec4<T>& vec4) = default;
+		constexpr Vec4& operator=(Vec4<T>&& vec4) noexcept = default;
+
+		constexpr T& X()
 		{
-			this->x = vec4.x;
-			this->y = vec4.y;
-			this->z = vec4.z;
-			this->w = vec4.w;
+			return this->x;
 		}
 
-		Vec4(Vec4<T>&& vec4) noexcept
+		constexpr T& Y()
 		{
-			this->x = std::move(vec4.x);
-			this->y = std::move(vec4.y);
-			this->z = std::move(vec4.z);
-			this->w = std::move(vec4.w);
+			return this->y;
 		}
 
-		Vec4& operator=(const Vec4<T>& vec4)
+		constexpr T& Z()
 		{
-			if (this == &vec4)
-				return *this;
-
-			this->x = vec4.x;
-			this->y = vec4.y;
-			this->z = vec4.z;
-			this->w = vec4.w;
-
-			return *this;
+			return this->z;
 		}
 
-		Vec4& operator=(Vec4<T>&& vec4) noexcept
+		constexpr T& W()
 		{
-			if (this == &vec4)
-				return *this;
-
-			this->x = std::move(vec4.x);
-			this->y = std::move(vec4.y);
-			this->z = std::move(vec4.z);
-			this->w = std::move(vec4.w);
-
-			return *this;
+			return this->w;
 		}
 
-		T& X()
+		constexpr const T X() const
 		{
 			return this->x;
 		}
 
-		T& Y()
+		constexpr const T Y() const
 		{
 			return this->y;
 		}
 
-		T& Z()
+		constexpr const T Z() const
 		{
 			return this->z;
 		}
 
-		T& W()
+		constexpr const T W() const
 		{
 			return this->w;
 		}
 
-		const T X() const
-		{
-			return this->x;
-		}
-
-		const T Y() const
+		constexpr T* data()
 		{
-			return this->y;
+			return &this->x;
 		}
 
-		const T Z() const
+		constexpr const T* data() const
 		{
-			return this->z;
-		}
-
-		const T W() const
-		{
-			return this->w;
+			return &this->x;
 		}
 
-		const T length() const
+		constexpr const T length() const
 		{
-			return sqrt((this->x * this->x) + (this->y * this->y) + (this->z * this->z));
+			return cmath::sqrt((this->x * this->x) + (this->y * this->y) + (this->z * this->z));
 		}
 
-		const T length2() const
+		constexpr const T length2() const
 		{
 			return (this->x * this->x) + (this->y * this->y) + (this->z * this->z);
 		}
@@ -168,12 +126,12 @@ namespace lm
 			return true;
 		}
 
-		const T dotProduct(const Vec4<T>& vec4) const
+		constexpr const T dotProduct(const Vec4<T>& vec4) const
 		{
 			return (this->x * vec4.x) + (this->y * vec4.y) + (this->z * vec4.z);
 		}
 
-		Vec4<T> crossProduct(const Vec4<T>& vec4) const
+		constexpr Vec4<T> crossProduct(const Vec4<T>& vec4) const
 		{
 			return Vec4<T>((this->y * vec4.z) - (this->z * vec4.y),
 							(this->z * vec4.x) - (this->x * vec4.z),
@@ -198,7 +156,7 @@ namespace lm
 			return radiansToDegrees(this->radAngle(vec4));
 		}
 
-		Vec4<T> project(const Vec4<T>& vec4) const
+		constexpr Vec4<T> project(const Vec4<T>& vec4) const
 		{
 			const T product = this->dotProduct(vec4);
 			const T length = vec4.length2();
@@ -223,18 +181,18 @@ namespace lm
 			return Vec4<T>(this->x - vecProduct.x, this->y - vecProduct.y, this->z - vecProduct.z, 1);
 		}
 
-		Vec4<T> perpendicular(const Vec4<T>& vec4) const
+		constexpr Vec4<T> perpendicular(const Vec4<T>& vec4) const
 		{
 			const Vec4<T> proj = this->project(vec4);
 			return Vec4<T>(this->x - proj.x, this->y - proj.y, this->z - proj.z, 1);
 		}
 
-		Vec4<T> add(const Vec4<T>& vec4) const
+		constexpr Vec4<T> add(const Vec4<T>& vec4) const
 		{
 			return Vec4<T>(this->x + vec4.x, this->y + vec4.y, this->z + vec4.z, 1);
 		}
 
-		Vec4<T>& add(const Vec4<T>& vec4)
+		constexpr Vec4<T>& add(const Vec4<T>& vec4)
 		{
 			this->x += vec4.x;
 			this->y += vec4.y;
@@ -242,12 +200,12 @@ namespace lm
 			return *this;
 		}
 
-		Vec4<T> scale(const T scale) const
+		constexpr Vec4<T> scale(const T scale) const
 		{
 			return Vec4<T>(this->x * scale, this->y * scale, this->z * scale, this->w * scale);
 		}
 
-		Vec4<T>& scale(const T scale)
+		constexpr Vec4<T>& scale(const T scale)
 		{
 			this->x *= scale;
 			this->y *= scale;
@@ -255,13 +213,13 @@ namespace lm
 			return *this;
 		}
 
-		Vec4<T> normalized() const
+		constexpr Vec4<T> normalized() const
 		{
 			T length = this->length();
 			return Vec4<T>(this->x / length, this->y / length, this->z / length, 0);
 		}
 
-		void normalize()
+		constexpr void normalize()
 		{
 			T length = this->length();
 			this->x /= length;
@@ -269,7 +227,7 @@ namespace lm
 			this->z /= length;
 		}
 
-		T& operator[](const int idx)
+		constexpr T& operator[](const int idx)
 		{
 			switch (idx)
 			{
@@ -287,7 +245,7 @@ namespace lm
 			}
 		}
 
-		const T operator[](const int idx) const
+		constexpr const T operator[](const int idx) const
 		{
 			switch (idx)
 			{
@@ -305,7 +263,7 @@ namespace lm
 			}
 		}
 
-		T& operator[](const char* idx)
+		constexpr T& operator[](const char* idx)
 		{
 			switch (idx[0])
 			{
@@ -318,7 +276,7 @@ namespace lm
 			}
 		}
 
-		const T operator[](const char* idx) const
+		constexpr const T operator[](const char* idx) const
 		{
 			switch (idx[0])
 			{
@@ -366,61 +324,61 @@ namespace lm
 			return !(*this <= vec4);
 		}
 
-		Vec4<T> operator+(const Vec4<T>& vec4) const
+		constexpr Vec4<T> operator+(const Vec4<T>& vec4) const
 		{
 			return Vec4(this->x + vec4.x, this->y + vec4.y, this->z + vec4.z, this->w + vec4.w);
 		}
 
-		void operator+=(const Vec4<T>& vec4)
+		constexpr void operator+=(const Vec4<T>& vec4)
 		{
 			this->x += vec4.x;
 			this->y += vec4.y;
 			this->z += vec4.z;
 		}
 
-		Vec4<T> operator-(const Vec4<T>& vec4) const
+		constexpr Vec4<T> operator-(const Vec4<T>& vec4) const
 		{
 			return Vec4(this->x - vec4.x, this->y - vec4.y, this->z - vec4.z, this->w - vec4.w);
 		}
 
-		void operator-=(const Vec4<T>& vec4)
+		constexpr void operator-=(const Vec4<T>& vec4)
 		{
 			this->x -= vec4.x;
 			this->y -= vec4.y;
 			this->z -= vec4.z;
 		}
 
-		Vec4<T> operator-() const
+		constexpr Vec4<T> operator-() const
 		{
 			return Vec4(-this->x, -this->y, -this->z);
 		}
 
-		Vec4<T> operator*(const T value) const
+		constexpr Vec4<T> operator*(const T value) const
 		{
 			return this->scale(value);
 		}
 
-		void operator*=(const T value)
+		constexpr void operator*=(const T value)
 		{
 			*this = this->scale(value);
 		}
 
-		Vec4<T> operator*(const Vec4<T>& vec4) const
+		constexpr Vec4<T> operator*(const Vec4<T>& vec4) const
 		{
 			return this->crossProduct(vec4);
 		}
 
-		void operator*=(const Vec4<T>& vec4)
+		constexpr void operator*=(const Vec4<T>& vec4)
 		{
 			*this = this->crossProduct(vec4);
 		}
 
-		Vec4<T> operator/(const T value) const
+		constexpr Vec4<T> operator/(const T value) const
 		{
 			return Vec4(this->x / value, this->y / value, this->z / value);
 		}
 
-		void operator/=(const T value)
+		constexpr void operator/=(const T value)
 		{
 			this->x /= value;
 			this->y /= value;
@@ -443,7 +401,7 @@ namespace lm
 			this->z *= (length - 1) / length;
 		}
 
-		void homogenize()
+		constexpr void homogenize()
 		{
 			if (this->w == 0)
 				return;
@@ -467,29 +425,29 @@ namespace lm
 		}
 	};
 
-	template<class T> Vec4<T> operator*(const double value, const Vec4<T>& vec4)
+	template<class T> constexpr Vec4<T> operator*(const double value, const Vec4<T>& vec4)
 	{
 		return vec4 * T(value);
 	}
 
-	template<class T> Vec4<T> operator/(const double value, const Vec4<T>& vec4)
+	template<class T> constexpr Vec4<T> operator/(const double value, const Vec4<T>& vec4)
 	{
 		return Vec4<T>(T(value / vec4.X()), T(value / vec4.Y()), T(value / vec4.Z()));
 	}
 
-	template<class T> const T operator,(const Vec4<T>& vec1, const Vec4<T>& vec2)
+	template<class T> constexpr const T operator,(const Vec4<T>& vec1, const Vec4<T>& vec2)
 	{
 		return vec1.dotProduct(vec2);
 	}
 
-	template<class T> const Vec4<T> Vec4<T>::zero = Vec4();
-	template<class T> const Vec4<T> Vec4<T>::up(0, 1, 0, 0);
-	template<class T> const Vec4<T> Vec4<T>::down(0, -1, 0, 0);
-	template<class T> const Vec4<T> Vec4<T>::left(-1, 0, 0, 0);
-	template<class T> const Vec4<T> Vec4<T>::right(1, 0, 0, 0);
-	template<class T> const Vec4<T> Vec4<T>::forward(0, 0, -1, 0);
-	template<class T> const Vec4<T> Vec4<T>::backward(0, 0, 1, 0);
-	template<class T> const T Vec4<T>::unitVal = 1;
+	template<class T> constexpr Vec4<T> Vec4<T>::zero = Vec4();
+	template<class T> constexpr Vec4<T> Vec4<T>::up(0, 1, 0, 0);
+	template<class T> constexpr Vec4<T> Vec4<T>::down(0, -1, 0, 0);
+	template<class T> constexpr Vec4<T> Vec4<T>::left(-1, 0, 0, 0);
+	template<class T> constexpr Vec4<T> Vec4<T>::right(1, 0, 0, 0);
+	template<class T> constexpr Vec4<T> Vec4<T>::forward(0, 0, -1, 0);
+	template<class T> constexpr Vec4<T> Vec4<T>::backward(0, 0, 1, 0);
+	template<class T> constexpr T Vec4<T>::unitVal = 1;
 
 	typedef Vec4<float> vec4;
 }
\ No newline at end of file
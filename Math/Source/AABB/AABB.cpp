@@ -0,0 +1,21 @@
+#include "AABB/AABB.h"
+
+namespace
+{
+	constexpr lm::aabb box(lm::vec3(-1, -2, -3), lm::vec3(1, 2, 3));
+	static_assert(lm::aabb().isEmpty() && !box.isEmpty() && lm::aabb().surfaceArea() == 0);
+	static_assert(box.center().X() == 0 && box.extents().Z() == 3 && box.volume() == 48 && box.surfaceArea() == 88);
+	static_assert(box.contains(lm::vec3(1, 0, -3)) && !box.contains(lm::vec3(0, 2.5f, 0)));
+	static_assert(box.intersects(lm::aabb(lm::vec3(1, 2, 3), lm::vec3(4, 4, 4))) && !box.intersects(lm::aabb(lm::vec3(1.5f, 0, 0), lm::vec3(2, 1, 1))));
+
+	constexpr lm::aabb merged = lm::aabb::merge(box, lm::aabb(lm::vec3(0, 0, 0), lm::vec3(5, 1, 1)));
+	static_assert(merged.min.X() == -1 && merged.max.X() == 5 && merged.max.Y() == 2);
+	static_assert(lm::aabb::merge(lm::aabb(), box).min.Y() == -2);
+
+	// a quarter turn around y swaps the x and z extents, the translation moves the center
+	constexpr lm::aabb moved = box.transform(lm::mat4::translation(lm::vec3(10, 0, 0)) * lm::mat4::yRotation(90));
+	static_assert(lm::nearlyEqual(moved.min.X(), 7, 1e-5f) && lm::nearlyEqual(moved.max.X(), 13, 1e-5f) && lm::nearlyEqual(moved.min.Y(), -2, 1e-5f) && lm::nearlyEqual(moved.max.Z(), 1, 1e-5f));
+
+	constexpr lm::aabb doubled = box.transform(lm::mat4::scale(lm::vec3(2, 2, 2)));
+	static_assert(lm::nearlyEqual(doubled.max.X(), 2, 1e-5f) && lm::nearlyEqual(doubled.min.Z(), -6, 1e-5f));
+}
@@ -0,0 +1,5 @@
+#include "BVH/BVH.h"
+
+// the tree needs the heap and cannot be checked at compile time, instantiating it still stops
+// the library from building when the template breaks
+template class lm::BVH<float>;
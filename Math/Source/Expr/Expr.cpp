@@ -0,0 +1,33 @@
+#include "Expr/Expr.h"
+
+namespace
+{
+	constexpr bool nearlyEqual(const lm::mat4& a, const lm::mat4& b, const float epsilon)
+	{
+		for (int i = 0; i < 4; i++)
+			for (int j = 0; j < 4; j++)
+				if (!lm::nearlyEqual(a[i][j], b[i][j], epsilon))
+					return false;
+
+		return true;
+	}
+
+	constexpr lm::vec3 position(1, -2, 3);
+	constexpr lm::vec3 size(2, 0.5f, 1.5f);
+	constexpr lm::quat rotation = lm::quat(0.9f, 0.3f, -0.2f, 0.1f).normalized();
+	constexpr lm::mat4 parent = lm::mat4::createTransformMatrix(lm::vec3(4, 5, 6), lm::vec3(10, 20, 30), lm::vec3(2));
+
+	// structured factors give the eager product
+	constexpr lm::mat4 trs = lm::expr::translate(position) * lm::expr::rotate(rotation) * lm::expr::scale(size);
+	static_assert(nearlyEqual(trs, lm::mat4::translation(position) * rotation.toMat4() * lm::mat4::scale(size), 1e-5f));
+
+	// mixed with plain matrices on both sides
+	constexpr lm::mat4 chain = lm::expr::lazy(parent) * trs * parent;
+	static_assert(nearlyEqual(chain, parent * trs * parent, 1e-5f));
+	static_assert(nearlyEqual(parent * lm::expr::scale(size), parent * lm::mat4::scale(size), 1e-5f));
+
+	// a vector goes through the chain without building the matrix
+	constexpr lm::vec4 point = (lm::expr::lazy(parent) * lm::expr::translate(position) * lm::expr::scale(size)) * lm::vec4(1, 2, 3, 1);
+	constexpr lm::vec4 eagerPoint = parent * lm::mat4::translation(position) * lm::mat4::scale(size) * lm::vec4(1, 2, 3, 1);
+	static_assert(lm::cmath::abs(point.X() - eagerPoint.X()) < 1e-4f && lm::cmath::abs(point.W() - 1) < 1e-6f);
+}
@@ -0,0 +1,44 @@
+#include "FastMath/FastMath.h"
+#include "Mat4/Mat4.h"
+
+namespace
+{
+	using lm::fastmath::Precision;
+
+	template <Precision P> constexpr bool sincosWithin(const float x, const float epsilon)
+	{
+		float s = 0, c = 0;
+		lm::fastmath::sincos<P>(x, s, c);
+		return lm::nearlyEqual(s, lm::cmath::sin(x), epsilon) && lm::nearlyEqual(c, lm::cmath::cos(x), epsilon);
+	}
+
+	// one point per quadrant plus a large argument
+	static_assert(sincosWithin<Precision::LOW>(0.7f, 4e-4f) && sincosWithin<Precision::LOW>(-2.2f, 4e-4f));
+	static_assert(sincosWithin<Precision::MEDIUM>(2.4f, 4.5e-6f) && sincosWithin<Precision::MEDIUM>(-0.78f, 4.5e-6f));
+	static_assert(sincosWithin<Precision::HIGH>(4.f, 1.1e-7f) && sincosWithin<Precision::HIGH>(-5.5f, 1.1e-7f) && sincosWithin<Precision::HIGH>(1000.f, 1.1e-7f));
+
+	// the degree reduction is exact on the axes
+	constexpr float sinHalfTurn = []()
+	{
+		float s = 1, c = 0;
+		lm::fastmath::sincosDeg<Precision::LOW>(-180.f, s, c);
+		return s + c;
+	}();
+	static_assert(sinHalfTurn == -1);
+
+	static_assert(lm::nearlyEqual(lm::fastmath::acos<Precision::LOW>(0.3f), 1.2661037f, 4e-3f) && lm::nearlyEqual(lm::fastmath::acos<Precision::MEDIUM>(-0.9f), 2.6905658f, 8.5e-5f));
+	static_assert(lm::nearlyEqual(lm::fastmath::acos<Precision::HIGH>(0.5f), float(M_PI / 3), 5e-7f) && lm::fastmath::acos(1.f) == 0);
+	static_assert(lm::nearlyEqual(lm::fastmath::acosDeg(-0.5f), 120, 1e-4f));
+
+	static_assert(lm::nearlyEqual(lm::fastmath::atan2<Precision::LOW>(1.f, -2.f), 2.6779451f, 2e-3f) && lm::nearlyEqual(lm::fastmath::atan2<Precision::MEDIUM>(-3.f, 0.5f), -1.4056476f, 1.5e-5f));
+	static_assert(lm::nearlyEqual(lm::fastmath::atan2(-1.f, -1.f), float(-3 * M_PI / 4), 3.5e-7f) && lm::fastmath::atan2(0.f, 0.f) == 0);
+	static_assert(lm::nearlyEqual(lm::fastmath::atan2Deg(1.f, 0.f), 90, 1e-5f));
+
+	static_assert(lm::nearlyEqual(lm::fastmath::rsqrt(4.f), 0.5f, 1e-7f) && lm::nearlyEqual(lm::fastmath::rsqrt<Precision::MEDIUM>(0.01f), 10, 1e-5f));
+
+	// the opt-in rotation builders stay close to the double precision ones
+	constexpr lm::mat4 rotation = lm::mat4::createTransformMatrix(lm::vec3(1, 2, 3), lm::vec3(30, -45, 60), lm::vec3(1));
+	constexpr lm::mat4 fastRotation = lm::mat4::createTransformMatrix<Precision::MEDIUM>(lm::vec3(1, 2, 3), lm::vec3(30, -45, 60), lm::vec3(1));
+	static_assert(lm::nearlyEqual(rotation[0].X(), fastRotation[0].X(), 1e-5f) && lm::nearlyEqual(rotation[1].Z(), fastRotation[1].Z(), 1e-5f) && lm::nearlyEqual(rotation[2].Y(), fastRotation[2].Y(), 1e-5f));
+	static_assert(lm::mat4::zRotation<Precision::LOW>(90)[0].Y() == 1 && lm::mat4::zRotation<Precision::LOW>(90)[0].X() == 0);
+}
@@ -0,0 +1,21 @@
+#include "Frustum/Frustum.h"
+
+namespace
+{
+	// camera at the origin looking down -z, 90 degrees vertical, square, depth 1 to 100
+	constexpr lm::mat4 view = lm::mat4::lookAt(lm::vec3(0, 0, 0), lm::vec3(0, 0, -1), lm::vec3(0, 1, 0));
+	constexpr lm::frustum frustum = lm::frustum::fromMatrix(lm::mat4::perspectiveProjection(90, 1, 1, 100) * view);
+
+	static_assert(lm::nearlyEqual(frustum[lm::FrustumPlane::ZNEAR].normal.Z(), -1, 1e-4f) && lm::nearlyEqual(frustum[lm::FrustumPlane::ZNEAR].distance, -1, 1e-4f));
+	static_assert(lm::nearlyEqual(frustum[lm::FrustumPlane::ZFAR].normal.Z(), 1, 1e-4f) && lm::nearlyEqual(frustum[lm::FrustumPlane::ZFAR].distance * 0.01f, 1, 1e-4f));
+
+	static_assert(frustum.contains(lm::vec3(0, 0, -10)) && !frustum.contains(lm::vec3(0, 0, 10)) && !frustum.contains(lm::vec3(0, 0, -0.5f)));
+	static_assert(frustum.contains(lm::vec3(9, 0, -10)) && !frustum.contains(lm::vec3(11, 0, -10)) && !frustum.contains(lm::vec3(0, 0, -101)));
+
+	static_assert(frustum.intersects(lm::sphere(lm::vec3(12, 0, -10), 2)) && !frustum.intersects(lm::sphere(lm::vec3(15, 0, -10), 2)));
+	static_assert(frustum.intersects(lm::aabb(lm::vec3(10.5f, -1, -11), lm::vec3(12, 1, -9))) && !frustum.intersects(lm::aabb(lm::vec3(14, -1, -11), lm::vec3(16, 1, -9))));
+	static_assert(!frustum.intersects(lm::aabb(lm::vec3(-1, -1, 1), lm::vec3(1, 1, 2))));
+
+	constexpr lm::frustum depth01 = lm::frustum::fromMatrix(lm::mat4::perspectiveProjection(90, 1, 1, 100) * view, true);
+	static_assert(depth01.contains(lm::vec3(0, 0, -10)));
+}
@@ -0,0 +1,41 @@
+#include "Gpu/Gpu.h"
+
+namespace
+{
+	using lm::gpu::Layout;
+	using lm::gpu::Traits;
+
+	// std140 and std430 only differ for arrays (and structs) of types smaller than a vec4
+	static_assert(Traits<float, Layout::STD140>::arrayStride == 16 && Traits<float, Layout::STD430>::arrayStride == 4);
+	static_assert(Traits<lm::vec2, Layout::STD140>::arrayStride == 16 && Traits<lm::vec2, Layout::STD430>::arrayStride == 8);
+	static_assert(Traits<lm::vec3, Layout::STD140>::arrayStride == 16 && Traits<lm::vec3, Layout::STD430>::arrayStride == 16);
+	static_assert(Traits<lm::mat3, Layout::STD140>::size == 48 && Traits<lm::mat4, Layout::STD430>::arrayStride == 64);
+
+	static_assert(sizeof(lm::gpu::mat3x4) == 48 && sizeof(lm::gpu::std140<lm::mat3>) == 48 && sizeof(lm::gpu::std140<bool>) == 4);
+	static_assert(sizeof(lm::gpu::std140Array<float, 4>) == 64 && sizeof(lm::gpu::std430Array<float, 4>) == 16);
+	static_assert(sizeof(lm::gpu::std430Array<lm::vec3, 2>) == 32);
+
+	// { mat4; mat3; mat4; bool; vec3; mat4[] } as declared in vertex.vert
+	struct Block
+	{
+		lm::gpu::std140<lm::mat4> model;
+		lm::gpu::std140<lm::mat3> inverseModel;
+		lm::gpu::std140<lm::mat4> mvp;
+		lm::gpu::std140<bool> hasAnimation;
+		lm::gpu::std140<lm::vec3> view;
+		lm::gpu::std140Array<lm::mat4, 2> bones;
+	};
+
+	static_assert(offsetof(Block, inverseModel) == 64 && offsetof(Block, mvp) == 112 && offsetof(Block, hasAnimation) == 176);
+	static_assert(offsetof(Block, view) == 192 && offsetof(Block, bones) == 208 && sizeof(Block) == 336);
+
+	// the packer lands on the same offsets, and a scalar after a vec3 fills its last 4 bytes
+	constexpr size_t packed = lm::gpu::Std140Packer().write(lm::mat4()).write(lm::mat3()).write(lm::mat4()).write(true).write(lm::vec3()).offset();
+	static_assert(packed == 204);
+	static_assert(lm::gpu::Std140Packer().write(lm::vec3()).write(1.f).offset() == 16);
+	static_assert(lm::gpu::Std140Packer().write(1.f).write(static_cast<const lm::mat4*>(nullptr), 2).offset() == 144);
+	static_assert(lm::gpu::Std430Packer().write(1.f).write(static_cast<const float*>(nullptr), 3).offset() == 16);
+
+	constexpr lm::gpu::mat3x4 normal(lm::mat3(lm::vec3(1, 2, 3), lm::vec3(4, 5, 6), lm::vec3(7, 8, 9)));
+	static_assert(normal.columns[1].Y() == 5 && normal.columns[1].W() == 0 && normal.toMat3()[2].Z() == 9);
+}
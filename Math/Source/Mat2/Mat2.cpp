@@ -1 +1,15 @@
-#include "Mat2/Mat2.h"
\ No newline at end of file
+#include "Mat2/Mat2.h"
+
+namespace
+{
+	constexpr lm::mat2 m(2, 1, 4, 3);
+	constexpr lm::mat2 transposed = m.transpose();
+	constexpr lm::mat2 product = m * m.inverse();
+	constexpr lm::mat2 scaled = m * 2.f;
+
+	static_assert(m.determinant() == 2);
+	static_assert(transposed[1] == 4 && transposed[2] == 1);
+	static_assert(product[0] == 1 && product[1] == 0 && product[2] == 0 && product[3] == 1);
+	static_assert(lm::mat2::identity[0] == 1 && lm::mat2::identity[1] == 0);
+	static_assert(scaled["y2"] == 6);
+}
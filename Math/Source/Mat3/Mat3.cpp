@@ -1 +1,17 @@
-#include "Mat3/Mat3.h"
\ No newline at end of file
+#include "Mat3/Mat3.h"
+
+namespace
+{
+	constexpr lm::mat3 m(lm::vec3(2, 0, 0), lm::vec3(1, 4, 0), lm::vec3(0, 0, 8));
+
+	static_assert(m.determinant() == 64);
+	static_assert((m * m.inverse())[0].X() == 1 && (m * m.inverse())[1].X() == 0 && (m * m.inverse())[2].Z() == 1);
+	static_assert(m.transpose()[0].Y() == 1 && m.transpose()[1].X() == 0);
+	static_assert((m * lm::vec3(1, 1, 1)).X() == 3 && (m * lm::vec3(1, 1, 1)).Z() == 8);
+	static_assert(lm::mat3::identity[1].Y() == 1 && lm::mat3::identity[1].X() == 0);
+
+	// normal matrix of a non uniform scale is the reciprocal scale
+	constexpr lm::mat3 normal = lm::mat3::normalMatrix(lm::mat4::scale(lm::vec3(2, 4, 8)));
+	static_assert(normal[0].X() == 0.5f && normal[1].Y() == 0.25f && normal[2].Z() == 0.125f);
+	static_assert(lm::mat3::normalMatrix(lm::mat3::identity, lm::vec3(2, 4, 8))[2].Z() == 0.125f);
+}
@@ -1 +1,29 @@
-#include "Mat4/Mat4.h"
\ No newline at end of file
+#include "Mat4/Mat4.h"
+
+namespace
+{
+	constexpr lm::mat4 trs = lm::mat4::translation(lm::vec3(1, 2, 3)) * lm::mat4::scale(lm::vec3(2, 2, 2));
+	constexpr lm::vec4 point = trs * lm::vec4(1, 1, 1, 1);
+
+	static_assert(point.X() == 3 && point.Y() == 4 && point.Z() == 5 && point.W() == 1);
+	static_assert(lm::mat4::getTranslationMatrix(trs).Z() == 3 && lm::mat4::getScaleMatrix(trs).Y() == 2);
+	static_assert(lm::mat4::identity[3].W() == 1 && lm::mat4::identity[3].X() == 0);
+	static_assert((trs.affineInverse() * point).X() == 1 && (trs.affineInverse() * point).Z() == 1);
+
+	// rotations follow the right hand rule
+	constexpr lm::vec4 x = lm::mat4::yRotation(90) * lm::vec4(1, 0, 0, 0);
+	constexpr lm::vec4 y = lm::mat4::zRotation(90) * lm::vec4(1, 0, 0, 0);
+	constexpr lm::vec4 z = lm::mat4::xRotation(90) * lm::vec4(0, 1, 0, 0);
+	static_assert(lm::nearlyEqual(x.X(), 0, 1e-6f) && lm::nearlyEqual(x.Z(), -1, 1e-6f));
+	static_assert(lm::nearlyEqual(y.X(), 0, 1e-6f) && lm::nearlyEqual(y.Y(), 1, 1e-6f));
+	static_assert(lm::nearlyEqual(z.Y(), 0, 1e-6f) && lm::nearlyEqual(z.Z(), 1, 1e-6f));
+
+	constexpr lm::mat4 transform = lm::mat4::createTransformMatrix(lm::vec3(0, 0, -5), lm::vec3(0, 90, 0), lm::vec3(1, 1, 1));
+	static_assert(lm::nearlyEqual((transform * lm::vec4(1, 0, 0, 1)).Z(), -6, 1e-6f));
+
+	constexpr lm::mat4 view = lm::mat4::lookAt(lm::vec3(0, 0, 5), lm::vec3(0, 0, 0), lm::vec3(0, 1, 0));
+	static_assert(lm::nearlyEqual((view * lm::vec4(0, 0, 0, 1)).Z(), -5, 1e-6f));
+
+	constexpr lm::mat4 projection = lm::mat4::perspectiveProjection(90, 1, 1, 3);
+	static_assert(lm::nearlyEqual(projection[0].X(), 1, 1e-6f) && lm::nearlyEqual(projection[2].Z(), -2, 1e-6f) && projection[2].W() == -1);
+}
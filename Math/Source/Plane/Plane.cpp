@@ -0,0 +1,15 @@
+#include "Plane/Plane.h"
+
+namespace
+{
+	// y = 2, normal up
+	constexpr lm::plane ground = lm::plane::fromPoint(lm::vec3(0, 1, 0), lm::vec3(5, 2, -3));
+	static_assert(ground.distance == -2 && ground.signedDistance(lm::vec3(1, 5, 1)) == 3 && ground.signedDistance(lm::vec3(0, 0, 0)) == -2);
+	static_assert(ground.project(lm::vec3(7, 9, 1)).Y() == 2);
+
+	constexpr lm::plane triangle = lm::plane::fromPoints(lm::vec3(0, 0, 1), lm::vec3(1, 0, 1), lm::vec3(0, 1, 1));
+	static_assert(lm::nearlyEqual(triangle.normal.Z(), 1, 1e-5f) && lm::nearlyEqual(triangle.distance, -1, 1e-5f));
+
+	constexpr lm::plane scaled = lm::plane(lm::vec4(0, 0, 4, 8)).normalized();
+	static_assert(lm::nearlyEqual(scaled.normal.Z(), 1, 1e-5f) && lm::nearlyEqual(scaled.distance, 2, 1e-5f));
+}
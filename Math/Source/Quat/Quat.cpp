@@ -1 +1,36 @@
-#include "Quat/Quat.h"
\ No newline at end of file
+#include "Quat/Quat.h"
+
+namespace
+{
+	constexpr lm::quat identity(1, 0, 0, 0);
+	static_assert(identity.norm() == 1 && identity.toMat4()[0].X() == 1 && identity.toMat4()[1].X() == 0);
+	static_assert(lm::quat(2, 0, 0, 0).normalized().W() == 1);
+
+	// 90 degrees around y
+	constexpr lm::quat yaw(lm::cmath::cos(float(M_PI / 4)), 0, lm::cmath::sin(float(M_PI / 4)), 0);
+	constexpr lm::mat4 rotation = yaw.toMat4();
+	static_assert(lm::nearlyEqual(rotation[0].X(), 0, 1e-6f) && lm::nearlyEqual(rotation[0].Z(), -1, 1e-6f) && lm::nearlyEqual(rotation[2].X(), 1, 1e-6f));
+
+	// error of the cheaper modes in radians against the exact answer: a turn of t * angle around x
+	constexpr float error(const lm::quat& q, float angle, float t)
+	{
+		const float w = lm::cmath::cos(t * angle * 0.5f) - q.W();
+		const float x = lm::cmath::sin(t * angle * 0.5f) - q.X();
+		return 2 * lm::cmath::sqrt(w * w + x * x + q.Y() * q.Y() + q.Z() * q.Z());
+	}
+
+	constexpr float quarter = float(M_PI / 2);
+	// 177.6 degrees, at exactly 180 the short path is a coin toss
+	constexpr float wide = 3.1f;
+	constexpr lm::quat quarterTurn(lm::cmath::cos(quarter * 0.5f), lm::cmath::sin(quarter * 0.5f), 0, 0);
+	constexpr lm::quat wideTurn(lm::cmath::cos(wide * 0.5f), lm::cmath::sin(wide * 0.5f), 0, 0);
+
+	static_assert(error(lm::quat::correctedNlerp(identity, quarterTurn, 0.25f), quarter, 0.25f) < 1.6e-3f && error(lm::quat::correctedNlerp(identity, quarterTurn, 0.8f), quarter, 0.8f) < 1.6e-3f);
+	static_assert(error(lm::quat::correctedNlerp(identity, wideTurn, 0.2f), wide, 0.2f) < 1.6e-3f && error(lm::quat::correctedNlerp(identity, wideTurn, 0.7f), wide, 0.7f) < 1.6e-3f);
+	static_assert(error(lm::quat::nlerp(identity, quarterTurn, 0.25f), quarter, 0.25f) < 0.016f && error(lm::quat::nlerp(identity, wideTurn, 0.2f), wide, 0.2f) < 0.15f);
+	static_assert(error(lm::quat::nlerp(identity, quarterTurn, 0.5f), quarter, 0.5f) < 1e-6f && error(lm::quat::correctedNlerp(identity, wideTurn, 0.5f), wide, 0.5f) < 1e-6f);
+
+	// both ends are exact and the short path is taken
+	static_assert(lm::quat::correctedNlerp(identity, quarterTurn, 0).W() == 1 && lm::nearlyEqual(lm::quat::correctedNlerp(identity, quarterTurn, 1).X(), quarterTurn.X(), 1e-6f));
+	static_assert(lm::nearlyEqual(lm::quat::nlerp(identity, -quarterTurn, 1).X(), quarterTurn.X(), 1e-6f));
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#include "Ray/Ray.h"
+
+namespace
+{
+	constexpr float enter(const lm::ray& ray, const lm::aabb& aabb, const float maxDistance = std::numeric_limits<float>::max())
+	{
+		float distance = -1;
+		return ray.intersects(aabb, distance, maxDistance) ? distance : -1;
+	}
+
+	constexpr float enter(const lm::ray& ray, const lm::sphere& sphere)
+	{
+		float distance = -1;
+		return ray.intersects(sphere, distance) ? distance : -1;
+	}
+
+	constexpr float enter(const lm::ray& ray, const lm::Plane<float>& plane)
+	{
+		float distance = -1;
+		return ray.intersects(plane, distance) ? distance : -1;
+	}
+
+	constexpr float enter(const lm::ray& ray, const lm::vec3& a, const lm::vec3& b, const lm::vec3& c, const float maxDistance = std::numeric_limits<float>::max())
+	{
+		float distance = -1;
+		return ray.intersects(a, b, c, distance, maxDistance) ? distance : -1;
+	}
+
+	constexpr lm::ray forward(lm::vec3(0, 0, 0), lm::vec3(0, 0, -1));
+	constexpr lm::aabb box(lm::vec3(-1, -1, -6), lm::vec3(1, 1, -4));
+
+	static_assert(lm::nearlyEqual(forward.at(3).Z(), -3, 1e-4f));
+	static_assert(lm::nearlyEqual(enter(forward, box), 4, 1e-4f) && enter(forward, box, 3) < 0);
+	static_assert(enter(lm::ray(lm::vec3(0, 0, 0), lm::vec3(0, 0, 1)), box) < 0);
+	static_assert(enter(lm::ray(lm::vec3(0, 2, 0), lm::vec3(0, 0, -1)), box) < 0);
+	static_assert(lm::nearlyEqual(enter(lm::ray(lm::vec3(0, 0, -5), lm::vec3(0, 0, -1)), box), 0, 1e-4f));
+	static_assert(lm::nearlyEqual(enter(lm::ray(lm::vec3(-3, 0, -5), lm::vec3(1, 0, 0)), box), 2, 1e-4f));
+
+	static_assert(lm::nearlyEqual(enter(forward, lm::sphere(lm::vec3(0, 0, -10), 2)), 8, 1e-4f));
+	static_assert(lm::nearlyEqual(enter(forward, lm::sphere(lm::vec3(0, 0, 0), 2)), 0, 1e-4f));
+	static_assert(enter(forward, lm::sphere(lm::vec3(0, 3, -10), 2)) < 0 && enter(forward, lm::sphere(lm::vec3(0, 0, 10), 2)) < 0);
+
+	static_assert(lm::nearlyEqual(enter(forward, lm::Plane<float>(lm::vec3(0, 0, 1), 7)), 7, 1e-4f));
+	static_assert(enter(forward, lm::Plane<float>(lm::vec3(0, 1, 0), 7)) < 0);
+
+	// either winding, the edges and corners count, in the plane or behind the origin does not
+	static_assert(lm::nearlyEqual(enter(forward, lm::vec3(-1, -1, -3), lm::vec3(1, -1, -3), lm::vec3(0, 1, -3)), 3, 1e-4f));
+	static_assert(lm::nearlyEqual(enter(forward, lm::vec3(-1, -1, -3), lm::vec3(0, 1, -3), lm::vec3(1, -1, -3)), 3, 1e-4f));
+	static_assert(lm::nearlyEqual(enter(forward, lm::vec3(0, 0, -2), lm::vec3(1, 0, -2), lm::vec3(0, 1, -2)), 2, 1e-4f));
+	static_assert(enter(forward, lm::vec3(-1, -1, -3), lm::vec3(1, -1, -3), lm::vec3(0, 1, -3), 2.5f) < 0);
+	static_assert(enter(forward, lm::vec3(1, 1, -3), lm::vec3(2, 1, -3), lm::vec3(1, 2, -3)) < 0);
+	static_assert(enter(forward, lm::vec3(-1, -1, 3), lm::vec3(1, -1, 3), lm::vec3(0, 1, 3)) < 0);
+	static_assert(enter(forward, lm::vec3(0, -1, -1), lm::vec3(0, 1, -1), lm::vec3(0, 0, -5)) < 0);
+
+	static_assert(lm::nearlyEqual(forward.transform(lm::mat4::translation(lm::vec3(1, 2, 3))).origin.Y(), 2, 1e-4f));
+}
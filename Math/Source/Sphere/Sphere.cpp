@@ -0,0 +1,15 @@
+#include "Sphere/Sphere.h"
+
+namespace
+{
+	constexpr lm::sphere unit(lm::vec3(0, 0, 0), 1);
+	static_assert(unit.contains(lm::vec3(0, 1, 0)) && !unit.contains(lm::vec3(1, 1, 0)));
+	static_assert(unit.intersects(lm::sphere(lm::vec3(3, 0, 0), 2)) && !unit.intersects(lm::sphere(lm::vec3(3, 0, 0), 1.5f)));
+	static_assert(unit.intersects(lm::aabb(lm::vec3(0.5f, 0.5f, -1), lm::vec3(2, 2, 1))) && !unit.intersects(lm::aabb(lm::vec3(0.8f, 0.8f, -1), lm::vec3(2, 2, 1))));
+
+	constexpr lm::sphere bounds = lm::sphere::fromAABB(lm::aabb(lm::vec3(-1, -2, -2), lm::vec3(1, 2, 2)));
+	static_assert(lm::nearlyEqual(bounds.radius, 3, 1e-5f) && bounds.toAABB().max.X() == 3);
+
+	constexpr lm::sphere moved = unit.transform(lm::mat4::translation(lm::vec3(0, 5, 0)) * lm::mat4::scale(lm::vec3(1, 3, 2)));
+	static_assert(lm::nearlyEqual(moved.center.Y(), 5, 1e-5f) && lm::nearlyEqual(moved.radius, 3, 1e-5f));
+}
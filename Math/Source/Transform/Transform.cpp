@@ -0,0 +1,21 @@
+#include "Transform/Transform.h"
+
+namespace
+{
+	constexpr lm::transform parent = lm::transform::fromEuler(lm::vec3(1, 2, 3), lm::vec3(0, 90, 0), lm::vec3(2, 2, 2));
+	constexpr lm::transform child = lm::transform::fromEuler(lm::vec3(0, 0, -1), lm::vec3(30, 0, 45), lm::vec3(1, 2, 3));
+
+	// toMat4 matches the euler matrix it replaces
+	constexpr lm::mat4 euler = lm::mat4::createTransformMatrix(lm::vec3(0, 0, -1), lm::vec3(30, 0, 45), lm::vec3(1, 2, 3));
+	static_assert(lm::nearlyEqual(child.toMat4()[0].X(), euler[0].X(), 1e-5f) && lm::nearlyEqual(child.toMat4()[1].Z(), euler[1].Z(), 1e-5f));
+	static_assert(lm::nearlyEqual(child.toMat4()[2].Y(), euler[2].Y(), 1e-5f) && child.toMat4()[3].Z() == -1);
+
+	// composition and inverse agree with the matrix products
+	constexpr lm::vec3 point = (parent * child).transformPoint(lm::vec3(1, 1, 1));
+	constexpr lm::vec4 expected = parent.toMat4() * child.toMat4() * lm::vec4(1, 1, 1, 1);
+	static_assert(lm::nearlyEqual(point.X(), expected.X(), 1e-5f) && lm::nearlyEqual(point.Y(), expected.Y(), 1e-5f) && lm::nearlyEqual(point.Z(), expected.Z(), 1e-5f));
+
+	constexpr lm::vec3 back = parent.inverse().transformPoint(parent.transformPoint(lm::vec3(4, 5, 6)));
+	static_assert(lm::nearlyEqual(back.X(), 4, 1e-5f) && lm::nearlyEqual(back.Y(), 5, 1e-5f) && lm::nearlyEqual(back.Z(), 6, 1e-5f));
+	static_assert(lm::transform::identity.toMat4()[0].X() == 1 && lm::transform::identity.toMat4()[3].W() == 1);
+}
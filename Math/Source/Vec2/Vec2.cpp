@@ -1 +1,16 @@
-#include "Vec2/Vec2.h"
\ No newline at end of file
+#include "Vec2/Vec2.h"
+
+namespace
+{
+	constexpr lm::vec2 a(3, 4);
+	constexpr lm::vec2 b(1, 2);
+
+	static_assert(a.length() == 5 && a.length2() == 25);
+	static_assert((a + b).X() == 4 && (a + b).Y() == 6);
+	static_assert((a - b).X() == 2 && (-a).Y() == -4);
+	static_assert((a * 2.f).Y() == 8 && (a / 2.f).X() == 1.5f);
+	static_assert(a.dotProduct(b) == 11 && a.crossProduct(b) == 2);
+	static_assert(a.normalized().X() == 0.6f && a.normalized().Y() == 0.8f);
+	static_assert(lm::vec2::up.Y() == 1 && lm::vec2::left.X() == -1 && lm::vec2::zero.length2() == 0);
+	static_assert(lm::degreesToRadians(180) == M_PI && lm::radiansToDegrees(M_PI) == 180);
+}
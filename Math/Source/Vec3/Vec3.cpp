@@ -1 +1,19 @@
-#include "Vec3/Vec3.h"
\ No newline at end of file
+#include "Vec3/Vec3.h"
+
+namespace
+{
+	constexpr lm::vec3 a(1, 2, 2);
+	constexpr lm::vec3 b(4, 5, 6);
+
+	static_assert(a.length() == 3 && a.length2() == 9);
+	static_assert((a + b).Z() == 8 && (b - a).X() == 3 && (-a).Y() == -2);
+	static_assert((a * 3.f).Z() == 6 && (b / 2.f).X() == 2 && (2.0 * a).Y() == 4);
+	static_assert(a.dotProduct(b) == 26 && (a, b) == 26);
+	static_assert(a.crossProduct(b).X() == 2 && a.crossProduct(b).Y() == 2 && a.crossProduct(b).Z() == -3);
+	static_assert(a.scaled(b).Z() == 12 && a.distance(lm::vec3(1, 2, 5)) == 3);
+	static_assert(lm::vec3(0, 0, 4).normalized().Z() == 1 && lm::vec3::zero.normalized().length2() == 0);
+	static_assert(lm::vec3::lerp(a, b, 0.5f).X() == 2.5f);
+	static_assert(lm::vec3::forward.Z() == -1 && lm::vec3::right.crossProduct(lm::vec3::up).Z() == 1);
+	static_assert(lm::vec3::degreesToRadians(90) == M_PI / 2);
+	static_assert(a[1] == 2 && a["z"] == 2);
+}
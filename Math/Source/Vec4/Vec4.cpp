@@ -1 +1,15 @@
-#include "Vec4/Vec4.h"
\ No newline at end of file
+#include "Vec4/Vec4.h"
+
+namespace
+{
+	constexpr lm::vec4 a(1, 2, 2, 1);
+	constexpr lm::vec4 b(lm::vec3(4, 5, 6), 0);
+
+	static_assert(a.length() == 3 && b.W() == 0);
+	static_assert((a + b).Z() == 8 && (a + b).W() == 1 && (b - a).X() == 3);
+	static_assert((a * 2.f).W() == 2 && a.dotProduct(b) == 26);
+	static_assert(a.crossProduct(b).Z() == -3 && a.crossProduct(b).W() == 0);
+	static_assert(lm::vec4(0, 3, 0, 0).normalized().Y() == 1);
+	static_assert(lm::vec4::up.Y() == 1 && lm::vec4::zero.W() == 0);
+	static_assert(a[3] == 1 && a["w"] == 1);
+}
@@ -0,0 +1,120 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+	#include <intrin.h>
+#endif
+
+namespace MathBench
+{
+	struct Result
+	{
+		std::string mName;
+		std::string mForm;
+		size_t mOpsPerIteration;
+		size_t mIterations;
+		double mNsPerOp;
+		double mOpsPerSecond;
+	};
+
+	struct Accuracy
+	{
+		std::string mName;
+		std::string mPrecision;
+		size_t mSamples;
+		double mMaxError;
+		double mMeanError;
+		double mWorstInput;
+		// the documented bound of the max error, infinity when the result is only reported
+		double mBound;
+
+		bool passed() const
+		{
+			return mMaxError <= mBound;
+		}
+	};
+
+	// keeps the compiler from folding or dropping a computation whose result is never read
+	template <typename T> inline void doNotOptimize(const T& pValue)
+	{
+#if defined(_MSC_VER)
+		static volatile const void* sink;
+		sink = &pValue;
+		_ReadWriteBarrier();
+#else
+		asm volatile("" : : "r"(&pValue) : "memory");
+#endif
+	}
+
+	class Runner
+	{
+	public:
+		std::vector<Result> mResults;
+		double mMinTimeMs;
+		unsigned int mSamples;
+		std::string mFilter;
+
+		Runner(double pMinTimeMs, unsigned int pSamples, const std::string& pFilter);
+
+		// pFunction runs one iteration worth pOpsPerIteration operations, the best sample is kept
+		template <typename F> void run(const std::string& pName, const std::string& pForm, size_t pOpsPerIteration, F&& pFunction)
+		{
+			if (!mFilter.empty() && (pName + "/" + pForm).find(mFilter) == std::string::npos)
+				return;
+
+			size_t iterations = 1;
+			double elapsedNs = time(iterations, pFunction);
+			while (elapsedNs < mMinTimeMs * 1e6)
+			{
+				const double scale = elapsedNs <= 0 ? 10.0 : std::min(10.0, 1.2 * mMinTimeMs * 1e6 / elapsedNs);
+				iterations = std::max(iterations + 1, size_t(double(iterations) * scale));
+				elapsedNs = time(iterations, pFunction);
+			}
+
+			double best = elapsedNs;
+			for (unsigned int i = 1; i < mSamples; i++)
+				best = std::min(best, time(iterations, pFunction));
+
+			const double nsPerOp = best / double(iterations * pOpsPerIteration);
+			mResults.push_back({ pName, pForm, pOpsPerIteration, iterations, nsPerOp, 1e9 / nsPerOp });
+		}
+
+		void writeTable(std::ostream& pStream) const;
+		void writeCsv(std::ostream& pStream) const;
+		void writeJson(std::ostream& pStream, const std::string& pBackend) const;
+
+	private:
+		template <typename F> static double time(size_t pIterations, F& pFunction)
+		{
+			const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			for (size_t i = 0; i < pIterations; i++)
+				pFunction();
+
+			return double(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+		}
+	};
+
+	// error of approximations against a reference, absolute or relative to the reference; a result
+	// given a bound fails when its max error is above it
+	class AccuracyReport
+	{
+	public:
+		std::vector<Accuracy> mResults;
+
+		void add(const std::string& pName, const std::string& pPrecision, const std::vector<float>& pInputs,
+			const std::vector<float>& pValues, const std::vector<double>& pReferences, bool pRelative = false,
+			double pBound = std::numeric_limits<double>::infinity());
+
+		// every result within its bound
+		bool passed() const;
+
+		void writeTable(std::ostream& pStream) const;
+		void writeCsv(std::ostream& pStream) const;
+		void writeJson(std::ostream& pStream, const std::string& pBackend) const;
+	};
+}
@@ -0,0 +1,14 @@
+#pragma once
+#include "Benchmark.h"
+
+namespace MathBench
+{
+	// the lm::mat4 operations as this build runs them against the scalar code of Mat4 (scalarMultiply,
+	// scalarInverse...), the one LM_FORCE_SCALAR and non-float types run, on random and near-singular
+	// matrices; every result has the bound it is held to
+	void measureSimdParity(AccuracyReport& pReport);
+
+	// lm::bvh queries against testing every box, after rounds of inserts, removes and batched updates;
+	// the error is the number of ids the two disagree on
+	void measureBvhParity(AccuracyReport& pReport);
+}
@@ -0,0 +1,140 @@
+#include "Benchmark.h"
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+using namespace MathBench;
+
+namespace
+{
+	// pEmpty for a result without a bound
+	std::string formatBound(double pBound, const char* pEmpty)
+	{
+		if (!std::isfinite(pBound))
+			return pEmpty;
+
+		std::ostringstream stream;
+		stream << std::setprecision(3) << pBound;
+		return stream.str();
+	}
+}
+
+Runner::Runner(double pMinTimeMs, unsigned int pSamples, const std::string& pFilter) :
+	mMinTimeMs(pMinTimeMs),
+	mSamples(pSamples == 0 ? 1 : pSamples),
+	mFilter(pFilter)
+{
+}
+
+void Runner::writeTable(std::ostream& pStream) const
+{
+	pStream << std::left << std::setw(32) << "benchmark" << std::setw(10) << "form"
+		<< std::right << std::setw(14) << "ns/op" << std::setw(18) << "ops/s" << '\n';
+
+	for (const Result& result : mResults)
+	{
+		pStream << std::left << std::setw(32) << result.mName << std::setw(10) << result.mForm
+			<< std::right << std::fixed << std::setprecision(3) << std::setw(14) << result.mNsPerOp
+			<< std::setprecision(0) << std::setw(18) << result.mOpsPerSecond << '\n';
+	}
+}
+
+void Runner::writeCsv(std::ostream& pStream) const
+{
+	pStream << "name,form,ops_per_iteration,iterations,ns_per_op,ops_per_second\n";
+	for (const Result& result : mResults)
+	{
+		pStream << result.mName << ',' << result.mForm << ',' << result.mOpsPerIteration << ',' << result.mIterations << ','
+			<< std::setprecision(6) << result.mNsPerOp << ',' << std::fixed << std::setprecision(0) << result.mOpsPerSecond << '\n';
+		pStream.unsetf(std::ios_base::floatfield);
+	}
+}
+
+void Runner::writeJson(std::ostream& pStream, const std::string& pBackend) const
+{
+	pStream << "{\n\t\"backend\": \"" << pBackend << "\",\n\t\"results\": [\n";
+	for (size_t i = 0; i < mResults.size(); i++)
+	{
+		const Result& result = mResults[i];
+		pStream << "\t\t{ \"name\": \"" << result.mName << "\", \"form\": \"" << result.mForm
+			<< "\", \"ops_per_iteration\": " << result.mOpsPerIteration << ", \"iterations\": " << result.mIterations
+			<< ", \"ns_per_op\": " << std::setprecision(6) << result.mNsPerOp
+			<< ", \"ops_per_second\": " << std::fixed << std::setprecision(0) << result.mOpsPerSecond << " }"
+			<< (i + 1 < mResults.size() ? ",\n" : "\n");
+		pStream.unsetf(std::ios_base::floatfield);
+	}
+	pStream << "\t]\n}\n";
+}
+
+void AccuracyReport::add(const std::string& pName, const std::string& pPrecision, const std::vector<float>& pInputs,
+	const std::vector<float>& pValues, const std::vector<double>& pReferences, bool pRelative, double pBound)
+{
+	Accuracy accuracy = { pName, pPrecision, pValues.size(), 0, 0, 0, pBound };
+	for (size_t i = 0; i < pValues.size(); i++)
+	{
+		double error = std::abs(double(pValues[i]) - pReferences[i]);
+		if (pRelative && pReferences[i] != 0)
+			error /= std::abs(pReferences[i]);
+
+		accuracy.mMeanError += error;
+		if (error > accuracy.mMaxError)
+		{
+			accuracy.mMaxError = error;
+			accuracy.mWorstInput = pInputs[i];
+		}
+	}
+
+	if (!pValues.empty())
+		accuracy.mMeanError /= double(pValues.size());
+
+	mResults.push_back(accuracy);
+}
+
+bool AccuracyReport::passed() const
+{
+	return std::all_of(mResults.begin(), mResults.end(), [](const Accuracy& pAccuracy) { return pAccuracy.passed(); });
+}
+
+void AccuracyReport::writeTable(std::ostream& pStream) const
+{
+	pStream << std::left << std::setw(24) << "function" << std::setw(10) << "precision"
+		<< std::right << std::setw(14) << "max error" << std::setw(14) << "mean error" << std::setw(16) << "worst input"
+		<< std::setw(12) << "bound" << '\n';
+
+	for (const Accuracy& accuracy : mResults)
+	{
+		pStream << std::left << std::setw(24) << accuracy.mName << std::setw(10) << accuracy.mPrecision
+			<< std::right << std::scientific << std::setprecision(2) << std::setw(14) << accuracy.mMaxError << std::setw(14) << accuracy.mMeanError
+			<< std::defaultfloat << std::setprecision(6) << std::setw(16) << accuracy.mWorstInput;
+
+		if (std::isfinite(accuracy.mBound))
+			pStream << std::scientific << std::setprecision(2) << std::setw(12) << accuracy.mBound << std::defaultfloat << (accuracy.passed() ? "" : "  FAILED");
+		pStream << '\n';
+	}
+}
+
+void AccuracyReport::writeCsv(std::ostream& pStream) const
+{
+	pStream << "name,precision,samples,max_error,mean_error,worst_input,bound,passed\n";
+	for (const Accuracy& accuracy : mResults)
+	{
+		pStream << accuracy.mName << ',' << accuracy.mPrecision << ',' << accuracy.mSamples << ','
+			<< std::setprecision(6) << accuracy.mMaxError << ',' << accuracy.mMeanError << ',' << accuracy.mWorstInput << ','
+			<< formatBound(accuracy.mBound, "") << ',' << (accuracy.passed() ? "true" : "false") << '\n';
+	}
+}
+
+void AccuracyReport::writeJson(std::ostream& pStream, const std::string& pBackend) const
+{
+	pStream << "{\n\t\"backend\": \"" << pBackend << "\",\n\t\"accuracy\": [\n";
+	for (size_t i = 0; i < mResults.size(); i++)
+	{
+		const Accuracy& accuracy = mResults[i];
+		pStream << "\t\t{ \"name\": \"" << accuracy.mName << "\", \"precision\": \"" << accuracy.mPrecision
+			<< "\", \"samples\": " << accuracy.mSamples << ", \"max_error\": " << std::setprecision(6) << accuracy.mMaxError
+			<< ", \"mean_error\": " << accuracy.mMeanError << ", \"worst_input\": " << accuracy.mWorstInput
+			<< ", \"bound\": " << formatBound(accuracy.mBound, "null") << ", \"passed\": " << (accuracy.passed() ? "true" : "false") << " }"
+			<< (i + 1 < mResults.size() ? ",\n" : "\n");
+	}
+	pStream << "\t]\n}\n";
+}
@@ -0,0 +1,1024 @@
+#include "Benchmark.h"
+#include "Parity.h"
+#include "Batch/Batch.h"
+#include "Transform/Transform.h"
+#include "FastMath/FastMath.h"
+#include "Expr/Expr.h"
+#include "BVH/BVH.h"
+#include "Pool.h"
+#include "FrameArena.h"
+#include "CollisionMesh.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+
+using namespace MathBench;
+
+namespace
+{
+	constexpr size_t COUNT = 1024;
+
+	struct Data
+	{
+		std::vector<lm::mat4> mMatA;
+		std::vector<lm::mat4> mMatB;
+		std::vector<lm::mat4> mMatOut;
+		std::vector<lm::mat3> mMat3Out;
+		std::vector<lm::vec4> mVec4;
+		std::vector<lm::vec4> mVec4Out;
+		std::vector<lm::vec3> mVecA;
+		std::vector<lm::vec3> mVecB;
+		std::vector<lm::vec3> mVecOut;
+		std::vector<lm::vec3> mPosition;
+		std::vector<lm::vec3> mRotation;
+		std::vector<lm::vec3> mScale;
+		std::vector<lm::quat> mQuatA;
+		std::vector<lm::quat> mQuatB;
+		std::vector<lm::quat> mQuatOut;
+		std::vector<float> mFloat;
+		std::vector<float> mAngle;
+		std::vector<float> mCosine;
+		std::vector<float> mFloatOut;
+		std::vector<float> mFloatOut2;
+		std::vector<lm::aabb> mBox;
+		std::vector<lm::aabb> mBoxOut;
+		std::vector<size_t> mIndexOut;
+		std::vector<bool> mVisibleOut;
+		lm::frustum mFrustum;
+
+		Data()
+		{
+			std::mt19937 generator(42);
+			std::uniform_real_distribution<float> unit(-1.f, 1.f);
+			std::uniform_real_distribution<float> angle(-180.f, 180.f);
+			std::uniform_real_distribution<float> scale(0.5f, 2.f);
+
+			for (size_t i = 0; i < COUNT; i++)
+			{
+				mPosition.emplace_back(unit(generator) * 10, unit(generator) * 10, unit(generator) * 10);
+				mRotation.emplace_back(angle(generator), angle(generator), angle(generator));
+				mScale.emplace_back(scale(generator), scale(generator), scale(generator));
+
+				mMatA.push_back(lm::mat4::createTransformMatrix(mPosition[i], mRotation[i], mScale[i]));
+				mMatB.push_back(lm::mat4::createTransformMatrix(mRotation[i] * 0.1f, mPosition[i] * 10.f, mScale[i]));
+				mVec4.emplace_back(unit(generator), unit(generator), unit(generator), 1.f);
+				mVecA.emplace_back(unit(generator), unit(generator), unit(generator));
+				mVecB.emplace_back(unit(generator), unit(generator), unit(generator));
+				mQuatA.push_back(lm::quat::fromEuler(mRotation[i]));
+				mQuatB.push_back(lm::quat::fromEuler(mRotation[i].scaled(lm::vec3(-0.5f, 0.25f, 0.75f))));
+				mFloat.push_back((unit(generator) + 1) * 0.5f);
+				mBox.push_back(lm::aabb::fromCenterExtents(mPosition[i] * 5.f, mScale[i]));
+				mAngle.push_back(angle(generator));
+				mCosine.push_back(unit(generator));
+			}
+
+			// a bit over a third of the boxes end up inside
+			const lm::mat4 view = lm::mat4::lookAt(lm::vec3(0, 0, 30), lm::vec3(0, 0, 0), lm::vec3::up);
+			mFrustum = lm::frustum::fromMatrix(lm::mat4::perspectiveProjection(60, 16.f / 9.f, 0.1f, 100) * view);
+
+			mMatOut.resize(COUNT);
+			mMat3Out.resize(COUNT);
+			mVec4Out.resize(COUNT);
+			mVecOut.resize(COUNT);
+			mQuatOut.resize(COUNT);
+			mBoxOut.resize(COUNT);
+			mIndexOut.resize(COUNT);
+			mVisibleOut.resize(COUNT);
+			mFloatOut.resize(COUNT);
+			mFloatOut2.resize(COUNT);
+		}
+	};
+
+	// single calls walk through the inputs so nothing can be hoisted out of the timing loop
+	struct Cursor
+	{
+		size_t mIndex = 0;
+
+		size_t next()
+		{
+			mIndex = (mIndex + 1) & (COUNT - 1);
+			return mIndex;
+		}
+	};
+
+	const char* backend()
+	{
+#if defined(LM_SIMD_AVX2)
+		return "avx2";
+#elif defined(LM_SIMD_SSE)
+		return "sse";
+#else
+		return "scalar";
+#endif
+	}
+
+	void registerMatrix(Runner& pRunner, Data& pData)
+	{
+		Cursor cursor;
+
+		pRunner.run("mat4.multiply", "single", 1, [&]()
+		{
+			const size_t i = cursor.next();
+			doNotOptimize(pData.mMatA[i] * pData.mMatB[i]);
+		});
+		pRunner.run("mat4.multiply", "array", COUNT, [&]()
+		{
+			for (size_t i = 0; i < COUNT; i++)
+				pData.mMatOut[i] = pData.mMatA[i] * pData.mMatB[i];
+			doNotOptimize(pData.mMatOut);
+		});
+		pRunner.run("mat4.multiply", "batch", COUNT, [&]()
+		{
+			lm::batch::multiply(pData.mMatA.data(), pData.mMatB.data(), pData.mMatOut.data(), COUNT);
+			doNotOptimize(pData.mMatOut);
+		});
+
+		pRunner.run("mat4.transform", "single", 1, [&]()
+		{
+			const size_t i = cursor.next();
+			doNotOptimize(pData.mMatA[i] * pData.mVec4[i]);
+		});
+		pRunner.run("mat4.transform", "batch", COUNT, [&]()
+		{
+			lm::batch::transform(pData.mMatA.data(), pData.mVec4.data(), pData.mVec4Out.data(), COUNT);
+			doNotOptimize(pData.mVec4Out);
+		});
+
+		pRunner.run("mat4.inverse", "single", 1, [&]()
+		{
+			const size_t i = cursor.next();
+			doNotOptimize(pData.mMatA[i].inverse());
+		});
+		pRunner.run("mat4.inverse", "array", COUNT, [&]()
+		{
+			for (size_t i = 0; i < COUNT; i++)
+				pData.mMatOut[i] = pData.mMatA[i].inverse();
+			doNotOptimize(pData.mMatOut);
+		});
+
+		pRunner.run("mat4.affineInverse", "single", 1, [&]()
+		{
+			const size_t i = cursor.next();
+			doNotOptimize(pData.mMatA[i].affineInverse());
+		});
+		pRunner.run("mat4.affineInverse", "batch", COUNT, [&]()
+		{
+			lm::batch::affineInverse(pData.mMatA.data(), pData.mMatOut.data(), COUNT);
+			doNotOptimize(pData.mMatOut);
+		});
+
+		pRunner.run("mat3.inverseTranspose", "single", 1, [&]()
+		{
+			const size_t i = cursor.next();
+			doNotOptimize(lm::mat3(pData.mMatA[i]).inverse().transpose());
+		});
+		pRunner.run("mat3.normalMatrix", "single", 1, [&]()
+		{
+			const size_t i = cursor.next();
+			doNotOptimize(lm::mat3::normalMatrix(pData.mMatA[i]));
+		});
+		pRunner.run("mat3.normalMatrix", "batch", COUNT, [&]()
+		{
+			lm::batch::normalMatrix(pData.mMatA.data(), pData.mMat3Out.data(), COUNT);
+			doNotOptimize(pData.mMat3Out);
+		});
+
+		pRunner.run("mat4.lookAt", "single", 1, [&]()
+		{
+			const size_t i = cursor.next();
+			doNotOptimize(lm::mat4::lookAt(pData.mPosition[i], pData.mVecA[i], lm::vec3::up));
+		});
+		pRunner.run("mat4.lookAt", "array", COUNT, [&]()
+		{
+			for (size_t i = 0; i < COUNT; i++)
+				pData.mMatOut[i] = lm::mat4::lookAt(pData.mPosition[i], pData.mVecA[i], lm::vec3::up);
+			doNotOptimize(pData.mMatOut);
+		});
+
+		pRunner.run("mat4.perspectiveProjection", "single", 1, [&]()
+		{
+			const size_t i = cursor.next();
+			doNotOptimize(lm::mat4::perspectiveProjection(45.f + pData.mFloat[i], 1.5f, 0.01f, 500.f));
+		});
+		pRunner.run("mat4.perspectiveProjection", "array", COUNT, [&]()
+		{
+			for (size_t i = 0; i < COUNT; i++)
+				pData.mMatOut[i] = lm::mat4::perspectiveProjection(45.f + pData.mFloat[i], 1.5f, 0.01f, 500.f);
+			doNotOptimize(pData.mMatOut);
+		});
+	}
+
+	void registerTransform(Runner& pRunner, Data& pData)
+	{
+		Cursor cursor;
+
+		pRunner.run("mat4.createTransformMatrix", "single", 1, [&]()
+		{
+			const size_t i = cursor.next();
+			doNotOptimize(lm::mat4::createTransformMatrix(pData.mPosition[i], pData.mRotation[i], pData.mScale[i]));
+		});
+		pRunner.run("mat4.createTransformMatrix", "batch", COUNT, [&]()
+		{
+			lm::batch::composeEuler(pData.mPosition.data(), pData.mRotation.data(), pData.mScale.data(), pData.mMatOut.data(), COUNT);
+			doNotOptimize(pData.mMatOut);
+		});
+
+		pRunner.run("transform.toMat4", "single", 1, [&]()
+		{
+			const size_t i = cursor.next();
+			doNotOptimize(lm::transform(pData.mPosition[i], pData.mQuatA[i], pData.mScale[i]).toMat4());
+		});
+		pRunner.run("transform.toMat4", "batch", COUNT, [&]()
+		{
+			lm::batch::compose(pData.mPosition.data(), pData.mQuatA.data(), pData.mScale.data(), pData.mMatOut.data(), COUNT);
+			doNotOptimize(pData.mMatOut);
+		});
+	}
+
+	void registerQuat(Runner& pRunner, Data& pData)
+	{
+		Cursor cursor;
+
+		pRunner.run("quat.slerp", "single", 1, [&]()
+		{
+			const size_t i = cursor.next();
+			doNotOptimize(lm::quat::slerp(pData.mQuatA[i], pData.mQuatB[i], pData.mFloat[i]));
+		});
+		pRunner.run("quat.slerp", "array", COUNT, [&]()
+		{
+			for (size_t i = 0; i < COUNT; i++)
+				pData.mQuatOut[i] = lm::quat::slerp(pData.mQuatA[i], pData.mQuatB[i], pData.mFloat[i]);
+			doNotOptimize(pData.mQuatOut);
+		});
+		pRunner.run("quat.slerp", "batch", COUNT, [&]()
+		{
+			lm::batch::interpolate(pData.mQuatA.data(), pData.mQuatB.data(), pData.mFloat.data(), pData.mQuatOut.data(), COUNT, lm::QuatInterpolation::SLERP);
+			doNotOptimize(pData.mQuatOut);
+		});
+
+		pRunner.run("quat.nlerp", "array", COUNT, [&]()
+		{
+			for (size_t i = 0; i < COUNT; i++)
+				pData.mQuatOut[i] = lm::quat::nlerp(pData.mQuatA[i], pData.mQuatB[i], pData.mFloat[i]);
+			doNotOptimize(pData.mQuatOut);
+		});
+		pRunner.run("quat.nlerp", "batch", COUNT, [&]()
+		{
+			lm::batch::interpolate(pData.mQuatA.data(), pData.mQuatB.data(), pData.mFloat.data(), pData.mQuatOut.data(), COUNT, lm::QuatInterpolation::NLERP);
+			doNotOptimize(pData.mQuatOut);
+		});
+
+		pRunner.run("quat.correctedNlerp", "array", COUNT, [&]()
+		{
+			for (size_t i = 0; i < COUNT; i++)
+				pData.mQuatOut[i] = lm::quat::correctedNlerp(pData.mQuatA[i], pData.mQuatB[i], pData.mFloat[i]);
+			doNotOptimize(pData.mQuatOut);
+		});
+		pRunner.run("quat.correctedNlerp", "batch", COUNT, [&]()
+		{
+			lm::batch::interpolate(pData.mQuatA.data(), pData.mQuatB.data(), pData.mFloat.data(), pData.mQuatOut.data(), COUNT, lm::QuatInterpolation::CORRECTED_NLERP);
+			doNotOptimize(pData.mQuatOut);
+		});
+
+		pRunner.run("quat.toMat4", "single", 1, [&]()
+		{
+			const size_t i = cursor.next();
+			doNotOptimize(pData.mQuatA[i].toMat4());
+		});
+		pRunner.run("quat.toMat4", "array", COUNT, [&]()
+		{
+			for (size_t i = 0; i < COUNT; i++)
+				pData.mMatOut[i] = pData.mQuatA[i].toMat4();
+			doNotOptimize(pData.mMatOut);
+		});
+	}
+
+	void registerVector(Runner& pRunner, Data& pData)
+	{
+		Cursor cursor;
+
+		pRunner.run("vec3.normalize", "single", 1, [&]()
+		{
+			const size_t i = cursor.next();
+			doNotOptimize(pData.mVecA[i].normalized());
+		});
+		pRunner.run("vec3.normalize", "array", COUNT, [&]()
+		{
+			for (size_t i = 0; i < COUNT; i++)
+				pData.mVecOut[i] = pData.mVecA[i].normalized();
+			doNotOptimize(pData.mVecOut);
+		});
+
+		pRunner.run("vec3.cross", "single", 1, [&]()
+		{
+			const size_t i = cursor.next();
+			doNotOptimize(pData.mVecA[i].crossProduct(pData.mVecB[i]));
+		});
+		pRunner.run("vec3.cross", "array", COUNT, [&]()
+		{
+			for (size_t i = 0; i < COUNT; i++)
+				pData.mVecOut[i] = pData.mVecA[i].crossProduct(pData.mVecB[i]);
+			doNotOptimize(pData.mVecOut);
+		});
+	}
+
+	void registerBounds(Runner& pRunner, Data& pData)
+	{
+		Cursor cursor;
+
+		pRunner.run("aabb.transform", "single", 1, [&]()
+		{
+			const size_t i = cursor.next();
+			doNotOptimize(pData.mBox[i].transform(pData.mMatA[i]));
+		});
+		pRunner.run("aabb.transform", "batch", COUNT, [&]()
+		{
+			lm::batch::transform(pData.mMatA.data(), pData.mBox.data(), pData.mBoxOut.data(), COUNT);
+			doNotOptimize(pData.mBoxOut);
+		});
+
+		pRunner.run("frustum.intersects", "single", 1, [&]()
+		{
+			const size_t i = cursor.next();
+			doNotOptimize(pData.mFrustum.intersects(pData.mBox[i]));
+		});
+		pRunner.run("frustum.intersects", "array", COUNT, [&]()
+		{
+			for (size_t i = 0; i < COUNT; i++)
+				pData.mVisibleOut[i] = pData.mFrustum.intersects(pData.mBox[i]);
+			doNotOptimize(pData.mVisibleOut);
+		});
+		pRunner.run("frustum.intersects", "batch", COUNT, [&]()
+		{
+			doNotOptimize(lm::batch::cull(pData.mFrustum, pData.mBox.data(), pData.mIndexOut.data(), COUNT));
+			doNotOptimize(pData.mIndexOut);
+		});
+	}
+
+	// eager operators against lm::expr, every form computes the same matrix or vector
+	void registerExpr(Runner& pRunner, Data& pData)
+	{
+		Cursor cursor;
+
+		pRunner.run("expr.trs", "operators", 1, [&]()
+		{
+			const size_t i = cursor.next();
+			doNotOptimize(lm::mat4::translation(pData.mPosition[i]) * pData.mQuatA[i].toMat4() * lm::mat4::scale(pData.mScale[i]));
+		});
+		pRunner.run("expr.trs", "lazy", 1, [&]()
+		{
+			const size_t i = cursor.next();
+			const lm::mat4 trs = lm::expr::translate(pData.mPosition[i]) * lm::expr::rotate(pData.mQuatA[i]) * lm::expr::scale(pData.mScale[i]);
+			doNotOptimize(trs);
+		});
+		pRunner.run("expr.trs", "transform", 1, [&]()
+		{
+			const size_t i = cursor.next();
+			doNotOptimize(lm::transform(pData.mPosition[i], pData.mQuatA[i], pData.mScale[i]).toMat4());
+		});
+
+		pRunner.run("expr.parentTrs", "operators", 1, [&]()
+		{
+			const size_t i = cursor.next();
+			doNotOptimize(pData.mMatB[i] * (lm::mat4::translation(pData.mPosition[i]) * pData.mQuatA[i].toMat4() * lm::mat4::scale(pData.mScale[i])));
+		});
+		pRunner.run("expr.parentTrs", "lazy", 1, [&]()
+		{
+			const size_t i = cursor.next();
+			const lm::mat4 world = pData.mMatB[i] * (lm::expr::translate(pData.mPosition[i]) * lm::expr::rotate(pData.mQuatA[i]) * lm::expr::scale(pData.mScale[i]));
+			doNotOptimize(world);
+		});
+
+		pRunner.run("expr.chain3", "operators", 1, [&]()
+		{
+			const size_t i = cursor.next();
+			doNotOptimize(pData.mMatA[i] * pData.mMatB[i] * pData.mMatA[COUNT - 1 - i]);
+		});
+		pRunner.run("expr.chain3", "lazy", 1, [&]()
+		{
+			const size_t i = cursor.next();
+			const lm::mat4 chain = lm::expr::lazy(pData.mMatA[i]) * pData.mMatB[i] * pData.mMatA[COUNT - 1 - i];
+			doNotOptimize(chain);
+		});
+
+		pRunner.run("expr.chainVec4", "operators", 1, [&]()
+		{
+			const size_t i = cursor.next();
+			doNotOptimize(pData.mMatA[i] * pData.mMatB[i] * pData.mVec4[i]);
+		});
+		pRunner.run("expr.chainVec4", "lazy", 1, [&]()
+		{
+			const size_t i = cursor.next();
+			doNotOptimize((lm::expr::lazy(pData.mMatA[i]) * pData.mMatB[i]) * pData.mVec4[i]);
+		});
+	}
+
+	template <lm::fastmath::Precision P> void registerFastMathTier(Runner& pRunner, Data& pData, const std::string& pForm)
+	{
+		pRunner.run("fastmath.sincosDeg", pForm, COUNT, [&]()
+		{
+			lm::fastmath::sincosDeg<P>(pData.mAngle.data(), pData.mFloatOut.data(), pData.mFloatOut2.data(), COUNT);
+			doNotOptimize(pData.mFloatOut);
+			doNotOptimize(pData.mFloatOut2);
+		});
+		pRunner.run("fastmath.acos", pForm, COUNT, [&]()
+		{
+			lm::fastmath::acos<P>(pData.mCosine.data(), pData.mFloatOut.data(), COUNT);
+			doNotOptimize(pData.mFloatOut);
+		});
+		pRunner.run("fastmath.atan2", pForm, COUNT, [&]()
+		{
+			lm::fastmath::atan2<P>(pData.mCosine.data(), pData.mAngle.data(), pData.mFloatOut.data(), COUNT);
+			doNotOptimize(pData.mFloatOut);
+		});
+		pRunner.run("fastmath.rsqrt", pForm, COUNT, [&]()
+		{
+			lm::fastmath::rsqrt<P>(pData.mFloat.data(), pData.mFloatOut.data(), COUNT);
+			doNotOptimize(pData.mFloatOut);
+		});
+	}
+
+	// the std form is what the callers did before: double precision libm on degrees
+	void registerFastMath(Runner& pRunner, Data& pData)
+	{
+		Cursor cursor;
+
+		pRunner.run("fastmath.sincosDeg", "std", COUNT, [&]()
+		{
+			for (size_t i = 0; i < COUNT; i++)
+			{
+				const double radians = pData.mAngle[i] * (M_PI / HALF_CIRCLE);
+				pData.mFloatOut[i] = float(std::sin(radians));
+				pData.mFloatOut2[i] = float(std::cos(radians));
+			}
+			doNotOptimize(pData.mFloatOut);
+			doNotOptimize(pData.mFloatOut2);
+		});
+		pRunner.run("fastmath.acos", "std", COUNT, [&]()
+		{
+			for (size_t i = 0; i < COUNT; i++)
+				pData.mFloatOut[i] = std::acos(pData.mCosine[i]);
+			doNotOptimize(pData.mFloatOut);
+		});
+		pRunner.run("fastmath.atan2", "std", COUNT, [&]()
+		{
+			for (size_t i = 0; i < COUNT; i++)
+				pData.mFloatOut[i] = std::atan2(pData.mCosine[i], pData.mAngle[i]);
+			doNotOptimize(pData.mFloatOut);
+		});
+		pRunner.run("fastmath.rsqrt", "std", COUNT, [&]()
+		{
+			for (size_t i = 0; i < COUNT; i++)
+				pData.mFloatOut[i] = 1 / std::sqrt(pData.mFloat[i]);
+			doNotOptimize(pData.mFloatOut);
+		});
+
+		registerFastMathTier<lm::fastmath::Precision::LOW>(pRunner, pData, "low");
+		registerFastMathTier<lm::fastmath::Precision::MEDIUM>(pRunner, pData, "medium");
+		registerFastMathTier<lm::fastmath::Precision::HIGH>(pRunner, pData, "high");
+
+		pRunner.run("mat4.xRotation", "single", 1, [&]()
+		{
+			doNotOptimize(lm::mat4::xRotation(pData.mAngle[cursor.next()]));
+		});
+		pRunner.run("mat4.xRotation", "medium", 1, [&]()
+		{
+			doNotOptimize(lm::mat4::xRotation<lm::fastmath::Precision::MEDIUM>(pData.mAngle[cursor.next()]));
+		});
+		pRunner.run("mat4.createTransformMatrix", "medium", 1, [&]()
+		{
+			const size_t i = cursor.next();
+			doNotOptimize(lm::mat4::createTransformMatrix<lm::fastmath::Precision::MEDIUM>(pData.mPosition[i], pData.mRotation[i], pData.mScale[i]));
+		});
+	}
+
+	// build, full refit and queries on random boxes at a constant density, the scene grows with the count
+	void registerBVH(Runner& pRunner)
+	{
+		constexpr size_t RAYS = 1024;
+		const std::pair<size_t, const char*> sizes[] = { { 10000, "10k" }, { 100000, "100k" }, { 1000000, "1M" } };
+
+		for (const std::pair<size_t, const char*>& size : sizes)
+		{
+			const size_t count = size.first;
+			const float side = 10.f * std::cbrt(float(count));
+
+			std::mt19937 generator(42);
+			std::uniform_real_distribution<float> unit(-0.5f, 0.5f);
+			std::uniform_real_distribution<float> extent(0.25f, 1.f);
+
+			std::vector<uint32_t> ids(count);
+			std::vector<lm::aabb> boxes(count);
+			std::vector<lm::aabb> moved(count);
+			for (size_t i = 0; i < count; i++)
+			{
+				const lm::vec3 center(unit(generator) * side, unit(generator) * side, unit(generator) * side);
+				ids[i] = uint32_t(i);
+				boxes[i] = lm::aabb::fromCenterExtents(center, lm::vec3(extent(generator), extent(generator), extent(generator)));
+				moved[i] = lm::aabb(boxes[i].min + lm::vec3(0.5f, 0, 0), boxes[i].max + lm::vec3(0.5f, 0, 0));
+			}
+
+			std::vector<lm::ray> rays;
+			std::vector<lm::aabb> regions;
+			for (size_t i = 0; i < RAYS; i++)
+			{
+				const lm::vec3 origin(unit(generator) * side, unit(generator) * side, unit(generator) * side);
+				rays.push_back(lm::ray(origin, lm::vec3(unit(generator), unit(generator), unit(generator)).normalized()));
+				regions.push_back(lm::aabb::fromCenterExtents(origin, lm::vec3(5)));
+			}
+
+			// from a corner towards the center, a small part of the scene is visible
+			const lm::mat4 view = lm::mat4::lookAt(lm::vec3(side * 0.5f), lm::vec3(0), lm::vec3::up);
+			const lm::frustum frustum = lm::frustum::fromMatrix(lm::mat4::perspectiveProjection(60, 16.f / 9.f, 0.1f, side * 0.5f) * view);
+
+			lm::bvh tree;
+			pRunner.run("bvh.build", size.second, count, [&]()
+			{
+				tree.build(ids.data(), boxes.data(), count);
+				doNotOptimize(tree);
+			});
+
+			tree.build(ids.data(), boxes.data(), count);
+			bool flip = false;
+			pRunner.run("bvh.refit", size.second, count, [&]()
+			{
+				flip = !flip;
+				tree.update(ids.data(), flip ? moved.data() : boxes.data(), count);
+				doNotOptimize(tree);
+			});
+
+			tree.build(ids.data(), boxes.data(), count);
+			std::vector<uint32_t> visible;
+			pRunner.run("bvh.query.frustum", size.second, 1, [&]()
+			{
+				visible.clear();
+				tree.query(frustum, visible);
+				doNotOptimize(visible);
+			});
+
+			std::vector<uint32_t> results;
+			std::vector<uint32_t> offsets;
+			pRunner.run("bvh.query.aabb", size.second, RAYS, [&]()
+			{
+				tree.query(regions.data(), RAYS, results, offsets);
+				doNotOptimize(results);
+			});
+
+			std::vector<uint32_t> hits(RAYS);
+			std::vector<float> distances(RAYS);
+			pRunner.run("bvh.raycast", size.second, RAYS, [&]()
+			{
+				tree.raycast(rays.data(), RAYS, side, hits.data(), distances.data());
+				doNotOptimize(hits);
+			});
+		}
+	}
+
+	// stands in for a GameObject, the Renderer cannot be built here without Vulkan
+	struct Churn
+	{
+		unsigned char mData[256];
+	};
+
+	// 1M objects spawned and then destroyed in a random order, one op is one spawn and its destroy
+	void registerPool(Runner& pRunner)
+	{
+		constexpr size_t OBJECTS = 1000000;
+
+		std::vector<Churn*> objects(OBJECTS);
+		std::vector<size_t> order(OBJECTS);
+		for (size_t i = 0; i < OBJECTS; i++)
+			order[i] = i;
+		std::shuffle(order.begin(), order.end(), std::mt19937(42));
+
+		pRunner.run("spawn.destroy", "new", OBJECTS, [&]()
+		{
+			for (size_t i = 0; i < OBJECTS; i++)
+				objects[i] = new Churn();
+			doNotOptimize(objects);
+			for (size_t i = 0; i < OBJECTS; i++)
+				delete objects[order[i]];
+		});
+
+		Renderer::Pool<Churn> pool(4096);
+		pRunner.run("spawn.destroy", "pool", OBJECTS, [&]()
+		{
+			for (size_t i = 0; i < OBJECTS; i++)
+				objects[i] = pool.create();
+			doNotOptimize(objects);
+			for (size_t i = 0; i < OBJECTS; i++)
+				Renderer::Pool<Churn>::destroy(objects[order[i]]);
+		});
+
+		// a scene pool dropped by Scene::clear, the slabs go back in bulk
+		pRunner.run("spawn.destroy", "arena", OBJECTS, [&]()
+		{
+			Renderer::Pool<Churn> arena(4096);
+			for (size_t i = 0; i < OBJECTS; i++)
+				objects[i] = arena.create();
+			doNotOptimize(objects);
+			arena.release();
+		});
+	}
+
+	// a frame's worth of short lived lists, the arena is reset the way beginDraw resets it
+	void registerFrameArena(Runner& pRunner)
+	{
+		constexpr size_t LISTS = 4096;
+		constexpr size_t ITEMS = 48;
+
+		pRunner.run("frame.transient", "heap", LISTS, [&]()
+		{
+			for (size_t i = 0; i < LISTS; i++)
+			{
+				std::vector<lm::vec3> list;
+				for (size_t j = 0; j < ITEMS; j++)
+					list.emplace_back(float(j), float(i), 0.f);
+				doNotOptimize(list);
+			}
+		});
+
+		Renderer::LinearArena arena;
+		pRunner.run("frame.transient", "arena", LISTS, [&]()
+		{
+			arena.reset();
+			for (size_t i = 0; i < LISTS; i++)
+			{
+				Renderer::FrameVector<lm::vec3> list { Renderer::ArenaAllocator<lm::vec3>(arena) };
+				for (size_t j = 0; j < ITEMS; j++)
+					list.emplace_back(float(j), float(i), 0.f);
+				doNotOptimize(list);
+			}
+		});
+	}
+
+	// a unit sphere of pRings * pSegments * 2 triangles, in strips around it like a mesh file keeps them
+	std::vector<lm::vec3> sphereTriangles(int pRings, int pSegments)
+	{
+		const auto point = [pRings, pSegments](int pRing, int pSegment)
+		{
+			const float theta = float(M_PI) * pRing / pRings;
+			const float phi = 2.f * float(M_PI) * pSegment / pSegments;
+			return lm::vec3(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi));
+		};
+
+		std::vector<lm::vec3> triangles;
+		for (int ring = 0; ring < pRings; ring++)
+		{
+			for (int segment = 0; segment < pSegments; segment++)
+			{
+				const lm::vec3 a = point(ring, segment), b = point(ring + 1, segment);
+				const lm::vec3 c = point(ring + 1, segment + 1), d = point(ring, segment + 1);
+				triangles.insert(triangles.end(), { a, b, c, a, c, d });
+			}
+		}
+		return triangles;
+	}
+
+	// picking rays: one op is one ray. ray.triangles tests every triangle of a mesh, ray.scene is the
+	// BVH broadphase over 10k copies of the mesh and then their triangles, what Renderer::raycast does
+	void registerRaycast(Runner& pRunner)
+	{
+		constexpr size_t RAYS = 1024;
+		constexpr size_t OBJECTS = 10000;
+
+		const std::vector<lm::vec3> triangles = sphereTriangles(16, 32);
+		const size_t count = triangles.size() / 3;
+		Renderer::CollisionMesh mesh;
+		for (size_t i = 0; i < count; i++)
+			mesh.add(triangles[3 * i], triangles[3 * i + 1], triangles[3 * i + 2]);
+
+		std::mt19937 generator(7);
+		std::uniform_real_distribution<float> unit(-0.5f, 0.5f);
+
+		// from around the sphere towards it, most rays hit
+		std::vector<lm::ray> local;
+		for (size_t i = 0; i < RAYS; i++)
+		{
+			const lm::vec3 origin = lm::vec3(unit(generator), unit(generator), unit(generator)).normalized() * 4.f;
+			local.push_back(lm::ray::fromPoints(origin, lm::vec3(unit(generator), unit(generator), unit(generator))));
+		}
+
+		std::vector<size_t> nearest(RAYS);
+		pRunner.run("ray.triangles", "scalar", RAYS, [&]()
+		{
+			for (size_t r = 0; r < RAYS; r++)
+			{
+				float maxDistance = 100.f;
+				nearest[r] = count;
+				for (size_t i = 0; i < count; i++)
+				{
+					if (local[r].intersects(triangles[3 * i], triangles[3 * i + 1], triangles[3 * i + 2], maxDistance, maxDistance))
+						nearest[r] = i;
+				}
+			}
+			doNotOptimize(nearest);
+		});
+
+		pRunner.run("ray.triangles", "clusters", RAYS, [&]()
+		{
+			for (size_t r = 0; r < RAYS; r++)
+			{
+				float maxDistance = 100.f;
+				nearest[r] = mesh.raycast(local[r], maxDistance);
+			}
+			doNotOptimize(nearest);
+		});
+
+		const float side = 10.f * std::cbrt(float(OBJECTS));
+		std::vector<uint32_t> ids(OBJECTS);
+		std::vector<lm::vec3> positions(OBJECTS);
+		std::vector<lm::aabb> boxes(OBJECTS);
+		for (size_t i = 0; i < OBJECTS; i++)
+		{
+			ids[i] = uint32_t(i);
+			positions[i] = lm::vec3(unit(generator) * side, unit(generator) * side, unit(generator) * side);
+			boxes[i] = lm::aabb::fromCenterExtents(positions[i], lm::vec3(1));
+		}
+
+		lm::bvh tree;
+		tree.build(ids.data(), boxes.data(), OBJECTS);
+
+		std::vector<lm::ray> rays;
+		for (size_t i = 0; i < RAYS; i++)
+		{
+			const lm::vec3 origin(unit(generator) * side, unit(generator) * side, unit(generator) * side);
+			rays.push_back(lm::ray(origin, lm::vec3(unit(generator), unit(generator), unit(generator)).normalized()));
+		}
+
+		std::vector<uint32_t> hits(RAYS);
+		pRunner.run("ray.scene", "bvh+clusters", RAYS, [&]()
+		{
+			for (size_t r = 0; r < RAYS; r++)
+			{
+				float maxDistance = side;
+				hits[r] = lm::bvh::invalid;
+				tree.raycast(rays[r], maxDistance, [&](const uint32_t pId, const float)
+				{
+					// the objects are only moved, the ray goes to model space by the opposite translation
+					const lm::ray ray(rays[r].origin - positions[pId], rays[r].direction);
+					if (mesh.raycast(ray, maxDistance) != mesh.size())
+						hits[r] = pId;
+					return maxDistance;
+				});
+			}
+			doNotOptimize(hits);
+		});
+	}
+
+	// the bounds of one tier in the table on lm::fastmath::Precision
+	struct TierBounds
+	{
+		double mSinCos;
+		double mAcos;
+		double mAtan2;
+		double mRsqrt;
+	};
+
+	template <lm::fastmath::Precision P> void measureTier(AccuracyReport& pReport, const std::string& pPrecision, const TierBounds& pBounds)
+	{
+		constexpr size_t SAMPLES = 1 << 20;
+		std::vector<float> input(SAMPLES);
+		std::vector<float> input2(SAMPLES);
+		std::vector<float> value(SAMPLES);
+		std::vector<float> value2(SAMPLES);
+		std::vector<double> reference(SAMPLES);
+		std::vector<double> reference2(SAMPLES);
+
+		// sin and cos reported separately, radians over a few hundred turns
+		for (size_t i = 0; i < SAMPLES; i++)
+			input[i] = -1000.f + 2000.f * float(i) / SAMPLES;
+		lm::fastmath::sincos<P>(input.data(), value.data(), value2.data(), SAMPLES);
+		for (size_t i = 0; i < SAMPLES; i++)
+		{
+			reference[i] = std::sin(double(input[i]));
+			reference2[i] = std::cos(double(input[i]));
+		}
+		pReport.add("sincos.sin", pPrecision, input, value, reference, false, pBounds.mSinCos);
+		pReport.add("sincos.cos", pPrecision, input, value2, reference2, false, pBounds.mSinCos);
+
+		for (size_t i = 0; i < SAMPLES; i++)
+			input[i] = -720.f + 1440.f * float(i) / SAMPLES;
+		lm::fastmath::sincosDeg<P>(input.data(), value.data(), value2.data(), SAMPLES);
+		for (size_t i = 0; i < SAMPLES; i++)
+		{
+			reference[i] = std::sin(double(input[i]) * (M_PI / 180));
+			reference2[i] = std::cos(double(input[i]) * (M_PI / 180));
+		}
+		pReport.add("sincosDeg.sin", pPrecision, input, value, reference, false, pBounds.mSinCos);
+		pReport.add("sincosDeg.cos", pPrecision, input, value2, reference2, false, pBounds.mSinCos);
+
+		for (size_t i = 0; i < SAMPLES; i++)
+		{
+			input[i] = -1.f + 2.f * float(i) / (SAMPLES - 1);
+			reference[i] = std::acos(double(input[i]));
+		}
+		lm::fastmath::acos<P>(input.data(), value.data(), SAMPLES);
+		pReport.add("acos", pPrecision, input, value, reference, false, pBounds.mAcos);
+
+		// points on circles of growing radius, the reported input is the angle in radians
+		std::vector<float> angle(SAMPLES);
+		for (size_t i = 0; i < SAMPLES; i++)
+		{
+			const double theta = 2 * M_PI * double(i) / SAMPLES;
+			const double radius = 0.01 + 10.0 * double(i % 977) / 977;
+			angle[i] = float(theta);
+			input[i] = float(radius * std::sin(theta));
+			input2[i] = float(radius * std::cos(theta));
+			reference[i] = std::atan2(double(input[i]), double(input2[i]));
+		}
+		lm::fastmath::atan2<P>(input.data(), input2.data(), value.data(), SAMPLES);
+		pReport.add("atan2", pPrecision, angle, value, reference, false, pBounds.mAtan2);
+
+		// every mantissa bucket between 2^-20 and 2^20, relative error
+		for (size_t i = 0; i < SAMPLES; i++)
+		{
+			input[i] = std::ldexp(1.f + float(i % 4096) / 4096, int(i / 4096 % 40) - 20);
+			reference[i] = 1 / std::sqrt(double(input[i]));
+		}
+		lm::fastmath::rsqrt<P>(input.data(), value.data(), SAMPLES);
+		pReport.add("rsqrt", pPrecision, input, value, reference, true, pBounds.mRsqrt);
+	}
+
+	// angle of the rotation taking one quaternion to the other, q and -q being the same rotation
+	double rotationAngle(const lm::quat& pA, const lm::quat& pB)
+	{
+		double dot = 0;
+		for (int k = 0; k < 4; k++)
+			dot += double(pA.data()[k]) * double(pB.data()[k]);
+
+		double difference = 0;
+		double sum = 0;
+		for (int k = 0; k < 4; k++)
+		{
+			const double b = dot < 0 ? -double(pB.data()[k]) : double(pB.data()[k]);
+			difference += (double(pA.data()[k]) - b) * (double(pA.data()[k]) - b);
+			sum += (double(pA.data()[k]) + b) * (double(pA.data()[k]) + b);
+		}
+		return 4 * std::atan2(std::sqrt(difference), std::sqrt(sum));
+	}
+
+	// lm::batch::interpolate on whole SSE/AVX2 registers against Quat::slerp, as the angle between the two
+	// rotations; the reported input is the angle between the interpolated ones. The bounds are the ones
+	// documented on the batch kernels, Quat::nlerp and Quat::correctedNlerp: twice the measured worst case
+	// for slerp (4.4e-7) and corrected nlerp (7.7e-4), the analytic 0.1422 plus 5% for plain nlerp
+	void measureQuatInterpolation(AccuracyReport& pReport)
+	{
+		constexpr size_t SAMPLES = 1 << 18;
+		std::mt19937 generator(7);
+		std::normal_distribution<float> normal;
+		std::uniform_real_distribution<float> unit(0.f, 1.f);
+
+		std::vector<lm::quat> a(SAMPLES), b(SAMPLES), out(SAMPLES);
+		std::vector<float> t(SAMPLES), input(SAMPLES), value(SAMPLES);
+		std::vector<double> reference(SAMPLES, 0);
+		for (size_t i = 0; i < SAMPLES; i++)
+		{
+			a[i] = lm::quat(normal(generator), lm::vec3(normal(generator), normal(generator), normal(generator))).normalized();
+			b[i] = lm::quat(normal(generator), lm::vec3(normal(generator), normal(generator), normal(generator))).normalized();
+			t[i] = unit(generator);
+			input[i] = float(rotationAngle(a[i], b[i]));
+		}
+
+		const std::pair<lm::QuatInterpolation, const char*> modes[] = {
+			{ lm::QuatInterpolation::SLERP, "slerp" },
+			{ lm::QuatInterpolation::NLERP, "nlerp" },
+			{ lm::QuatInterpolation::CORRECTED_NLERP, "corrected" } };
+		const double bounds[] = { 1e-6, 0.15, 1.6e-3 };
+		for (size_t mode = 0; mode < 3; mode++)
+		{
+			lm::batch::interpolate(a.data(), b.data(), t.data(), out.data(), SAMPLES, modes[mode].first);
+			for (size_t i = 0; i < SAMPLES; i++)
+				value[i] = float(rotationAngle(out[i], lm::quat::slerp(a[i], b[i], t[i])));
+			pReport.add("batch.interpolate", modes[mode].second, input, value, reference, false, bounds[mode]);
+		}
+	}
+
+	void measureFastMath(AccuracyReport& pReport)
+	{
+#if defined(LM_SIMD_SSE)
+		measureTier<lm::fastmath::Precision::LOW>(pReport, "low", { 4.0e-4, 4.0e-3, 2.0e-3, 4.0e-4 });
+		measureTier<lm::fastmath::Precision::MEDIUM>(pReport, "medium", { 4.5e-6, 8.5e-5, 1.5e-5, 3.0e-7 });
+#else
+		measureTier<lm::fastmath::Precision::LOW>(pReport, "low", { 4.0e-4, 4.0e-3, 2.0e-3, 2.2e-3 });
+		measureTier<lm::fastmath::Precision::MEDIUM>(pReport, "medium", { 4.5e-6, 8.5e-5, 1.5e-5, 6.0e-6 });
+#endif
+		measureTier<lm::fastmath::Precision::HIGH>(pReport, "high", { 1.1e-7, 5.0e-7, 3.5e-7, 1.1e-7 });
+	}
+
+	void printUsage()
+	{
+		std::cout << "MathBench [--format table|csv|json] [--output file] [--filter text] [--min-time ms] [--samples n] [--accuracy] [--parity]\n"
+			<< "  --format    output format, table by default\n"
+			<< "  --output    write the results to a file instead of stdout\n"
+			<< "  --filter    only run benchmarks whose name/form contains the text\n"
+			<< "  --min-time  minimum duration of one sample in milliseconds, 100 by default\n"
+			<< "  --samples   samples per benchmark, the fastest one is reported, 5 by default\n"
+			<< "  --accuracy  report the error of the fastmath functions and the batched quaternion interpolation instead of timings, fails past the documented bounds\n"
+			<< "  --parity    compare the SIMD kernels to the scalar ones and the BVH queries to brute force, fails past the stated bounds\n";
+	}
+}
+
+int main(int argc, char** argv)
+{
+	std::string format = "table";
+	std::string output;
+	std::string filter;
+	double minTimeMs = 100;
+	unsigned int samples = 5;
+	bool accuracy = false;
+	bool parity = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const bool hasValue = i + 1 < argc;
+		if (std::strcmp(argv[i], "--format") == 0 && hasValue)
+			format = argv[++i];
+		else if (std::strcmp(argv[i], "--output") == 0 && hasValue)
+			output = argv[++i];
+		else if (std::strcmp(argv[i], "--filter") == 0 && hasValue)
+			filter = argv[++i];
+		else if (std::strcmp(argv[i], "--min-time") == 0 && hasValue)
+			minTimeMs = std::atof(argv[++i]);
+		else if (std::strcmp(argv[i], "--samples") == 0 && hasValue)
+			samples = unsigned(std::atoi(argv[++i]));
+		else if (std::strcmp(argv[i], "--accuracy") == 0)
+			accuracy = true;
+		else if (std::strcmp(argv[i], "--parity") == 0)
+			parity = true;
+		else
+		{
+			printUsage();
+			return std::strcmp(argv[i], "--help") == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+		}
+	}
+
+	if (format != "table" && format != "csv" && format != "json")
+	{
+		printUsage();
+		return EXIT_FAILURE;
+	}
+
+	std::ofstream file;
+	if (!output.empty())
+	{
+		file.open(output);
+		if (!file.is_open())
+		{
+			std::cerr << "cannot open " << output << '\n';
+			return EXIT_FAILURE;
+		}
+	}
+
+	std::ostream& stream = output.empty() ? std::cout : file;
+	if (accuracy || parity)
+	{
+		AccuracyReport report;
+		if (accuracy)
+		{
+			measureFastMath(report);
+			measureQuatInterpolation(report);
+		}
+		if (parity)
+		{
+			measureSimdParity(report);
+			measureBvhParity(report);
+		}
+
+		if (format == "csv")
+			report.writeCsv(stream);
+		else if (format == "json")
+			report.writeJson(stream, backend());
+		else
+			report.writeTable(stream);
+
+		return report.passed() ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	Data data;
+	Runner runner(minTimeMs, samples, filter);
+
+	registerMatrix(runner, data);
+	registerTransform(runner, data);
+	registerQuat(runner, data);
+	registerVector(runner, data);
+	registerBounds(runner, data);
+	registerExpr(runner, data);
+	registerFastMath(runner, data);
+	registerBVH(runner);
+	registerPool(runner);
+	registerFrameArena(runner);
+	registerRaycast(runner);
+
+	if (format == "csv")
+		runner.writeCsv(stream);
+	else if (format == "json")
+		runner.writeJson(stream, backend());
+	else
+		runner.writeTable(stream);
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,306 @@
+#include "Parity.h"
+#include "Mat4/Mat4.h"
+#include "BVH/BVH.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <iterator>
+#include <random>
+#include <utility>
+
+using namespace MathBench;
+
+namespace
+{
+	constexpr size_t MATRICES = 10000;
+	constexpr size_t BOXES = 4000;
+	constexpr size_t ROUNDS = 40;
+	constexpr size_t QUERIES = 16;
+
+	// a few roundings apart: FMA in the AVX2 kernels rounds once where the loops round twice, and the
+	// intrinsic inverse is a 2x2 block decomposition where Mat4's is a cofactor expansion
+	constexpr double BOUND = 8 * FLT_EPSILON;
+
+	// each element reports |value - reference| / pScale, the size the roundings of the kernel are
+	// relative to, so one bound holds whatever the inputs
+	struct Comparison
+	{
+		std::vector<float> mInputs;
+		std::vector<float> mErrors;
+		std::vector<double> mZeros;
+
+		void add(size_t pSample, const float* pValue, const float* pReference, size_t pCount, double pScale)
+		{
+			for (size_t i = 0; i < pCount; i++)
+			{
+				mInputs.push_back(float(pSample));
+				mErrors.push_back(float(std::abs(double(pValue[i]) - double(pReference[i])) / pScale));
+				mZeros.push_back(0);
+			}
+		}
+
+		void report(AccuracyReport& pReport, const std::string& pName, const std::string& pForm, double pBound) const
+		{
+			pReport.add(pName, pForm, mInputs, mErrors, mZeros, false, pBound);
+		}
+	};
+
+	// Gauss-Jordan with partial pivoting in double, column major like lm::mat4
+	bool inverse(const float* pMatrix, double* pOut)
+	{
+		double rows[4][8];
+		for (int r = 0; r < 4; r++)
+		{
+			for (int c = 0; c < 4; c++)
+			{
+				rows[r][c] = pMatrix[4 * c + r];
+				rows[r][4 + c] = r == c ? 1 : 0;
+			}
+		}
+
+		for (int c = 0; c < 4; c++)
+		{
+			int pivot = c;
+			for (int r = c + 1; r < 4; r++)
+				if (std::abs(rows[r][c]) > std::abs(rows[pivot][c]))
+					pivot = r;
+			if (rows[pivot][c] == 0)
+				return false;
+			std::swap(rows[pivot], rows[c]);
+
+			const double divisor = rows[c][c];
+			for (int k = 0; k < 8; k++)
+				rows[c][k] /= divisor;
+			for (int r = 0; r < 4; r++)
+			{
+				const double factor = rows[r][c];
+				if (r != c)
+					for (int k = 0; k < 8; k++)
+						rows[r][k] -= factor * rows[c][k];
+			}
+		}
+
+		for (int r = 0; r < 4; r++)
+			for (int c = 0; c < 4; c++)
+				pOut[4 * c + r] = rows[r][4 + c];
+		return true;
+	}
+
+	template <typename T> double largest(const T* pValues, size_t pCount)
+	{
+		double value = 0;
+		for (size_t i = 0; i < pCount; i++)
+			value = std::max(value, std::abs(double(pValues[i])));
+		return value;
+	}
+
+	template <typename T> double infinityNorm(const T* pMatrix)
+	{
+		double norm = 0;
+		for (int r = 0; r < 4; r++)
+		{
+			double sum = 0;
+			for (int c = 0; c < 4; c++)
+				sum += std::abs(double(pMatrix[4 * c + r]));
+			norm = std::max(norm, sum);
+		}
+		return norm;
+	}
+
+	// entries in [-1, 1] around a scaled identity, a well conditioned matrix
+	lm::mat4 randomMatrix(std::mt19937& pGenerator)
+	{
+		std::uniform_real_distribution<float> unit(-1.f, 1.f);
+		lm::mat4 matrix;
+		for (int i = 0; i < 16; i++)
+			matrix.data()[i] = unit(pGenerator) + (i % 5 == 0 ? 3.f : 0.f);
+		return matrix;
+	}
+
+	// the last column nearly a combination of the others, condition numbers up to around 1e9
+	lm::mat4 nearSingularMatrix(std::mt19937& pGenerator)
+	{
+		std::uniform_real_distribution<float> unit(-1.f, 1.f);
+		lm::mat4 matrix = randomMatrix(pGenerator);
+		const float a = unit(pGenerator), b = unit(pGenerator);
+		for (int j = 0; j < 4; j++)
+			matrix.data()[12 + j] = a * matrix.data()[j] + b * matrix.data()[4 + j] + 1e-4f * unit(pGenerator);
+		return matrix;
+	}
+
+	void measureForm(AccuracyReport& pReport, const std::string& pForm, lm::mat4 (*pMatrix)(std::mt19937&))
+	{
+		std::mt19937 generator(11);
+		std::uniform_real_distribution<float> unit(-10.f, 10.f);
+
+		Comparison multiply, transform, transpose, inverse;
+		for (size_t sample = 0; sample < MATRICES; sample++)
+		{
+			const lm::mat4 a = pMatrix(generator);
+			const lm::mat4 b = pMatrix(generator);
+			const lm::vec4 v(unit(generator), unit(generator), unit(generator), unit(generator));
+
+			// a sum of products is rounded relative to the sum of their magnitudes, not to the result,
+			// which cancels out on near singular inputs
+			const double norm = infinityNorm(a.data());
+
+			lm::mat4 value = a * b;
+			lm::mat4 reference = lm::mat4::scalarMultiply(a, b);
+			multiply.add(sample, value.data(), reference.data(), 16, norm * largest(b.data(), 16));
+
+			const lm::vec4 vectorValue = a * v;
+			const lm::vec4 vectorReference = lm::mat4::scalarTransform(a, v);
+			transform.add(sample, vectorValue.data(), vectorReference.data(), 4, norm * largest(v.data(), 4));
+
+			value = lm::mat4(a).transpose();
+			reference = lm::mat4::scalarTranspose(a);
+			transpose.add(sample, value.data(), reference.data(), 16, 1);
+
+			// two float inverses of an ill conditioned matrix drift apart in proportion to its condition
+			// number, the one of the double inverse
+			double exact[16];
+			if (!::inverse(a.data(), exact))
+				continue;
+
+			const double conditioning = norm * infinityNorm(exact);
+			value = lm::mat4(a).inverse();
+			reference = lm::mat4::scalarInverse(a);
+			inverse.add(sample, value.data(), reference.data(), 16, largest(exact, 16) * conditioning);
+		}
+
+		multiply.report(pReport, "mat4.multiply", pForm, BOUND);
+		transform.report(pReport, "mat4 * vec4", pForm, BOUND);
+		transpose.report(pReport, "mat4.transpose", pForm, 0);
+		inverse.report(pReport, "mat4.inverse / cond", pForm, BOUND);
+	}
+
+	lm::aabb randomBox(std::mt19937& pGenerator)
+	{
+		std::uniform_real_distribution<float> position(-100.f, 100.f);
+		std::uniform_real_distribution<float> size(0.1f, 4.f);
+		const lm::vec3 min(position(pGenerator), position(pGenerator), position(pGenerator));
+		return lm::aabb(min, min + lm::vec3(size(pGenerator), size(pGenerator), size(pGenerator)));
+	}
+
+	// ids the tree reports and brute force does not, or the other way around
+	float mismatches(std::vector<uint32_t> pFound, std::vector<uint32_t> pExpected)
+	{
+		std::sort(pFound.begin(), pFound.end());
+		std::sort(pExpected.begin(), pExpected.end());
+		std::vector<uint32_t> difference;
+		std::set_symmetric_difference(pFound.begin(), pFound.end(), pExpected.begin(), pExpected.end(), std::back_inserter(difference));
+		return float(difference.size());
+	}
+}
+
+void MathBench::measureSimdParity(AccuracyReport& pReport)
+{
+	measureForm(pReport, "random", randomMatrix);
+	measureForm(pReport, "near-sing", nearSingularMatrix);
+}
+
+void MathBench::measureBvhParity(AccuracyReport& pReport)
+{
+	std::mt19937 generator(13);
+	std::uniform_real_distribution<float> unit(-1.f, 1.f);
+	std::uniform_real_distribution<float> position(-100.f, 100.f);
+
+	std::vector<lm::aabb> boxes(BOXES);
+	std::vector<bool> present(BOXES, false);
+	std::vector<uint32_t> ids;
+	for (uint32_t id = 0; id < BOXES / 2; id++)
+	{
+		boxes[id] = randomBox(generator);
+		present[id] = true;
+		ids.push_back(id);
+	}
+
+	lm::bvh tree;
+	tree.build(ids.data(), boxes.data(), ids.size());
+
+	std::vector<float> inputs[3];
+	std::vector<float> errors[3];
+	std::vector<double> zeros[3];
+	for (size_t round = 0; round < ROUNDS; round++)
+	{
+		// inserts then removes, a batch moving most of the tree at once and one small enough to walk up
+		// from each leaf; after a rebuild the inserts append to an ordered tree and the removes keep it so
+		if (round % 4 == 0)
+			tree.rebuild();
+
+		for (const bool insert : { true, false })
+		{
+			for (size_t i = 0; i < BOXES / 16; i++)
+			{
+				const uint32_t id = uint32_t(generator() % BOXES);
+				if (present[id] == insert)
+					continue;
+
+				if (insert)
+				{
+					boxes[id] = randomBox(generator);
+					tree.insert(id, boxes[id]);
+				}
+				else
+					tree.remove(id);
+				present[id] = insert;
+			}
+		}
+
+		for (const size_t fraction : { size_t(2), size_t(64) })
+		{
+			ids.clear();
+			for (uint32_t id = 0; id < BOXES; id++)
+				if (present[id] && generator() % fraction == 0)
+					ids.push_back(id);
+
+			std::vector<lm::aabb> moved;
+			for (const uint32_t id : ids)
+			{
+				boxes[id] = randomBox(generator);
+				moved.push_back(boxes[id]);
+			}
+			tree.update(ids.data(), moved.data(), ids.size());
+		}
+
+		for (size_t query = 0; query < QUERIES; query++)
+		{
+			const size_t sample = round * QUERIES + query;
+			const lm::vec3 center(position(generator), position(generator), position(generator));
+			const lm::aabb area(center - lm::vec3(20.f, 20.f, 20.f), center + lm::vec3(20.f, 20.f, 20.f));
+			const lm::vec3 eye(position(generator), position(generator), position(generator));
+			const lm::frustum frustum = lm::frustum::fromMatrix(lm::mat4::perspectiveProjection(60.f, 1.5f, 0.5f, 80.f) * lm::mat4::lookAt(eye, lm::vec3(), lm::vec3(0.f, 1.f, 0.f)));
+			const lm::ray ray(eye, lm::vec3(unit(generator), unit(generator), unit(generator)).normalized());
+
+			std::vector<uint32_t> found[3], expected[3];
+			tree.query(area, [&found](const uint32_t pId) { found[0].push_back(pId); });
+			tree.query(frustum, [&found](const uint32_t pId) { found[1].push_back(pId); });
+			tree.raycast(ray, 1000.f, [&found](const uint32_t pId, const float) { found[2].push_back(pId); return 1000.f; });
+
+			for (uint32_t id = 0; id < BOXES; id++)
+			{
+				if (!present[id])
+					continue;
+
+				float distance;
+				if (area.intersects(boxes[id]))
+					expected[0].push_back(id);
+				if (frustum.intersects(boxes[id]))
+					expected[1].push_back(id);
+				if (ray.intersects(boxes[id], distance, 1000.f))
+					expected[2].push_back(id);
+			}
+
+			for (int kind = 0; kind < 3; kind++)
+			{
+				inputs[kind].push_back(float(sample));
+				errors[kind].push_back(mismatches(found[kind], expected[kind]));
+				zeros[kind].push_back(0);
+			}
+		}
+	}
+
+	pReport.add("bvh.query aabb", "mixed", inputs[0], errors[0], zeros[0], false, 0);
+	pReport.add("bvh.query frustum", "mixed", inputs[1], errors[1], zeros[1], false, 0);
+	pReport.add("bvh.raycast", "mixed", inputs[2], errors[2], zeros[2], false, 0);
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include "Animation.h"
+#include "Pool.h"
 
 #define MAX_BONE 100
 
@@ -11,10 +12,25 @@ namespace Renderer
             std::vector<lm::mat4> mFinalBoneMatrices;
             Animation* mCurrentAnimation = nullptr;
             float mCurrentTime = 0;
+            lm::QuatInterpolation mInterpolation = lm::QuatInterpolation::SLERP;
+
+            // rotation keys of every bone, interpolated in one batch per update
+            std::vector<lm::quat> mRotationFrom;
+            std::vector<lm::quat> mRotationTo;
+            std::vector<float> mRotationFactors;
+            std::vector<lm::quat> mRotations;
+
+            // local matrix of every bone, kept here rather than in the shared Animation so that
+            // the objects playing it can be updated on several threads
+            std::vector<lm::mat4> mBoneTransforms;
 
             Animator(Animation* pAnimation);
 
+            static void* operator new(size_t pSize);
+            static void operator delete(void* pObject);
+
             void updateAnimation(float pDeltaTime);
+            void updateBones();
             void Animator::calculateBoneTransform(const AssimpNodeData* pNode, lm::mat4 pParentTransform);
     };
 }
\ No newline at end of file
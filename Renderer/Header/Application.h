@@ -1,5 +1,6 @@
 #include "GameObject.h"
 #include "Scene.h"
+#include "WorldStreamer.h"
 
 namespace Renderer
 {
@@ -17,11 +18,23 @@ namespace Renderer
 			VKRenderer mRenderer;
 			ResourceManager mResources;
 			Camera mCamera;
+			// looks down on the scene from above, drawn in a corner over mCamera
+			Camera mOverview;
 			Scene<GameObject> mScene;
 			Shader** mLightShader = nullptr;
+			SlotHandle mDemoRoot;
+			// the prefab placed in the streamer's cells outlives it
+			Prefab mStreamedRoom;
+			WorldStreamer mStreamer;
+			// where the last pick() hit, marked with a cross by the debug lines
+			lm::vec3 mPickedPoint;
+			bool mPicked = false;
 
 			Application(const char* pTitle, const unsigned int& pWidth, const unsigned int& pHeight);
 			void keyCallback(int pKey, int pScancode, int pAction, int pMods);
+			void mouseButton(int pButton, int pAction, int pMods);
+			// the object under the crosshair, the cursor is captured by the camera
+			void pick();
 			void Application::processInput(const float& pDeltaTime);
 			void initScene();
 			void run();
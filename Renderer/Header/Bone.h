@@ -1,7 +1,7 @@
 #pragma once
 #include <assimp/anim.h>
 #include <vector>
-#include "Quat/Quat.h"
+#include "Transform/Transform.h"
 
 namespace Renderer
 {
@@ -46,15 +46,18 @@ namespace Renderer
         Bone(const std::string& pName, int pId, const aiNodeAnim* pChannel);
 
         void update(float pAnimationTime);
+        void update(float pAnimationTime, const lm::quat& pRotation);
+        lm::mat4 getLocalTransform(float pAnimationTime, const lm::quat& pRotation);
 
         int getPositionIndex(float pAnimationTime);
         int getRotationIndex(float pAnimationTime);
         int getScaleIndex(float pAnimationTime);
         float getScaleFactor(float pLastTimeStamp, float pNextTimeStamp, float pAnimationTime);
 
-        lm::mat4 interpolatePosition(float pAnimationTime);
-        lm::mat4 interpolateRotation(float pAnimationTime);
-        lm::mat4 interpolateScaling(float pAnimationTime);
+        lm::vec3 interpolatePosition(float pAnimationTime);
+        lm::quat interpolateRotation(float pAnimationTime);
+        float getRotationKeys(float pAnimationTime, lm::quat& pFrom, lm::quat& pTo);
+        lm::vec3 interpolateScaling(float pAnimationTime);
 
         lm::vec3 getVec(const aiVector3D& pVec);
         lm::quat getQuat(const aiQuaternion& pOrientation);
@@ -1,5 +1,7 @@
 #pragma once
 #include "Mat4/Mat4.h"
+#include "Frustum/Frustum.h"
+#include "Ray/Ray.h"
 
 namespace Renderer
 {
@@ -38,6 +40,7 @@ namespace Renderer
 			lm::mat4 mView;
 			lm::mat4 mProjection;
 			lm::mat4 mVp;
+			lm::frustum mFrustum;
 			
 			float mSpeed = 20;
 			float mSpeedMultiplier = 3;
@@ -54,5 +57,8 @@ namespace Renderer
 			void updateCameraVectors();
 			void processKeyboard(CameraMovement pDirection, float pDeltaTime);
 			void setMousePosition(float pMouseX, float pMouseY);
+			// from mPosition through the pixel (pX, pY) of a view pWidth by pHeight pixels, top left
+			// first like the cursor; the direction is normalized so ray distances are in world units
+			lm::ray screenRay(float pX, float pY, float pWidth, float pHeight) const;
 	};
 }
\ No newline at end of file
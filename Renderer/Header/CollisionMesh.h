@@ -0,0 +1,73 @@
+#pragma once
+#include <algorithm>
+#include <vector>
+#include "Batch/Batch.h"
+
+namespace Renderer
+{
+	// The triangles of a model in model space for ray casts, each kept as a corner and the two edges
+	// from it with one array per coordinate, the layout lm::batch::intersect reads. The triangles are
+	// grouped in clusters of consecutive ones under a box, the order of the mesh keeps them close, so a
+	// ray only tests the clusters it goes through.
+	class CollisionMesh
+	{
+		public:
+			static constexpr size_t CLUSTER = 64;
+
+			void add(const lm::vec3& pA, const lm::vec3& pB, const lm::vec3& pC)
+			{
+				const lm::vec3 edge1 = pB - pA;
+				const lm::vec3 edge2 = pC - pA;
+				const float values[9] = { pA.X(), pA.Y(), pA.Z(), edge1.X(), edge1.Y(), edge1.Z(), edge2.X(), edge2.Y(), edge2.Z() };
+				for (size_t i = 0; i < 9; i++)
+					mCoordinates[i].push_back(values[i]);
+
+				if (size() % CLUSTER == 1)
+					mClusters.emplace_back();
+				mClusters.back().expand(pA);
+				mClusters.back().expand(pB);
+				mClusters.back().expand(pC);
+			}
+
+			// nearest triangle pRay crosses before pMaxDistance, size() when there is none;
+			// pMaxDistance becomes the distance to it
+			size_t raycast(const lm::ray& pRay, float& pMaxDistance) const
+			{
+				size_t found = size();
+				for (size_t cluster = 0; cluster < mClusters.size(); cluster++)
+				{
+					float enter = 0;
+					if (!pRay.intersects(mClusters[cluster], enter, pMaxDistance))
+						continue;
+
+					const size_t first = cluster * CLUSTER;
+					const size_t count = std::min(CLUSTER, size() - first);
+					const size_t hit = lm::batch::nearest(pRay, pMaxDistance, view(0, first), view(3, first), view(6, first), count);
+					if (hit != count)
+						found = first + hit;
+				}
+
+				return found;
+			}
+
+			size_t size() const
+			{
+				return mCoordinates[0].size();
+			}
+
+			size_t bytes() const
+			{
+				return size() * 9 * sizeof(float) + mClusters.size() * sizeof(lm::aabb);
+			}
+
+		private:
+			// corner x, y, z, then the first edge and the second edge
+			std::vector<float> mCoordinates[9];
+			std::vector<lm::aabb> mClusters;
+
+			lm::batch::Vec3SoA<const float> view(size_t pFirstCoordinate, size_t pFirst) const
+			{
+				return { mCoordinates[pFirstCoordinate].data() + pFirst, mCoordinates[pFirstCoordinate + 1].data() + pFirst, mCoordinates[pFirstCoordinate + 2].data() + pFirst };
+			}
+	};
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include "TransformHierarchy.h"
+#include "AABB/AABB.h"
+
+namespace Renderer
+{
+	class Model;
+	class Shader;
+	class Texture;
+	class UniformBuffer;
+	class Animator;
+
+	// what the render system reads to draw an entity, its uniform block is written into the scene's
+	// DynamicUniformBuffer when it is drawn
+	struct RenderComponent
+	{
+		Model** mModel = nullptr;
+		Shader** mShader = nullptr;
+		Texture** mTexture = nullptr;
+		TransformHierarchy::Handle mTransform = TransformHierarchy::INVALID;
+	};
+
+	// the world box of a drawable entity is an lm::aabb component written by updateBounds,
+	// the boxes are packed on their own so that culling reads nothing else
+
+	// the animator is created once the model is loaded and turns out to be animated,
+	// the bone palette on the first draw after that
+	struct AnimationComponent
+	{
+		Model** mModel = nullptr;
+		Animator* mAnimator = nullptr;
+		UniformBuffer* mBones = nullptr;
+	};
+}
@@ -0,0 +1,259 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Renderer
+{
+	// Bump allocator: allocate moves a cursor through chunks, nothing is freed until reset. When the
+	// data of a frame did not fit in one chunk, reset merges the chunks into one big enough for it,
+	// so after a few frames a frame allocates nothing from the heap.
+	class LinearArena
+	{
+		public:
+			explicit LinearArena(size_t pChunkBytes = 64 * 1024) : mChunkBytes(pChunkBytes)
+			{
+			}
+
+			LinearArena(const LinearArena&) = delete;
+			LinearArena& operator=(const LinearArena&) = delete;
+
+			void* allocate(size_t pBytes, size_t pAlignment = alignof(std::max_align_t))
+			{
+				uintptr_t start = (uintptr_t(mCursor) + pAlignment - 1) & ~uintptr_t(pAlignment - 1);
+				if (mCursor == nullptr || start + pBytes > uintptr_t(mEnd))
+				{
+					grow(pBytes + pAlignment);
+					start = (uintptr_t(mCursor) + pAlignment - 1) & ~uintptr_t(pAlignment - 1);
+				}
+
+				unsigned char* block = reinterpret_cast<unsigned char*>(start);
+				mUsed += block + pBytes - mCursor;
+				mCursor = block + pBytes;
+				return block;
+			}
+
+			// everything allocated so far is gone
+			void reset()
+			{
+				if (mChunks.size() > 1)
+				{
+					const size_t bytes = capacity();
+					mChunks.clear();
+					mChunks.push_back({ std::unique_ptr<unsigned char[]>(new unsigned char[bytes]), bytes });
+				}
+
+				mCursor = mChunks.empty() ? nullptr : mChunks.back().mData.get();
+				mEnd = mChunks.empty() ? nullptr : mCursor + mChunks.back().mSize;
+				mUsed = 0;
+			}
+
+			// bytes handed out since the last reset, alignment padding included
+			size_t used() const
+			{
+				return mUsed;
+			}
+
+			size_t capacity() const
+			{
+				size_t bytes = 0;
+				for (const Chunk& chunk : mChunks)
+					bytes += chunk.mSize;
+				return bytes;
+			}
+
+		private:
+			struct Chunk
+			{
+				std::unique_ptr<unsigned char[]> mData;
+				size_t mSize;
+			};
+
+			std::vector<Chunk> mChunks;
+			unsigned char* mCursor = nullptr;
+			unsigned char* mEnd = nullptr;
+			size_t mUsed = 0;
+			size_t mChunkBytes;
+
+			// the rest of the current chunk is left unused, chunks double so a frame needs few of them
+			void grow(size_t pBytes)
+			{
+				size_t bytes = std::max(mChunkBytes, capacity());
+				while (bytes < pBytes)
+					bytes *= 2;
+
+				mChunks.push_back({ std::unique_ptr<unsigned char[]>(new unsigned char[bytes]), bytes });
+				mCursor = mChunks.back().mData.get();
+				mEnd = mCursor + bytes;
+			}
+	};
+
+	// Lets a standard container take its storage from a LinearArena. deallocate does nothing, the
+	// memory comes back with the arena's reset, so the container must be gone (or never touched
+	// again) by then. The arena moves along with the container's contents on assignment and swap.
+	template <class T> class ArenaAllocator
+	{
+		public:
+			typedef T value_type;
+			typedef std::true_type propagate_on_container_copy_assignment;
+			typedef std::true_type propagate_on_container_move_assignment;
+			typedef std::true_type propagate_on_container_swap;
+
+			LinearArena* mArena;
+
+			explicit ArenaAllocator(LinearArena& pArena) : mArena(&pArena)
+			{
+			}
+
+			template <class U> ArenaAllocator(const ArenaAllocator<U>& pOther) : mArena(pOther.mArena)
+			{
+			}
+
+			T* allocate(size_t pCount)
+			{
+				if (pCount > SIZE_MAX / sizeof(T))
+					throw std::bad_array_new_length();
+				return static_cast<T*>(mArena->allocate(pCount * sizeof(T), alignof(T)));
+			}
+
+			void deallocate(T*, size_t)
+			{
+			}
+
+			template <class U> bool operator==(const ArenaAllocator<U>& pOther) const
+			{
+				return mArena == pOther.mArena;
+			}
+
+			template <class U> bool operator!=(const ArenaAllocator<U>& pOther) const
+			{
+				return mArena != pOther.mArena;
+			}
+	};
+
+	template <class T> using FrameVector = std::vector<T, ArenaAllocator<T>>;
+	typedef std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>> FrameString;
+
+	// One LinearArena per frame in flight and per thread, for data that lives until the frame it was
+	// made for is recorded. beginFrame resets the arenas of the frame about to be recorded and must
+	// not run while another thread allocates; the worker threads allocate from inside the jobs of
+	// a frame (parallelFor), the resource threads, which outlive frames, keep to the heap.
+	class FrameArenas
+	{
+		public:
+			// the first threads find their arena in a fixed table without locking, the ones past
+			// it (a machine with more cores, or pools started one after the other) in a list behind
+			// a mutex
+			static constexpr size_t MAX_THREADS = 64;
+
+			explicit FrameArenas(size_t pFrames) : mArenas(pFrames * MAX_THREADS), mOverflow(pFrames)
+			{
+			}
+
+			// pFrame's data from its last time in flight goes, the GPU is done with that frame
+			void beginFrame(uint32_t pFrame)
+			{
+				mLastFrameBytes = frameBytes(mFrame);
+				mPeakFrameBytes = std::max(mPeakFrameBytes, mLastFrameBytes);
+
+				mFrame = pFrame;
+				for (size_t i = 0; i < MAX_THREADS; i++)
+					if (mArenas[pFrame * MAX_THREADS + i] != nullptr)
+						mArenas[pFrame * MAX_THREADS + i]->reset();
+				for (const std::unique_ptr<LinearArena>& arena : mOverflow[pFrame])
+					if (arena != nullptr)
+						arena->reset();
+			}
+
+			// the calling thread's arena for the frame being recorded
+			LinearArena& local()
+			{
+				const size_t index = threadIndex();
+				if (index >= MAX_THREADS)
+					return overflow(index - MAX_THREADS);
+
+				std::unique_ptr<LinearArena>& arena = mArenas[mFrame * MAX_THREADS + index];
+				if (arena == nullptr)
+					arena = std::make_unique<LinearArena>();
+				return *arena;
+			}
+
+			template <class T> ArenaAllocator<T> allocator()
+			{
+				return ArenaAllocator<T>(local());
+			}
+
+			// bytes the previous frame took over all threads
+			size_t lastFrameBytes() const
+			{
+				return mLastFrameBytes;
+			}
+
+			// the most any frame took so far
+			size_t peakFrameBytes() const
+			{
+				return mPeakFrameBytes;
+			}
+
+			size_t capacity() const
+			{
+				size_t bytes = 0;
+				for (const std::unique_ptr<LinearArena>& arena : mArenas)
+					if (arena != nullptr)
+						bytes += arena->capacity();
+				for (const std::vector<std::unique_ptr<LinearArena>>& arenas : mOverflow)
+					for (const std::unique_ptr<LinearArena>& arena : arenas)
+						if (arena != nullptr)
+							bytes += arena->capacity();
+				return bytes;
+			}
+
+		private:
+			std::vector<std::unique_ptr<LinearArena>> mArenas;
+			// by frame, the arenas of the threads past MAX_THREADS
+			std::vector<std::vector<std::unique_ptr<LinearArena>>> mOverflow;
+			std::mutex mOverflowMutex;
+			uint32_t mFrame = 0;
+			size_t mLastFrameBytes = 0;
+			size_t mPeakFrameBytes = 0;
+
+			size_t frameBytes(uint32_t pFrame) const
+			{
+				size_t bytes = 0;
+				for (size_t i = 0; i < MAX_THREADS; i++)
+					if (mArenas[pFrame * MAX_THREADS + i] != nullptr)
+						bytes += mArenas[pFrame * MAX_THREADS + i]->used();
+				for (const std::unique_ptr<LinearArena>& arena : mOverflow[pFrame])
+					if (arena != nullptr)
+						bytes += arena->used();
+				return bytes;
+			}
+
+			// the arena only moves with its unique_ptr, growing the list leaves it where it is
+			LinearArena& overflow(size_t pSlot)
+			{
+				std::lock_guard<std::mutex> lock(mOverflowMutex);
+				std::vector<std::unique_ptr<LinearArena>>& arenas = mOverflow[mFrame];
+				if (pSlot >= arenas.size())
+					arenas.resize(pSlot + 1);
+				if (arenas[pSlot] == nullptr)
+					arenas[pSlot] = std::make_unique<LinearArena>();
+				return *arenas[pSlot];
+			}
+
+			// threads are numbered in the order they first ask for an arena
+			static size_t threadIndex()
+			{
+				static std::atomic<size_t> next { 0 };
+				thread_local size_t index = next++;
+				return index;
+			}
+	};
+}
@@ -1,36 +1,23 @@
 #pragma once
-#include "Camera.h"
-#include "Animator.h"
+#include <vector>
 #include "UniformBuffer.h"
+#include "World.h"
+#include "Components.h"
+#include "Transform/Transform.h"
+#include "Pool.h"
 
 namespace Renderer
 {
-	struct UniformBufferObject {
-		__declspec(align(16)) lm::mat4 mModel;
-		__declspec(align(16)) lm::mat3 mInverseModel;
-		__declspec(align(16)) lm::mat4 mVP;
-		__declspec(align(16)) lm::vec3 mView;
-		__declspec(align(16)) lm::mat4 mFinalBonesMatrices[MAX_BONE];
-		__declspec(align(16)) bool mHasAnimation;
-	};
-
 	class GameObject
 	{
 	public:
-		VKRenderer& mRenderer;
-		UniformBuffer mUniBuffer;
-		UniformBufferObject mData{};
-
-		lm::mat4 mLocal = lm::mat4::identity;
-		lm::mat4 mGlobal = lm::mat4::identity;
-		lm::vec3* mV = nullptr;
-		lm::mat4* mVP = nullptr;
-
-
-		Model** mModel = nullptr;
-		Shader** mShader = nullptr;
-		Texture** mTexture = nullptr;
+		// a handle into the scene's World: what the systems iterate lives in its component arrays,
+		// the local and global matrices in its TransformHierarchy
+		World& mWorld;
+		Entity mEntity = INVALID_ENTITY;
+		TransformHierarchy::Handle mTransform = TransformHierarchy::INVALID;
 
+		// editing data, update and draw only read the World
 		lm::vec3 mRight = lm::vec3::right;
 		lm::vec3 mForward = lm::vec3::forward;
 		lm::vec3 mUp = lm::vec3::up;
@@ -40,20 +27,33 @@ namespace Renderer
 		lm::vec3 mScale = lm::vec3::unitVal;
 
 		GameObject* mParent = nullptr;
-		std::list<GameObject*> mChilds;
+		// unordered, a child knows its place so that removing it is a swap with the last one
+		std::vector<GameObject*> mChilds;
+		uint32_t mChildIndex = 0;
 
-		Animator* mAnimator = nullptr;
-
-		GameObject(VKRenderer& pRenderer, Camera& pCamera, Model** pModel, Shader** pShader, Texture** pTexture, const lm::vec3& pPosition, const lm::vec3& pRotation, const lm::vec3& pScale);
+		GameObject(World& pWorld, Model** pModel, Shader** pShader, Texture** pTexture, const lm::vec3& pPosition, const lm::vec3& pRotation, const lm::vec3& pScale);
 		~GameObject();
 
+		// blocks of Pool<GameObject>::shared(), or of a Scene's pool when it created the object
+		static void* operator new(size_t pSize);
+		static void operator delete(void* pObject);
+
 		void addChild(GameObject& pChild);
 		void removeChild(GameObject& pChild);
 
+		// global matrices are computed by Scene::update in one pass over the hierarchy,
+		// updateGlobal refreshes this object and its children right away
 		void updateGlobal();
 		void updateLocal();
-		void update(float pDeltaTime);
-		void draw();
+
+		const lm::mat4& getLocal() const;
+		void setLocal(const lm::mat4& pLocal);
+		const lm::mat4& getGlobal() const;
+
+		Model** getModel() const;
+		Animator* getAnimator() const;
+
+		lm::transform getLocalTransform() const;
 
 		lm::vec3 GameObject::getGlobalScale(const GameObject& pObj, lm::vec3& pScale);
 
@@ -1,5 +1,6 @@
 #pragma once
 #include "Vec4/Vec4.h"
+#include "Gpu/Gpu.h"
 
 namespace Renderer
 {
@@ -16,7 +17,7 @@ namespace Renderer
 
 	struct DirectionalLight : public Light
 	{
-		__declspec(align(16)) lm::vec3 mDirection;
+		alignas(lm::gpu::std430Alignment<lm::vec3>) lm::vec3 mDirection;
 
 		DirectionalLight(const lm::vec3& pDirection = lm::vec3(0, -1, 0), const lm::vec4& pDiffuse = lm::vec4(1, 1, 1, 0.8f), const lm::vec4& pAmbient = lm::vec4(1, 1, 1, 0.05f), const lm::vec4& pSpecular = lm::vec4(1, 1, 1, 1));
 		bool operator==(DirectionalLight& pLight);
@@ -24,7 +25,7 @@ namespace Renderer
 
 	struct PointLight : public Light
 	{
-		__declspec(align(16)) lm::vec3 mPosition;
+		alignas(lm::gpu::std430Alignment<lm::vec3>) lm::vec3 mPosition;
 		float mConstant;
 		float mLinear;
 		float mQuadratic;
@@ -35,8 +36,8 @@ namespace Renderer
 
 	struct SpotLight : public Light
 	{
-		__declspec(align(16)) lm::vec3 mDirection;
-		__declspec(align(16)) lm::vec3 mPosition;
+		alignas(lm::gpu::std430Alignment<lm::vec3>) lm::vec3 mDirection;
+		alignas(lm::gpu::std430Alignment<lm::vec3>) lm::vec3 mPosition;
 		float mConstant;
 		float mLinear;
 		float mQuadratic;
@@ -48,4 +49,7 @@ namespace Renderer
 		SpotLight(const lm::vec3& pPosition = lm::vec3(0, 0, 0), const lm::vec3& pDirection = lm::vec3(0, 0, 1), float pCutOff = 12.5f, float pOuterCutOff = 17.5f, float pConstant = 1.0f, float pLinear = 0.09f, float pQuadratic = 0.032f, const lm::vec4& pDiffuse = lm::vec4(1, 1, 1, 0.8f), const lm::vec4& pAmbient = lm::vec4(1, 1, 1, 0.05f), const lm::vec4& pSpecular = lm::vec4(1, 1, 1, 1));
 		bool operator==(SpotLight& pLight);
 	};
+
+	// std430 elements of the light buffers in frag.frag
+	static_assert(sizeof(DirectionalLight) == 64 && sizeof(PointLight) == 80 && sizeof(SpotLight) == 96, "light layout does not match frag.frag");
 }
\ No newline at end of file
@@ -36,7 +36,8 @@ namespace Renderer
 
 			VkDescriptorSetLayout mObjectSetLayout;
 
-			std::vector<DebugVertex> mLineVertice;
+			// taken from the frame arena, lines are drawn between beginDraw and flushLines
+			FrameVector<DebugVertex> mLineVertice;
 
 			UniformBuffer mUniBuffer;
 
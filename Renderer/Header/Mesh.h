@@ -1,6 +1,7 @@
 #pragma once
 #include "Vec2/Vec2.h"
 #include "Shader.h"
+#include "Pool.h"
 
 #define MAX_BONE_INFLUENCE 4
 
@@ -42,5 +43,8 @@ namespace Renderer
 		void createIndexBuffer();
 		void draw(Shader& pShader);
 		~Mesh();
+
+		static void* operator new(size_t pSize);
+		static void operator delete(void* pObject);
 	};
 }
\ No newline at end of file
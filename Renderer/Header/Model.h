@@ -7,6 +7,8 @@
 #include <map>
 #include "Bone.h"
 #include "Animation.h"
+#include "AABB/AABB.h"
+#include "CollisionMesh.h"
 
 namespace Renderer
 {
@@ -22,6 +24,11 @@ namespace Renderer
 
 			Animation* mAnimation = nullptr;
 
+			// every vertex of every mesh in model space, in the bind pose
+			lm::aabb mBounds;
+			// the triangles of every mesh for ray casts, in the bind pose like mBounds
+			CollisionMesh mCollision;
+
 			Model(VKRenderer& pRenderer, const std::string& pFilePath);
 			~Model() override;
 
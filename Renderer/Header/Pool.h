@@ -0,0 +1,137 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace Renderer
+{
+	// Fixed size blocks for objects of type T, carved out of slabs of pSlabObjects and recycled through
+	// a free list. Each block remembers its pool, so deallocate finds it back from the pointer alone and
+	// objects from the shared pool and from a scene's pool can be deleted the same way.
+	// Allocation locks the pool, objects are created on the resource and worker threads too.
+	template <class T> class Pool
+	{
+		public:
+			explicit Pool(size_t pSlabObjects = 256) : mSlabObjects(pSlabObjects)
+			{
+			}
+
+			~Pool()
+			{
+				release();
+			}
+
+			Pool(const Pool&) = delete;
+			Pool& operator=(const Pool&) = delete;
+
+			// storage for one T, constructed by the caller
+			void* allocate()
+			{
+				std::lock_guard<std::mutex> lock(mMutex);
+				if (mFree == nullptr)
+					grow();
+
+				Slot* slot = mFree;
+				mFree = slot->mNext;
+				slot->mOwner = this;
+				mLive++;
+				return slot->mStorage;
+			}
+
+			static void deallocate(void* pObject)
+			{
+				if (pObject == nullptr)
+					return;
+
+				Slot* slot = reinterpret_cast<Slot*>(static_cast<unsigned char*>(pObject) - offsetof(Slot, mStorage));
+				Pool* owner = slot->mOwner;
+
+				std::lock_guard<std::mutex> lock(owner->mMutex);
+				slot->mNext = owner->mFree;
+				owner->mFree = slot;
+				owner->mLive--;
+			}
+
+			template <class... A> T* create(A&&... pArgs)
+			{
+				void* storage = allocate();
+				try
+				{
+					return ::new (storage) T(std::forward<A>(pArgs)...);
+				}
+				catch (...)
+				{
+					deallocate(storage);
+					throw;
+				}
+			}
+
+			static void destroy(T* pObject)
+			{
+				if (pObject == nullptr)
+					return;
+
+				pObject->~T();
+				deallocate(pObject);
+			}
+
+			// every slab at once, the objects in them must be destroyed already or never be touched again
+			void release()
+			{
+				std::lock_guard<std::mutex> lock(mMutex);
+				mSlabs.clear();
+				mFree = nullptr;
+				mLive = 0;
+			}
+
+			// objects allocated and not deallocated
+			size_t size() const
+			{
+				return mLive;
+			}
+
+			size_t capacity() const
+			{
+				return mSlabs.size() * mSlabObjects;
+			}
+
+			// what T::operator new draws from
+			static Pool& shared()
+			{
+				static Pool pool;
+				return pool;
+			}
+
+		private:
+			struct Slot
+			{
+				Pool* mOwner;
+				union
+				{
+					Slot* mNext;
+					alignas(T) unsigned char mStorage[sizeof(T)];
+				};
+			};
+
+			std::vector<std::unique_ptr<Slot[]>> mSlabs;
+			Slot* mFree = nullptr;
+			size_t mSlabObjects;
+			size_t mLive = 0;
+			std::mutex mMutex;
+
+			// the blocks of a new slab are handed out in address order
+			void grow()
+			{
+				mSlabs.emplace_back(new Slot[mSlabObjects]);
+				Slot* slab = mSlabs.back().get();
+				for (size_t i = mSlabObjects; i-- > 0;)
+				{
+					slab[i].mNext = mFree;
+					mFree = &slab[i];
+				}
+			}
+	};
+}
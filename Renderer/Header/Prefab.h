@@ -0,0 +1,57 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "World.h"
+#include "Components.h"
+#include "RetireQueue.h"
+
+namespace Renderer
+{
+	class GameObject;
+
+	// An immutable template of a subtree: what each node draws and where it sits in its parent. An
+	// instance shares the models, shaders and textures and owns only its entities, its transforms
+	// and its animation state, making one is a few appends to the World's arrays.
+	class Prefab
+	{
+		public:
+			static constexpr uint32_t NO_PARENT = UINT32_MAX;
+
+			struct Node
+			{
+				Model** mModel = nullptr;
+				Shader** mShader = nullptr;
+				Texture** mTexture = nullptr;
+				lm::mat4 mLocal = lm::mat4(1.f);
+				// index in getNodes(), before the node itself
+				uint32_t mParent = NO_PARENT;
+			};
+
+			// the first node is the root, the others need a parent
+			uint32_t addNode(Model** pModel, Shader** pShader, Texture** pTexture, const lm::mat4& pLocal, uint32_t pParent = NO_PARENT);
+			const std::vector<Node>& getNodes() const;
+
+			// pRoot and its descendants as they are now, placed relative to pRoot
+			static Prefab fromObject(const GameObject& pRoot);
+
+		private:
+			std::vector<Node> mNodes;
+	};
+
+	// the parts of one instance in the order of the prefab's nodes, the root first
+	struct PrefabInstance
+	{
+		struct Part
+		{
+			Entity mEntity;
+			TransformHierarchy::Handle mTransform;
+		};
+
+		std::vector<Part> mParts;
+	};
+
+	// the root of the instance gets pTransform as its local matrix
+	void instantiatePrefab(World& pWorld, const Prefab& pPrefab, const lm::mat4& pTransform, PrefabInstance& pInstance);
+	// the animators and bone palettes of the parts go to pRetired, the frames in flight may still use them
+	void destroyPrefabInstance(World& pWorld, PrefabInstance& pInstance, RetireQueue& pRetired);
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+namespace Renderer
+{
+	class IResource;
+	class UniformBuffer;
+	class Animator;
+
+	// What the frames in flight may still use, deleted once they are done with it: a frame recorded
+	// before retire() is done once beginDraw waited on its fence, which takes MAX_FRAMES_IN_FLIGHT
+	// more frames. Owned by the Scene, anything that destroys drawn entities retires through it.
+	class RetireQueue
+	{
+		public:
+			RetireQueue() = default;
+			RetireQueue(const RetireQueue&) = delete;
+			RetireQueue& operator=(const RetireQueue&) = delete;
+			~RetireQueue();
+
+			// any of them may be nullptr
+			void retire(UniformBuffer* pBones, Animator* pAnimator);
+			void retire(IResource* pResource);
+
+			// once a frame, deletes what no frame in flight can use any more
+			void advance();
+
+			// everything at once, the GPU must be idle
+			void flush();
+
+		private:
+			struct Retired
+			{
+				uint64_t mFrame;
+				IResource* mResource;
+				UniformBuffer* mBones;
+				Animator* mAnimator;
+			};
+
+			std::vector<Retired> mRetired;
+			uint64_t mFrame = 0;
+
+			static void destroy(const Retired& pRetired);
+	};
+}
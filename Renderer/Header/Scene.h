@@ -1,7 +1,15 @@
 #pragma once
 #include "Light.h"
 #include "StorageBuffer.h"
+#include "UniformBuffer.h"
 #include "Shader.h"
+#include "Systems.h"
+#include "SlotMap.h"
+#include "Pool.h"
+#include "Prefab.h"
+#include "SceneQuery.h"
+#include "RetireQueue.h"
+#include <algorithm>
 
 #define MAX_LIGHT 10
 
@@ -25,53 +33,191 @@ namespace Renderer
 		SpotLight mData[MAX_LIGHT];
 	};
 
+	// { int size; Light data[MAX_LIGHT]; } std430 blocks of frag.frag, the array starts on the next 16 bytes
+	static_assert(sizeof(DirLights) == 16 + MAX_LIGHT * sizeof(DirectionalLight) && sizeof(SpotLights) == 16 + MAX_LIGHT * sizeof(SpotLight), "light block layout does not match frag.frag");
+	static_assert(sizeof(PointLights) == 16 + MAX_LIGHT * sizeof(PointLight), "light block layout does not match frag.frag");
+
 	template <class T> class Scene
 	{
 		public:
-			std::vector<T*> mGameObjects;
+			// the roots, owned by the scene and referred to by handles that go stale once removed or
+			// after clear(); every object and light keeps its data in mWorld
+			SlotMap<T*> mGameObjects;
+			// the scene's own blocks for the objects made by create(), released at once by clear()
+			Pool<T> mNodePool;
+			// entities made from a prefab, with no object of their own
+			SlotMap<PrefabInstance> mInstances;
+			World mWorld;
+			// the animators and bone palettes of destroyed entities until the frames in flight are done,
+			// a WorldStreamer on mWorld retires its instances and resources through it as well
+			RetireQueue mRetired;
 
+			// light components gathered into the layout of frag.frag before upload
 			DirLights mDirLights;
 			PointLights mPointLights;
 			SpotLights mSpotLights;
 
 			StorageBuffer mStoreBuffer;
+			// the uniform blocks of everything drawn in a frame
+			DynamicUniformBuffer mObjectUniforms;
+			// bound in place of a bone palette for the objects that are not animated
+			UniformBuffer mNoBones;
+			// drawn in order, a view after the first one clears the depth under it
+			std::vector<View> mViews;
+			FrameObjects mObjects;
 
 			VKRenderer& mRenderer;
+			ThreadPool& mPool;
 			
 
-			Scene(VKRenderer& pRenderer) : mRenderer(pRenderer), mStoreBuffer(pRenderer) {}
+			Scene(VKRenderer& pRenderer, ThreadPool& pPool) : mRenderer(pRenderer), mPool(pPool), mStoreBuffer(pRenderer), mObjectUniforms(pRenderer), mNoBones(pRenderer) {}
 
 			void init()
 			{
 				mStoreBuffer.init(VK_SHADER_STAGE_FRAGMENT_BIT);
+				mObjectUniforms.init(sizeof(UniformBufferObject), VK_SHADER_STAGE_VERTEX_BIT, 1024);
+				mNoBones.init(sizeof(BonePalette), VK_SHADER_STAGE_VERTEX_BIT);
+			}
+
+			// allocated in mNodePool, the object has to end up in the scene as a root or as the child of
+			// one before clear(); delete still works on it
+			template <class... A> T* create(A&&... pArgs)
+			{
+				return mNodePool.create(std::forward<A>(pArgs)...);
+			}
+
+			SlotHandle addNode(T* pNode)
+			{
+				return mGameObjects.insert(pNode);
+			}
+
+			// nullptr for a stale handle
+			T* getNode(SlotHandle pNode)
+			{
+				T** node = mGameObjects.get(pNode);
+				return node != nullptr ? *node : nullptr;
+			}
+
+			// the node is handed back to the caller, nullptr for a stale handle. Its animators and bone
+			// palettes go to mRetired first, so deleting it right away cannot free what a frame in flight
+			// binds; added back, it gets new ones as a new node would
+			T* removeNode(SlotHandle pNode)
+			{
+				T* node = getNode(pNode);
+				mGameObjects.remove(pNode);
+				if (node != nullptr)
+					retireAnimations(*node);
+				return node;
+			}
+
+			bool destroyNode(SlotHandle pNode)
+			{
+				T* node = removeNode(pNode);
+				delete node;
+				return node != nullptr;
+			}
+
+			// the root of the instance is placed at pTransform, the handle goes stale once it is destroyed
+			SlotHandle instantiate(const Prefab& pPrefab, const lm::mat4& pTransform)
+			{
+				PrefabInstance instance;
+				instantiatePrefab(mWorld, pPrefab, pTransform, instance);
+				return mInstances.insert(std::move(instance));
+			}
+
+			// nullptr for a stale handle, mParts[0] is the root to move the instance with
+			PrefabInstance* getInstance(SlotHandle pInstance)
+			{
+				return mInstances.get(pInstance);
+			}
+
+			bool destroyInstance(SlotHandle pInstance)
+			{
+				PrefabInstance* instance = mInstances.get(pInstance);
+				if (instance == nullptr)
+					return false;
+
+				destroyPrefabInstance(mWorld, *instance, mRetired);
+				mInstances.remove(pInstance);
+				return true;
 			}
 
-			T* addNode(T* pNode)
+			// pCamera drawn into the rectangle given in fractions of the swap chain image, the camera must
+			// outlive the scene or be removed from mViews first; returns the index of the view
+			size_t addView(const Camera& pCamera, float pX = 0.f, float pY = 0.f, float pWidth = 1.f, float pHeight = 1.f)
 			{
-				mGameObjects.push_back(pNode);
-				return mGameObjects.back();
+				View view;
+				view.mCamera = &pCamera;
+				view.mX = pX;
+				view.mY = pY;
+				view.mWidth = pWidth;
+				view.mHeight = pHeight;
+				mViews.push_back(std::move(view));
+				return mViews.size() - 1;
 			}
 
-			void removeNode(T& pNode)
+			// what is outside the frustum of a view is left out of its next draw, all views in one pass
+			void cull()
 			{
-				std::vector<T*>::iterator it = std::find(mGameObjects.begin(), mGameObjects.end(), &pNode);
-				if (it != mGameObjects.end())
-					mGameObjects.erase(it);
+				cullRenderables(mWorld, mPool, mViews.data(), mViews.size(), mObjects);
 			}
 
+			// the objects any view sees are uploaded once, then each view draws its own
 			void draw()
 			{
-				for (unsigned int i = 0; i < this->mGameObjects.size(); i++)
-					mGameObjects[i]->draw();
+				uploadRenderables(mWorld, mRenderer, mObjects, mObjectUniforms);
+				for (size_t i = 0; i < mViews.size(); i++)
+				{
+					const View& view = mViews[i];
+					mRenderer.setViewport(view.mX, view.mY, view.mWidth, view.mHeight, i != 0);
+					drawRenderables(mWorld, mRenderer, view, mObjectUniforms, mNoBones);
+				}
+				mRenderer.setViewport(0.f, 0.f, 1.f, 1.f, false);
 			}
 
+			// against the triangles of what is drawn, once update() has run
+			bool raycast(const lm::ray& pRay, float pMaxDistance, RayHit& pHit)
+			{
+				return Renderer::raycast(mWorld, pRay, pMaxDistance, pHit);
+			}
+
+			void raycastAll(const lm::ray& pRay, float pMaxDistance, std::vector<RayHit>& pHits)
+			{
+				Renderer::raycastAll(mWorld, pRay, pMaxDistance, pHits);
+			}
+
+			// many rays at once on the workers of mPool, e.g. the placement and selection queries of a frame
+			void raycast(const lm::ray* pRays, size_t pCount, float pMaxDistance, RayHit* pHits)
+			{
+				Renderer::raycast(mWorld, mPool, pRays, pCount, pMaxDistance, pHits);
+			}
+
+			void writeMemoryReport(std::ostream& pStream)
+			{
+				Renderer::writeMemoryReport(mWorld, mRenderer, sizeof(T), pStream);
+			}
+
+			// entities drawn and culled by pView in the current frame
+			const VisibleSet& getVisible(size_t pView = 0) const
+			{
+				return mViews[pView].mVisible;
+			}
+
+			// the animations and then the transforms are updated on the workers of mPool,
+			// everything is done when it returns
 			void update(float pDeltaTime)
 			{
-				for (unsigned int i = 0; i < this->mGameObjects.size(); i++)
-					mGameObjects[i]->update(pDeltaTime);
+				mRetired.advance();
+				updateAnimations(mWorld, mPool, pDeltaTime);
+
+				// every global matrix, children included, in one pass
+				mWorld.mTransforms.update(mPool);
+
+				// then the world bounds of what moved
+				updateBounds(mWorld);
 			}
 
-			std::vector<T*>& getGameObjects()
+			SlotMap<T*>& getGameObjects()
 			{
 				return mGameObjects;
 			}
@@ -81,85 +227,103 @@ namespace Renderer
 				clear();
 			}
 
+			// every object and instance at once, the GPU must be idle
 			void clear()
 			{
-				for (unsigned int i = 0; i < this->mGameObjects.size(); i++)
-					delete mGameObjects[i];
+				for (T* node : mGameObjects)
+					delete node;
 				mGameObjects.clear();
+
+				for (PrefabInstance& instance : mInstances)
+					destroyPrefabInstance(mWorld, instance, mRetired);
+				mInstances.clear();
+				mNodePool.release();
+				mRetired.flush();
 			}
 
 			void addLight(DirectionalLight* pLight)
 			{
-				mDirLights.mData[mDirLights.mSize++] = *pLight;
+				addLightComponent(pLight);
 			}
 
 			void removeLight(DirectionalLight* pLight)
 			{
-				for (unsigned int i = 0; i < mDirLights.mSize; i++)
-				{
-					if (mDirLights.mData[i] == *pLight)
-					{
-						for (unsigned int j = i; j < mDirLights.mSize - 1; j++)
-							mDirLights.mData[j] = mDirLights.mData[j + 1];
-
-						mDirLights.mSize--;
-						break;
-					}
-				}
+				removeLightComponent(pLight);
 			}
 
 			void addLight(PointLight* pLight)
 			{
-				mPointLights.mData[mPointLights.mSize++] = *pLight;
+				addLightComponent(pLight);
 			}
 
 			void removeLight(PointLight* pLight)
 			{
-				for (unsigned int i = 0; i < mPointLights.mSize; i++)
-				{
-					if (mPointLights.mData[i] == *pLight)
-					{
-						for (unsigned int j = i; j < mPointLights.mSize - 1; j++)
-							mPointLights.mData[j] = mPointLights.mData[j + 1];
-
-						mPointLights.mSize--;
-						break;
-					}
-				}
+				removeLightComponent(pLight);
 			}
 
 			void addLight(SpotLight* pLight)
 			{
-				mSpotLights.mData[mSpotLights.mSize++] = *pLight;
+				addLightComponent(pLight);
 			}
 
 			void removeLight(SpotLight* pLight)
 			{
-				for (unsigned int i = 0; i < mSpotLights.mSize; i++)
-				{
-					if (mSpotLights.mData[i] == *pLight)
-					{
-						for (unsigned int j = i; j < mSpotLights.mSize - 1; j++)
-							mSpotLights.mData[j] = mSpotLights.mData[j + 1];
-
-						mSpotLights.mSize--;
-						break;
-					}
-				}
+				removeLightComponent(pLight);
 			}
 
 			void sendLight(Shader& pShader)
 			{
+				gatherLights(mWorld.components<DirectionalLight>(), mDirLights);
+				gatherLights(mWorld.components<PointLight>(), mPointLights);
+				gatherLights(mWorld.components<SpotLight>(), mSpotLights);
+
 				pShader.bind();
 
 				if (mDirLights.mSize != 0)
 					pShader.setLight(&mStoreBuffer.DescriptorSets[mRenderer.mCurrentFrame], mStoreBuffer.mDirectionalLightStorageBuffersMapped[mRenderer.mCurrentFrame], &mDirLights, sizeof(DirLights));
 
 				if (mPointLights.mSize != 0)
-					pShader.setLight(&mStoreBuffer.DescriptorSets[mRenderer.mCurrentFrame], mStoreBuffer.mPointLightStorageBuffersMapped[mRenderer.mCurrentFrame], &mPointLights, sizeof(PointLight));
+					pShader.setLight(&mStoreBuffer.DescriptorSets[mRenderer.mCurrentFrame], mStoreBuffer.mPointLightStorageBuffersMapped[mRenderer.mCurrentFrame], &mPointLights, sizeof(PointLights));
 
 				if (mSpotLights.mSize != 0)
-					pShader.setLight(&mStoreBuffer.DescriptorSets[mRenderer.mCurrentFrame], mStoreBuffer.mSpotLightStorageBuffersMapped[mRenderer.mCurrentFrame], &mSpotLights, sizeof(SpotLight));
+					pShader.setLight(&mStoreBuffer.DescriptorSets[mRenderer.mCurrentFrame], mStoreBuffer.mSpotLightStorageBuffersMapped[mRenderer.mCurrentFrame], &mSpotLights, sizeof(SpotLights));
+			}
+
+		private:
+			// pNode and its children keep nothing the frames in flight may still use
+			void retireAnimations(T& pNode)
+			{
+				AnimationComponent& animation = mWorld.get<AnimationComponent>(pNode.mEntity);
+				mRetired.retire(animation.mBones, animation.mAnimator);
+				animation.mBones = nullptr;
+				animation.mAnimator = nullptr;
+
+				for (T* child : pNode.mChilds)
+					retireAnimations(*child);
+			}
+
+			template <class L> void addLightComponent(L* pLight)
+			{
+				mWorld.add<L>(mWorld.create(), *pLight);
+			}
+
+			template <class L> void removeLightComponent(L* pLight)
+			{
+				ComponentArray<L>& lights = mWorld.components<L>();
+				for (size_t i = 0; i < lights.size(); i++)
+				{
+					if (lights.mData[i] == *pLight)
+					{
+						mWorld.destroy(lights.mEntities[i]);
+						break;
+					}
+				}
+			}
+
+			template <class L, class B> static void gatherLights(const ComponentArray<L>& pLights, B& pBlock)
+			{
+				pBlock.mSize = int(std::min(pLights.size(), size_t(MAX_LIGHT)));
+				std::copy(pLights.mData.begin(), pLights.mData.begin() + pBlock.mSize, pBlock.mData);
 			}
 	};
 }
\ No newline at end of file
@@ -0,0 +1,34 @@
+#pragma once
+#include "World.h"
+#include "Components.h"
+#include "ThreadPool.h"
+#include "Ray/Ray.h"
+
+namespace Renderer
+{
+	struct RayHit
+	{
+		Entity mEntity = INVALID_ENTITY;
+		float mDistance = 0.f;
+		// in the CollisionMesh of the entity's model
+		uint32_t mTriangle = UINT32_MAX;
+		lm::vec3 mPoint;
+	};
+
+	// Ray casts against what is drawn: the BVH of the world boxes finds the entities along the ray front
+	// to back, then the triangles of their model are tested in model space. Models are in their bind pose
+	// like their boxes, a model still loading is not hit. The transforms and boxes must be up to date,
+	// i.e. the queries run after Scene::update, and nothing may change the world while they run.
+
+	// the triangles of the model of pEntity only, pMaxDistance becomes the distance of the hit
+	bool raycastEntity(World& pWorld, ComponentArray<RenderComponent>& pRenderables, Entity pEntity, const lm::ray& pRay, float& pMaxDistance, uint32_t& pTriangle);
+
+	// nearest hit before pMaxDistance
+	bool raycast(World& pWorld, const lm::ray& pRay, float pMaxDistance, RayHit& pHit);
+
+	// the nearest hit of every entity pRay crosses before pMaxDistance, front to back
+	void raycastAll(World& pWorld, const lm::ray& pRay, float pMaxDistance, std::vector<RayHit>& pHits);
+
+	// nearest hit of each ray, chunks of rays on the workers of pPool; mEntity is INVALID_ENTITY for a miss
+	void raycast(World& pWorld, ThreadPool& pPool, const lm::ray* pRays, size_t pCount, float pMaxDistance, RayHit* pHits);
+}
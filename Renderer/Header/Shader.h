@@ -6,12 +6,16 @@ namespace Renderer
 	class Shader : public IResource
 	{
 		public:
+			// the push constant block of vertex.vert, set once per view
+			static constexpr uint32_t VIEW_CONSTANTS_BYTES = 80;
+
 			VKRenderer& mRenderer;
 			VkPipeline mGraphicsPipeline = nullptr;
 			VkPipelineLayout mPipelineLayout = nullptr;
 
 			VkDescriptorSetLayout mGlobalSetLayout;
 			VkDescriptorSetLayout mObjectSetLayout;
+			VkDescriptorSetLayout mBonesSetLayout;
 			VkDescriptorSetLayout mSingleTextureSetLayout;
 
 			Texture* mDefaultTexture = nullptr;
@@ -28,6 +32,10 @@ namespace Renderer
 			void bind();
 			void setLight(VkDescriptorSet* pDescriptor, void* pUniformBuffer, void* pData, size_t pSize);
 			void setTexture(const VkDescriptorSet& pDescriptor);
-			void setMVP(const VkDescriptorSet& pDescriptor, void* pUniformBuffer, void* pData, size_t pSize);
+			// pDescriptor is the set of a DynamicUniformBuffer, pOffset the offset of the object's block
+			void setMVP(const VkDescriptorSet& pDescriptor, uint32_t pOffset);
+			void setBones(const VkDescriptorSet& pDescriptor);
+			// the camera of the view being drawn, pushed again after each bind
+			void setView(const void* pData, uint32_t pSize);
 	};
 }
\ No newline at end of file
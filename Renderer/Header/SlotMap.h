@@ -0,0 +1,135 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace Renderer
+{
+	// refers to an object of a SlotMap; once the object is removed the slot's generation moves on
+	// and the handle stops resolving, even when the slot is reused
+	struct SlotHandle
+	{
+		uint32_t mIndex = UINT32_MAX;
+		uint32_t mGeneration = 0;
+
+		bool operator==(const SlotHandle& pOther) const
+		{
+			return mIndex == pOther.mIndex && mGeneration == pOther.mGeneration;
+		}
+
+		bool operator!=(const SlotHandle& pOther) const
+		{
+			return !(*this == pOther);
+		}
+	};
+
+	// Objects packed in mData for iteration, reached in O(1) through a table of slots. Removing
+	// moves the last object into the hole and frees the slot, the free slots form a list.
+	template <class T> class SlotMap
+	{
+		public:
+			std::vector<T> mData;
+
+			SlotHandle insert(T pValue)
+			{
+				uint32_t index;
+				if (mFreeSlot != UINT32_MAX)
+				{
+					index = mFreeSlot;
+					mFreeSlot = mSlots[index].mDense;
+					mSlots[index].mGeneration++;
+				}
+				else
+				{
+					index = uint32_t(mSlots.size());
+					mSlots.push_back({ 0, 1 });
+				}
+
+				mSlots[index].mDense = uint32_t(mData.size());
+				mData.push_back(std::move(pValue));
+				mDenseToSlot.push_back(index);
+				return { index, mSlots[index].mGeneration };
+			}
+
+			bool remove(SlotHandle pHandle)
+			{
+				if (!contains(pHandle))
+					return false;
+
+				Slot& slot = mSlots[pHandle.mIndex];
+				const uint32_t dense = slot.mDense;
+				if (dense != mData.size() - 1)
+				{
+					mData[dense] = std::move(mData.back());
+					mDenseToSlot[dense] = mDenseToSlot.back();
+					mSlots[mDenseToSlot[dense]].mDense = dense;
+				}
+				mData.pop_back();
+				mDenseToSlot.pop_back();
+
+				slot.mGeneration++;
+				slot.mDense = mFreeSlot;
+				mFreeSlot = pHandle.mIndex;
+				return true;
+			}
+
+			bool contains(SlotHandle pHandle) const
+			{
+				return pHandle.mIndex < mSlots.size() && mSlots[pHandle.mIndex].mGeneration == pHandle.mGeneration;
+			}
+
+			// nullptr for a stale handle
+			T* get(SlotHandle pHandle)
+			{
+				return contains(pHandle) ? &mData[mSlots[pHandle.mIndex].mDense] : nullptr;
+			}
+
+			const T* get(SlotHandle pHandle) const
+			{
+				return contains(pHandle) ? &mData[mSlots[pHandle.mIndex].mDense] : nullptr;
+			}
+
+			// handle of mData[pDense]
+			SlotHandle handleAt(size_t pDense) const
+			{
+				const uint32_t index = mDenseToSlot[pDense];
+				return { index, mSlots[index].mGeneration };
+			}
+
+			size_t size() const
+			{
+				return mData.size();
+			}
+
+			bool empty() const
+			{
+				return mData.empty();
+			}
+
+			// every handle handed out so far goes stale
+			void clear()
+			{
+				while (!mData.empty())
+					remove(handleAt(mData.size() - 1));
+			}
+
+			typename std::vector<T>::iterator begin() { return mData.begin(); }
+			typename std::vector<T>::iterator end() { return mData.end(); }
+			typename std::vector<T>::const_iterator begin() const { return mData.begin(); }
+			typename std::vector<T>::const_iterator end() const { return mData.end(); }
+
+		private:
+			struct Slot
+			{
+				// position in mData, or the next free slot
+				uint32_t mDense;
+				// odd while the slot is in use, even while it is free
+				uint32_t mGeneration;
+			};
+
+			std::vector<Slot> mSlots;
+			std::vector<uint32_t> mDenseToSlot;
+			uint32_t mFreeSlot = UINT32_MAX;
+	};
+}
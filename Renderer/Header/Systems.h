@@ -0,0 +1,98 @@
+#pragma once
+#include "World.h"
+#include "Components.h"
+#include "Camera.h"
+#include "Animator.h"
+#include "Shader.h"
+#include "ThreadPool.h"
+#include "Gpu/Gpu.h"
+#include <ostream>
+
+namespace Renderer
+{
+	class DynamicUniformBuffer;
+
+	// std140 mirror of the UniformBufferObject block in vertex.vert, what every object uploads once a frame
+	struct UniformBufferObject {
+		lm::gpu::std140<lm::mat4> mModel;
+		lm::gpu::std140<lm::mat3> mInverseModel;
+		lm::gpu::std140<bool> mHasAnimation;
+	};
+
+	static_assert(offsetof(UniformBufferObject, mInverseModel) == 64 && offsetof(UniformBufferObject, mHasAnimation) == 112, "UniformBufferObject does not match vertex.vert");
+
+	// std430 mirror of the push constant block of vertex.vert, what a view sets for its draws
+	struct ViewConstants {
+		lm::gpu::std430<lm::mat4> mVP;
+		lm::gpu::std430<lm::vec3> mPosition;
+	};
+
+	static_assert(offsetof(ViewConstants, mPosition) == 64 && sizeof(ViewConstants) == Shader::VIEW_CONSTANTS_BYTES, "ViewConstants does not match vertex.vert");
+
+	// std140 mirror of the BonePalette block in vertex.vert, a buffer of its own that only animated
+	// objects allocate; only the bones in use are uploaded
+	struct BonePalette {
+		lm::gpu::std140Array<lm::mat4, MAX_BONE> mFinalBonesMatrices;
+	};
+
+	static_assert(sizeof(BonePalette) == MAX_BONE * sizeof(lm::mat4), "BonePalette does not match vertex.vert");
+
+	// one pass over the AnimationComponents, split across the workers of pPool
+	void updateAnimations(World& pWorld, ThreadPool& pPool, float pDeltaTime);
+
+	// what cullRenderables found in the frustum of a view this frame, kept across frames so the buffers are reused
+	struct VisibleSet
+	{
+		std::vector<Entity> mEntities;
+		// the block of each entity in the frame's uniform buffer
+		std::vector<uint32_t> mBlocks;
+		size_t mVisible = 0;
+		size_t mCulled = 0;
+
+		// visible box indices of each chunk, written by the workers
+		std::vector<size_t> mIndices;
+		std::vector<size_t> mChunkCounts;
+	};
+
+	// a camera drawn into a part of the swap chain image, given in fractions of its width and height
+	struct View
+	{
+		const Camera* mCamera = nullptr;
+		float mX = 0.f;
+		float mY = 0.f;
+		float mWidth = 1.f;
+		float mHeight = 1.f;
+		VisibleSet mVisible;
+	};
+
+	// the entities any view sees this frame, the uniform block of each is its position in mEntities
+	struct FrameObjects
+	{
+		std::vector<Entity> mEntities;
+		// the box of each entity, and by box its block or UINT32_MAX
+		std::vector<uint32_t> mBoxes;
+		std::vector<uint32_t> mBlockOfBox;
+	};
+
+	// keeps the lm::aabb components and World::mBVH in step with the RenderComponents once their model
+	// is loaded: World::mUnbounded is boxed as the models arrive, then only the transforms in
+	// TransformHierarchy::getChanged() are visited and their boxes refitted in one lm::bvh::update batch
+	void updateBounds(World& pWorld);
+
+	// one pass over the world boxes for all the views: chunks of them on the workers of pPool, each chunk
+	// tested in SIMD batches against every frustum while it is in cache. A view gets the entities inside
+	// in the order of the boxes, pObjects the entities seen by any view
+	void cullRenderables(World& pWorld, ThreadPool& pPool, View* pViews, size_t pCount, FrameObjects& pObjects);
+
+	// the uniform block and the bone palette of every entity in pObjects, once whatever the number of views.
+	// An animated object gets its palette on the first frame it is seen
+	void uploadRenderables(World& pWorld, VKRenderer& pRenderer, const FrameObjects& pObjects, DynamicUniformBuffer& pUniforms);
+
+	// one pass over the entities pView sees, binding the blocks uploadRenderables wrote; the objects
+	// without a palette bind pNoBones
+	void drawRenderables(World& pWorld, VKRenderer& pRenderer, const View& pView, const DynamicUniformBuffer& pUniforms, const UniformBuffer& pNoBones);
+
+	// bytes each object takes in pWorld and in uniform buffers, pObjectBytes being the size of the object
+	// that owns the entity, against the uniform block of every object embedding a bone palette
+	void writeMemoryReport(World& pWorld, VKRenderer& pRenderer, size_t pObjectBytes, std::ostream& pStream);
+}
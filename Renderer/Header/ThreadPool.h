@@ -2,6 +2,8 @@
 #include <functional>
 #include <queue>
 #include <mutex>
+#include <thread>
+#include <condition_variable>
 
 namespace Renderer
 {
@@ -16,6 +18,13 @@ namespace Renderer
             ThreadPool();
             void start();
             void queueJob(std::function<void()> pJob);
+            // runs pJob over [0, pCount) in chunks of pGrain items on the workers and the calling
+            // thread, and returns once every chunk is done; pJob is called in place, not copied
+            template <class F> void parallelFor(size_t pCount, size_t pGrain, const F& pJob)
+            {
+                parallelFor(pCount, pGrain, &pJob, [](const void* pFunction, size_t pBegin, size_t pEnd) { (*static_cast<const F*>(pFunction))(pBegin, pEnd); });
+            }
+            void parallelFor(size_t pCount, size_t pGrain, const void* pJob, void (*pCall)(const void* pJob, size_t pBegin, size_t pEnd));
             void stop();
             bool busy();
             void threadLoop();
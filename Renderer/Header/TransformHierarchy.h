@@ -0,0 +1,85 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "Mat4/Mat4.h"
+#include "ThreadPool.h"
+
+namespace Renderer
+{
+	// Flat store of the scene transforms: local and world matrices in contiguous arrays plus the index
+	// of each parent, kept in depth first order so that a parent always comes before its children and
+	// a subtree is one range. World matrices are then computed in a single linear pass.
+	// Only the nodes whose local matrix or parent changed are recomputed, with their descendants.
+	// Nodes are referred to by handles, the storage index of a node changes when the hierarchy is re-sorted.
+	class TransformHierarchy
+	{
+		public:
+			typedef uint32_t Handle;
+			static constexpr Handle INVALID = UINT32_MAX;
+
+			Handle create(const lm::mat4& pLocal);
+			void destroy(Handle pNode);
+
+			// returns false when pParent is pNode or one of its descendants, INVALID makes pNode a root
+			bool setParent(Handle pNode, Handle pParent);
+			Handle getParent(Handle pNode) const;
+
+			void setLocal(Handle pNode, const lm::mat4& pLocal);
+			const lm::mat4& getLocal(Handle pNode) const;
+			const lm::mat4& getWorld(Handle pNode) const;
+
+			// the dirty nodes and their descendants
+			void update();
+			// the same on the workers of pPool, independent subtrees are updated in parallel and
+			// the result does not depend on the number of threads
+			void update(ThreadPool& pPool);
+			// pNode and its descendants, the world matrix of its parent must be up to date
+			void update(Handle pNode);
+
+			// nodes whose world matrix changed during the last update(), including the subtrees
+			// refreshed by update(pNode) since the previous one, in storage order
+			const std::vector<Handle>& getChanged() const;
+			// whether pNode is in getChanged()
+			bool hasChanged(Handle pNode) const;
+
+			size_t size() const;
+
+			// storage of one node across the arrays
+			static size_t bytesPerNode();
+
+		private:
+			// by storage index
+			std::vector<lm::mat4> mLocal;
+			std::vector<lm::mat4> mWorld;
+			std::vector<uint32_t> mParent;
+			std::vector<uint32_t> mSubtreeEnd;
+			std::vector<Handle> mHandle;
+			std::vector<uint8_t> mDirty;
+			std::vector<uint8_t> mRecomputed;
+			std::vector<uint8_t> mMoved;
+
+			// by handle
+			std::vector<uint32_t> mIndex;
+			std::vector<Handle> mFreeHandles;
+			// the update() that last changed the node
+			std::vector<uint32_t> mChangedFrame;
+
+			std::vector<Handle> mChanged;
+			uint32_t mFrame = 1;
+
+			bool mSorted = true;
+			bool mAnyDirty = false;
+			bool mAnyMoved = false;
+
+			// parallel update: ranges of whole subtrees and the nodes above them, in order
+			std::vector<std::pair<uint32_t, uint32_t>> mRanges;
+			std::vector<uint32_t> mSpine;
+			uint32_t mGrain = 0;
+
+			void sort();
+			void partition(uint32_t pGrain);
+			bool updateRange(uint32_t pBegin, uint32_t pEnd, bool pForce);
+			void recompute(uint32_t pBegin, uint32_t pEnd);
+			void publish();
+	};
+}
@@ -22,4 +22,35 @@ namespace Renderer
 			void createUniformBuffers(unsigned int pSize);
 			void createDescriptor(unsigned int pSize, VkShaderStageFlagBits pStage);
 	};
+
+	// One buffer per frame in flight with a block for each object drawn in that frame, bound with the
+	// offset of the block (VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC), so an object needs no buffer of its own
+	class DynamicUniformBuffer
+	{
+		public:
+			VKRenderer& mRenderer;
+			std::vector<VkBuffer> mUniformBuffers;
+			std::vector<VkDeviceMemory> mUniformBuffersMemory;
+			std::vector<void*> mUniformBuffersMapped;
+			std::vector<size_t> mCapacities;
+
+			std::vector<VkDescriptorSet> mDescriptorSets;
+
+			// padded size of a block, the distance between two offsets
+			size_t mStride = 0;
+
+
+			DynamicUniformBuffer(VKRenderer& pRenderer);
+			~DynamicUniformBuffer();
+
+			void init(unsigned int pSize, VkShaderStageFlagBits pStage, size_t pCount);
+			// room for pCount blocks in the buffer of pFrame, the GPU must be done with that frame
+			void reserve(uint32_t pFrame, size_t pCount);
+
+			void* getBlock(uint32_t pFrame, size_t pIndex) const;
+			uint32_t getOffset(size_t pIndex) const;
+
+		private:
+			void createUniformBuffer(uint32_t pFrame, size_t pCount);
+	};
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include <queue>
 #include <mutex>
 #include "VkDescriptor.h"
+#include "FrameArena.h"
 
 #ifdef NDEBUG
     const bool enableValidationLayers = false;
@@ -41,6 +42,7 @@ namespace Renderer
 
             static const int MAX_FRAMES_IN_FLIGHT;
             uint32_t mCurrentFrame = 0;
+            FrameArenas mFrameArenas { size_t(MAX_FRAMES_IN_FLIGHT) };
 
             Window& mWindow;
             const std::vector<const char*> mValidationLayers = { "VK_LAYER_KHRONOS_validation" };
@@ -137,6 +139,9 @@ namespace Renderer
 
             void beginDraw();
             void endDraw();
+            // draws go into the rectangle given in fractions of the swap chain image, pClearDepth clears
+            // the depth under it for a view drawn over another
+            void setViewport(float pX, float pY, float pWidth, float pHeight, bool pClearDepth);
 
             size_t padUniformBufferSize(size_t pOriginalSize);
             size_t padStorageBufferSize(size_t pOriginalSize);
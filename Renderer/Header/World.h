@@ -0,0 +1,170 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include "TransformHierarchy.h"
+#include "BVH/BVH.h"
+
+namespace Renderer
+{
+	typedef uint32_t Entity;
+	static constexpr Entity INVALID_ENTITY = UINT32_MAX;
+
+	class IComponentArray
+	{
+		public:
+			virtual ~IComponentArray() {};
+			virtual void remove(Entity pEntity) = 0;
+	};
+
+	// Components of one type packed in a vector, a system walks mData (and mEntities when it needs
+	// the owner) from start to end. mSparse maps an entity to its slot, removing swaps the last one in.
+	template <class C> class ComponentArray : public IComponentArray
+	{
+		public:
+			std::vector<C> mData;
+			std::vector<Entity> mEntities;
+			std::vector<uint32_t> mSparse;
+
+			C& add(Entity pEntity, const C& pComponent)
+			{
+				if (pEntity >= mSparse.size())
+					mSparse.resize(pEntity + 1, INVALID_ENTITY);
+
+				if (mSparse[pEntity] != INVALID_ENTITY)
+					return mData[mSparse[pEntity]] = pComponent;
+
+				mSparse[pEntity] = uint32_t(mData.size());
+				mEntities.push_back(pEntity);
+				mData.push_back(pComponent);
+				return mData.back();
+			}
+
+			void remove(Entity pEntity) override
+			{
+				if (!has(pEntity))
+					return;
+
+				const uint32_t slot = mSparse[pEntity];
+				if (slot != mData.size() - 1)
+				{
+					mData[slot] = std::move(mData.back());
+					mEntities[slot] = mEntities.back();
+					mSparse[mEntities[slot]] = slot;
+				}
+				mData.pop_back();
+				mEntities.pop_back();
+				mSparse[pEntity] = INVALID_ENTITY;
+			}
+
+			bool has(Entity pEntity) const
+			{
+				return pEntity < mSparse.size() && mSparse[pEntity] != INVALID_ENTITY;
+			}
+
+			C& get(Entity pEntity)
+			{
+				return mData[mSparse[pEntity]];
+			}
+
+			C* tryGet(Entity pEntity)
+			{
+				return has(pEntity) ? &mData[mSparse[pEntity]] : nullptr;
+			}
+
+			size_t size() const
+			{
+				return mData.size();
+			}
+	};
+
+	// Data oriented storage behind Scene: entities are ids, their components live in one packed
+	// array per type, the transforms in a TransformHierarchy and the world bounds in a BVH keyed by entity.
+	class World
+	{
+		public:
+			TransformHierarchy mTransforms;
+			lm::bvh mBVH;
+
+			// the state of updateBounds: the drawable entities still without a box (pushed by whoever
+			// adds a RenderComponent, kept while the model loads), the boxed entity of each transform
+			// handle so that only TransformHierarchy::getChanged() is walked, and the refit batch
+			std::vector<Entity> mUnbounded;
+			std::vector<Entity> mBoxOwners;
+			std::vector<uint32_t> mRefitIds;
+			std::vector<lm::aabb> mRefitBoxes;
+
+			Entity create()
+			{
+				if (!mFreeEntities.empty())
+				{
+					const Entity entity = mFreeEntities.back();
+					mFreeEntities.pop_back();
+					return entity;
+				}
+				return mNextEntity++;
+			}
+
+			void destroy(Entity pEntity)
+			{
+				for (std::unique_ptr<IComponentArray>& components : mComponents)
+					if (components != nullptr)
+						components->remove(pEntity);
+				mBVH.remove(pEntity);
+				mFreeEntities.push_back(pEntity);
+			}
+
+			template <class C> C& add(Entity pEntity, const C& pComponent = C())
+			{
+				return components<C>().add(pEntity, pComponent);
+			}
+
+			template <class C> void remove(Entity pEntity)
+			{
+				components<C>().remove(pEntity);
+			}
+
+			template <class C> bool has(Entity pEntity)
+			{
+				return components<C>().has(pEntity);
+			}
+
+			template <class C> C& get(Entity pEntity)
+			{
+				return components<C>().get(pEntity);
+			}
+
+			template <class C> C* tryGet(Entity pEntity)
+			{
+				return components<C>().tryGet(pEntity);
+			}
+
+			template <class C> ComponentArray<C>& components()
+			{
+				const size_t id = typeId<C>();
+				if (id >= mComponents.size())
+					mComponents.resize(id + 1);
+
+				if (mComponents[id] == nullptr)
+					mComponents[id] = std::make_unique<ComponentArray<C>>();
+				return static_cast<ComponentArray<C>&>(*mComponents[id]);
+			}
+
+		private:
+			std::vector<std::unique_ptr<IComponentArray>> mComponents;
+			std::vector<Entity> mFreeEntities;
+			Entity mNextEntity = 0;
+
+			static size_t nextTypeId()
+			{
+				static size_t next = 0;
+				return next++;
+			}
+
+			template <class C> static size_t typeId()
+			{
+				static const size_t id = nextTypeId();
+				return id;
+			}
+	};
+}
@@ -0,0 +1,141 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "ResourceManager.h"
+#include "Prefab.h"
+
+namespace Renderer
+{
+	// Splits the world into square cells on the XZ plane, each with the prefabs placed in it and the
+	// resources they need. update() keeps the cells near the camera instantiated, their resources load
+	// on the pool and are shared between cells. A cell goes once the camera is past the unload radius,
+	// further than the load radius so that a camera moving along a border does not make cells come and go.
+	// When the resources in use would exceed the budget, the cells in between the two radii that share no
+	// resource with the cell to stream in go first, the nearest cells are then streamed in first.
+	class WorldStreamer
+	{
+		public:
+			struct Settings
+			{
+				float mCellSize = 32.f;
+				float mLoadRadius = 64.f;
+				float mUnloadRadius = 96.f;
+				// estimated bytes of the resources in use at once
+				size_t mBudget = SIZE_MAX;
+			};
+
+			// pRetired is the queue of the scene that owns pWorld, what the cells drop goes through it
+			WorldStreamer(World& pWorld, ResourceManager& pResources, RetireQueue& pRetired, const Settings& pSettings);
+			~WorldStreamer();
+
+			// a resource loaded and unloaded with the cells that need it, its slot stays valid for prefabs to
+			// refer to and holds nullptr while it is not loaded. pArgs are kept by reference like
+			// ResourceManager::create does, pBytes counts against the budget
+			template <typename T, typename ...Args> T** addResource(const std::string& pName, size_t pBytes, Args&... pArgs);
+
+			// an instance of pPrefab in the cell under the position of pTransform, made while the cell is
+			// streamed in; the prefab must outlive the streamer
+			void place(const Prefab& pPrefab, const lm::mat4& pTransform);
+
+			// once a frame, before the frame is drawn
+			void update(const lm::vec3& pCamera);
+
+			// every cell and resource unloaded at once, the GPU must be idle and the scene flushes what
+			// went to its queue
+			void clear();
+
+			size_t getResidentBytes() const;
+			size_t getActiveCells() const;
+
+		private:
+			// shared with the load job, which fills the slot under mMutex or, when clear() dropped the
+			// resource while it was loading, deletes what it loaded
+			struct LoadState
+			{
+				std::mutex mMutex;
+				// cleared by the pool once the resource is in its slot
+				std::atomic<bool> mLoading { false };
+				bool mDropped = false;
+			};
+
+			struct Resource
+			{
+				IResource** mSlot = nullptr;
+				std::function<IResource*()> mLoad;
+				size_t mBytes = 0;
+				uint32_t mUsers = 0;
+				std::shared_ptr<LoadState> mState;
+			};
+
+			struct Placement
+			{
+				const Prefab* mPrefab;
+				lm::mat4 mTransform;
+			};
+
+			struct Cell
+			{
+				int32_t mX = 0;
+				int32_t mZ = 0;
+				std::vector<Placement> mPlacements;
+				// indices in mStreamed, each once
+				std::vector<uint32_t> mResources;
+				std::vector<PrefabInstance> mInstances;
+				bool mActive = false;
+			};
+
+			World& mWorld;
+			ResourceManager& mResources;
+			RetireQueue& mRetired;
+			Settings mSettings;
+
+			std::vector<Resource> mStreamed;
+			std::unordered_map<const void*, uint32_t> mSlots;
+			std::unordered_map<uint64_t, Cell> mCells;
+			std::vector<Cell*> mActive;
+			// resources nobody uses any more, unloaded once they are done loading
+			std::vector<uint32_t> mUnused;
+			std::vector<std::pair<float, Cell*>> mWanted;
+			size_t mResidentBytes = 0;
+
+			static uint64_t key(int32_t pX, int32_t pZ);
+			int32_t cellOf(float pCoordinate) const;
+			float distance(const Cell& pCell, const lm::vec3& pCamera) const;
+			size_t missingBytes(const Cell& pCell) const;
+			static bool shares(const Cell& pA, const Cell& pB);
+
+			void activate(Cell& pCell);
+			void deactivate(Cell& pCell);
+			void instantiate(Cell& pCell, const Placement& pPlacement);
+			void acquire(uint32_t pResource);
+			void release(uint32_t pResource);
+			void collect();
+	};
+
+
+	template <typename T, typename ...Args> T** WorldStreamer::addResource(const std::string& pName, size_t pBytes, Args&... pArgs)
+	{
+		if (mResources.mManager.find(pName) != mResources.mManager.end())
+			throw std::runtime_error("streamed resource already in the resource manager!");
+
+		IResource*& slot = mResources.mManager[pName];
+		slot = nullptr;
+
+		Resource resource;
+		resource.mSlot = &slot;
+		resource.mLoad = [&pArgs...]() -> IResource* { return new T(pArgs...); };
+		resource.mBytes = pBytes;
+		resource.mState = std::make_shared<LoadState>();
+
+		mSlots[&slot] = uint32_t(mStreamed.size());
+		mStreamed.push_back(std::move(resource));
+		return (T**)&slot;
+	}
+}
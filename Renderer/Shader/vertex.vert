@@ -23,12 +23,22 @@ layout(set = 1, binding = 0) uniform UniformBufferObject
 {
     mat4 model;
 	mat3 inverseModel;
-    mat4 mvp;
-    vec3 view;
-    mat4 finalBonesMatrices[MAX_BONES];
     bool hasAnimation;
 } ubo;
 
+// set by each view, the objects' blocks are shared by all of them
+layout(push_constant) uniform View
+{
+    mat4 vp;
+    vec3 position;
+} camera;
+
+// only animated objects own a palette, the others bind a shared one that is never read
+layout(set = 3, binding = 0) uniform BonePalette
+{
+    mat4 finalBonesMatrices[MAX_BONES];
+} bones;
+
 
 void main() {
     vec4 totalPosition = vec4(0.0f);
@@ -47,18 +57,18 @@ void main() {
             break;
         }
 
-        vec4 localPosition = ubo.finalBonesMatrices[inBoneIDs[i]] * vec4(inPosition,1.0f);
+        vec4 localPosition = bones.finalBonesMatrices[inBoneIDs[i]] * vec4(inPosition,1.0f);
         totalPosition += localPosition * inWeights[i];
         
-        vec3 localNormal = mat3(ubo.finalBonesMatrices[inBoneIDs[i]]) * norm;
+        vec3 localNormal = mat3(bones.finalBonesMatrices[inBoneIDs[i]]) * norm;
     }
 
-    gl_Position = ubo.mvp * totalPosition;
+    gl_Position = camera.vp * ubo.model * totalPosition;
 
     fragPos = vec3(ubo.model * vec4(inPosition, 1.0));
     norm = mat3(ubo.model) * inNormal;
     UV = inUV;
-    view = ubo.view;
+    view = camera.position;
     fragColor = inColor;
 
     vec3 T = normalize(vec3(ubo.model * vec4(inTangent, 0.0)));
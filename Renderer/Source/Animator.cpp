@@ -1,4 +1,5 @@
 #include "Animator.h"
+#include "Batch/Batch.h"
 
 using namespace Renderer;
 
@@ -18,32 +19,57 @@ void Animator::updateAnimation(float pDeltaTime)
     {
         mCurrentTime += mCurrentAnimation->mTicksPerSecond * pDeltaTime;
         mCurrentTime = std::fmod(mCurrentTime, mCurrentAnimation->mDuration);
+        updateBones();
         calculateBoneTransform(&mCurrentAnimation->mRootNode, lm::mat4(1.0f));
     }
 }
+
+void Animator::updateBones()
+{
+    std::vector<Bone>& bones = mCurrentAnimation->mBones;
+    const size_t count = bones.size();
+
+    mRotationFrom.resize(count);
+    mRotationTo.resize(count);
+    mRotationFactors.resize(count);
+    mRotations.resize(count);
+    mBoneTransforms.resize(count);
+
+    for (size_t i = 0; i < count; i++)
+        mRotationFactors[i] = bones[i].getRotationKeys(mCurrentTime, mRotationFrom[i], mRotationTo[i]);
+
+    lm::batch::interpolate(mRotationFrom.data(), mRotationTo.data(), mRotationFactors.data(), mRotations.data(), count, mInterpolation);
+
+    for (size_t i = 0; i < count; i++)
+        mBoneTransforms[i] = bones[i].getLocalTransform(mCurrentTime, mRotations[i]);
+}
 void Animator::calculateBoneTransform(const AssimpNodeData* pNode, lm::mat4 pParentTransform)
 {
-    std::string nodeName = pNode->mName;
+    const std::string& nodeName = pNode->mName;
     lm::mat4 nodeTransform = pNode->mTransformation;
 
     Bone* Bone = mCurrentAnimation->findBone(nodeName);
 
     if (Bone)
-    {
-        Bone->update(mCurrentTime);
-        nodeTransform = Bone->mLocalTransform;
-    }
+        nodeTransform = mBoneTransforms[Bone - mCurrentAnimation->mBones.data()];
 
     lm::mat4 globalTransformation = pParentTransform * nodeTransform;
 
     std::map<std::string, BoneInfo>& boneInfoMap = mCurrentAnimation->mBoneInfoMap;
-    if (boneInfoMap.find(nodeName) != boneInfoMap.end())
-    {
-        int index = boneInfoMap[nodeName].mId;
-        lm::mat4 offset = boneInfoMap[nodeName].mOffset;
-        mFinalBoneMatrices[index] = globalTransformation * offset;
-    }
+    std::map<std::string, BoneInfo>::const_iterator boneInfo = boneInfoMap.find(nodeName);
+    if (boneInfo != boneInfoMap.end())
+        mFinalBoneMatrices[boneInfo->second.mId] = globalTransformation * boneInfo->second.mOffset;
 
     for (int i = 0; i < pNode->mChildrenCount; i++)
         calculateBoneTransform(&pNode->mChildren[i], globalTransformation);
-}
\ No newline at end of file
+}
+
+void* Animator::operator new(size_t pSize)
+{
+    return Pool<Animator>::shared().allocate();
+}
+
+void Animator::operator delete(void* pObject)
+{
+    Pool<Animator>::deallocate(pObject);
+}
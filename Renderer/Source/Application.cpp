@@ -1,5 +1,6 @@
 #include "Application.h"
 #include "LineDrawer.h"
+#include <iostream>
 
 using namespace Renderer;
 
@@ -7,7 +8,9 @@ Application::Application(const char* pTitle, const unsigned int& pWidth, const u
     mWindow(pTitle, pWidth, pHeight),
     mRenderer(mWindow),
     mCamera(pWidth, pHeight, lm::mat4::perspectiveProjection(-45, float(pWidth) / float(pHeight), 0.01f, 500.f), lm::vec3(-1, 2, 16)),
-    mScene(mRenderer)
+    mOverview(pWidth, pHeight, lm::mat4::perspectiveProjection(-45, float(pWidth) / float(pHeight), 0.01f, 500.f), lm::vec3(0, 120, 0)),
+    mScene(mRenderer, mResources.mPool),
+    mStreamer(mScene.mWorld, mResources, mScene.mRetired, { 16.f, 40.f, 56.f, size_t(64) << 20 })
 {
     mWindow.setWindowUserPointer(this);
     mRenderer.init();
@@ -18,6 +21,12 @@ void Application::keyCallback(int pKey, int pScancode, int pAction, int pMods)
 {
     if (mWindow.getKey(GLFW_KEY_ESCAPE) == GLFW_PRESS)
         mWindow.close();
+
+    if (pKey == GLFW_KEY_F1 && pAction == GLFW_PRESS)
+    {
+        mScene.writeMemoryReport(std::cout);
+        std::cout << "streaming: " << mStreamer.getActiveCells() << " cells in, " << mStreamer.getResidentBytes() << " B of resources in use\n";
+    }
 }
 
 void Application::processInput(const float& pDeltaTime)
@@ -35,26 +44,52 @@ void Application::processInput(const float& pDeltaTime)
         mCamera.processKeyboard(Renderer::CameraMovement::BACKWARD, pDeltaTime);
 }
 
+void Application::mouseButton(int pButton, int pAction, int pMods)
+{
+    if (pButton == GLFW_MOUSE_BUTTON_LEFT && pAction == GLFW_PRESS)
+        pick();
+}
+
+void Application::pick()
+{
+    int width = 0, height = 0;
+    mWindow.getFramebufferSize(&width, &height);
+    if (width == 0 || height == 0)
+        return;
+
+    RayHit hit;
+    const lm::ray ray = mCamera.screenRay(width * 0.5f, height * 0.5f, float(width), float(height));
+    mPicked = mScene.raycast(ray, 500.f, hit);
+    if (mPicked)
+        mPickedPoint = hit.mPoint;
+}
+
 void Application::initScene()
 {
+    mOverview.mPitch = -89.f;
+    mOverview.updateCameraVectors();
+    mOverview.updatePos();
+    mScene.addView(mCamera);
+    mScene.addView(mOverview, 0.7f, 0.05f, 0.25f, 0.25f);
+
     Model** model = mResources.create<Model>("Vempire", mRenderer, "Assets/dancing_vampire.dae");
     mLightShader = mResources.create<Shader>("shad", mRenderer, "Shader/vertex.vert.spv", "Shader/frag.frag.spv");
     Texture** texture3 = mResources.create<Texture>("text3", mRenderer, "Assets/Vampire_diffuse.png");
-    GameObject* obj = new GameObject(mRenderer, mCamera, model, mLightShader, texture3, lm::vec3(0, 0, 0), lm::vec3(0, 180, 0), lm::vec3(1, 1, 1));
-    mScene.addNode(obj);
+    GameObject* obj = mScene.create(mScene.mWorld, model, mLightShader, texture3, lm::vec3(0, 0, 0), lm::vec3(0, 180, 0), lm::vec3(1, 1, 1));
+    mDemoRoot = mScene.addNode(obj);
 
 
     Model** model2 = mResources.create<Model>("room", mRenderer, "Assets/room.obj");
     Texture** texture2 = mResources.create<Texture>("text2", mRenderer, "Assets/room.png");
-    GameObject* obj2 = new GameObject(mRenderer, mCamera, model2, mLightShader, texture2, lm::vec3(0, 0, 5), lm::vec3(90, 0, 0), lm::vec3::unitVal);
-    GameObject* obj4 = new GameObject(mRenderer, mCamera, model2, mLightShader, texture2, lm::vec3(0, 0, -5), lm::vec3(90, 0, 0), lm::vec3::unitVal);
+    GameObject* obj2 = mScene.create(mScene.mWorld, model2, mLightShader, texture2, lm::vec3(0, 0, 5), lm::vec3(90, 0, 0), lm::vec3::unitVal);
+    GameObject* obj4 = mScene.create(mScene.mWorld, model2, mLightShader, texture2, lm::vec3(0, 0, -5), lm::vec3(90, 0, 0), lm::vec3::unitVal);
    
 
 
     Model** model3 = mResources.create<Model>("Turret", mRenderer, "Assets/Turret.obj");
     Texture** texture = mResources.create<Texture>("text1", mRenderer, "Assets/Turret.bmp");
-    GameObject* obj3 = new GameObject(mRenderer, mCamera, model3, mLightShader, texture, lm::vec3(-5, 0, 0), lm::vec3(0, 0, 0), lm::vec3::unitVal);
-    GameObject* obj5 = new GameObject(mRenderer, mCamera, model3, mLightShader, texture, lm::vec3(5, 0, 0), lm::vec3(0, 0, 0), lm::vec3::unitVal);
+    GameObject* obj3 = mScene.create(mScene.mWorld, model3, mLightShader, texture, lm::vec3(-5, 0, 0), lm::vec3(0, 0, 0), lm::vec3::unitVal);
+    GameObject* obj5 = mScene.create(mScene.mWorld, model3, mLightShader, texture, lm::vec3(5, 0, 0), lm::vec3(0, 0, 0), lm::vec3::unitVal);
     
 
     obj->addChild(*obj2);
@@ -63,22 +98,41 @@ void Application::initScene()
     obj->addChild(*obj3);
     obj->addChild(*obj5);
 
+    // a ring of turrets sharing the turret's model and texture
+    Prefab turret;
+    turret.addNode(model3, mLightShader, texture, lm::mat4(1.f));
+    for (int i = 0; i < 12; i++)
+        mScene.instantiate(turret, lm::mat4::yRotation(30.f * i) * lm::mat4::translation(lm::vec3(0, 0, 12)));
+
+    // a field of rooms around the scene, only the cells near the camera are loaded
+    Model** streamedModel = mStreamer.addResource<Model>("room.streamed", 8 << 20, mRenderer, "Assets/room.obj");
+    Texture** streamedTexture = mStreamer.addResource<Texture>("room.streamed.texture", 4 << 20, mRenderer, "Assets/room.png");
+    mStreamedRoom.addNode(streamedModel, mLightShader, streamedTexture, lm::mat4::xRotation(90));
+    for (int x = -10; x <= 10; x++)
+        for (int z = -10; z <= 10; z++)
+            if (std::abs(x) > 2 || std::abs(z) > 2)
+                mStreamer.place(mStreamedRoom, lm::mat4::translation(lm::vec3(x * 12.f, -4.f, z * 12.f)));
+
 
     mScene.addLight((new DirectionalLight(lm::vec3(0, -1, -1))));
 }
 
 void Application::updateDemo(float pDeltaTime)
 {
-    if (*mScene.mGameObjects[0]->mModel != nullptr)
-        mScene.mGameObjects[0]->mLocal = mScene.mGameObjects[0]->mLocal * lm::mat4::yRotation(45 * pDeltaTime);
+    GameObject* root = mScene.getNode(mDemoRoot);
+    if (root == nullptr)
+        return;
+
+    if (*root->getModel() != nullptr)
+        root->setLocal(root->getLocal() * lm::mat4::yRotation(45 * pDeltaTime));
 
     int pair = 0;
-    for (std::list<GameObject*>::iterator it = mScene.mGameObjects[0]->mChilds.begin(); it != mScene.mGameObjects[0]->mChilds.end(); it++)
+    for (GameObject* child : root->mChilds)
     {
         if (pair & 1)
-            (*it)->mLocal = (*it)->mLocal * lm::mat4::yRotation(-150 * pDeltaTime);
+            child->setLocal(child->getLocal() * lm::mat4::yRotation(-150 * pDeltaTime));
         else
-            (*it)->mLocal = (*it)->mLocal * lm::mat4::xRotation(-150 * pDeltaTime);
+            child->setLocal(child->getLocal() * lm::mat4::xRotation(-150 * pDeltaTime));
 
         pair = (pair + 1) & 1;
     }
@@ -101,18 +155,26 @@ void Application::run()
 
         processInput(time.mDeltaTime);
         mCamera.updatePos();
+        mStreamer.update(mCamera.mPosition);
         mScene.update(time.mDeltaTime);
 
+        updateDemo(time.mDeltaTime);
+
+        mScene.cull();
+
+        mRenderer.beginDraw();
 
         lineDrawer.reset();
         lineDrawer.drawLine(lm::vec3(0, 0, 0), lm::vec3(-10, 0, 0), lm::vec3(1, 0, 0));
         lineDrawer.drawLine(lm::vec3(0, 0, 0), lm::vec3(0, 0, 10), lm::vec3(0, 0, 1));
         lineDrawer.drawLine(lm::vec3(0, 0, 0), lm::vec3(0, 10, 0), lm::vec3(0, 1, 0));
+        if (mPicked)
+        {
+            lineDrawer.drawLine(mPickedPoint - lm::vec3(0.2f, 0, 0), mPickedPoint + lm::vec3(0.2f, 0, 0), lm::vec3(1, 1, 0));
+            lineDrawer.drawLine(mPickedPoint - lm::vec3(0, 0.2f, 0), mPickedPoint + lm::vec3(0, 0.2f, 0), lm::vec3(1, 1, 0));
+            lineDrawer.drawLine(mPickedPoint - lm::vec3(0, 0, 0.2f), mPickedPoint + lm::vec3(0, 0, 0.2f), lm::vec3(1, 1, 0));
+        }
 
-        updateDemo(time.mDeltaTime);
-
-
-        mRenderer.beginDraw();
         if ((mLightShader != nullptr && (*mLightShader) != nullptr))
             mScene.sendLight(*(*mLightShader));
         
@@ -126,6 +188,7 @@ void Application::run()
     mWindow.shutDown();
     mResources.mPool.stop();
     mRenderer.finishSetup();
+    mStreamer.clear();
     mResources.clear();
     mScene.clear();
 }
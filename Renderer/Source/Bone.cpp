@@ -45,10 +45,18 @@ Bone::Bone(const std::string& pName, int pId, const aiNodeAnim* pChannel) :
 
 void Bone::update(float pAnimationTime)
 {
-    lm::mat4 translation = interpolatePosition(pAnimationTime);
-    lm::mat4 rotation = interpolateRotation(pAnimationTime);
-    lm::mat4 scale = interpolateScaling(pAnimationTime);
-    mLocalTransform = translation * rotation * scale;
+    update(pAnimationTime, interpolateRotation(pAnimationTime));
+}
+
+void Bone::update(float pAnimationTime, const lm::quat& pRotation)
+{
+    mLocalTransform = getLocalTransform(pAnimationTime, pRotation);
+}
+
+lm::mat4 Bone::getLocalTransform(float pAnimationTime, const lm::quat& pRotation)
+{
+    lm::transform local(interpolatePosition(pAnimationTime), pRotation, interpolateScaling(pAnimationTime));
+    return local.toMat4();
 }
 
 int Bone::getPositionIndex(float pAnimationTime)
@@ -84,44 +92,53 @@ float Bone::getScaleFactor(float pLastTimeStamp, float pNextTimeStamp, float pAn
     return scaleFactor;
 }
 
-lm::mat4 Bone::interpolatePosition(float pAnimationTime)
+lm::vec3 Bone::interpolatePosition(float pAnimationTime)
 {
     if (1 == mNumPositions)
-        return lm::mat4::translation(mPositions[0].mPosition);
+        return mPositions[0].mPosition;
 
     int p0Index = getPositionIndex(pAnimationTime);
     int p1Index = p0Index + 1;
     float scaleFactor = getScaleFactor(mPositions[p0Index].mTimeStamp, mPositions[p1Index].mTimeStamp, pAnimationTime);
-    lm::vec3 finalPosition = lm::vec3::lerp(mPositions[p0Index].mPosition, mPositions[p1Index].mPosition, scaleFactor);
-    return lm::mat4::translation(finalPosition);
+    return lm::vec3::lerp(mPositions[p0Index].mPosition, mPositions[p1Index].mPosition, scaleFactor);
 }
 
-lm::mat4 Bone::interpolateRotation(float pAnimationTime)
+lm::quat Bone::interpolateRotation(float pAnimationTime)
 {
     if (1 == mNumRotations)
-    {
-        lm::quat rotation = mRotations[0].mOrientation;
-        return rotation.toMat4();
-    }
+        return mRotations[0].mOrientation;
 
     
     int p0Index = getRotationIndex(pAnimationTime);
     int p1Index = p0Index + 1;
     float scaleFactor = getScaleFactor(mRotations[p0Index].mTimeStamp, mRotations[p1Index].mTimeStamp, pAnimationTime);
-    lm::quat finalRotation = lm::quat::slerp(mRotations[p0Index].mOrientation, mRotations[p1Index].mOrientation, scaleFactor);
-    return finalRotation.toMat4();
+    return lm::quat::slerp(mRotations[p0Index].mOrientation, mRotations[p1Index].mOrientation, scaleFactor);
+}
+
+float Bone::getRotationKeys(float pAnimationTime, lm::quat& pFrom, lm::quat& pTo)
+{
+    if (1 == mNumRotations)
+    {
+        pFrom = pTo = mRotations[0].mOrientation;
+        return 0;
+    }
+
+    int p0Index = getRotationIndex(pAnimationTime);
+    int p1Index = p0Index + 1;
+    pFrom = mRotations[p0Index].mOrientation;
+    pTo = mRotations[p1Index].mOrientation;
+    return getScaleFactor(mRotations[p0Index].mTimeStamp, mRotations[p1Index].mTimeStamp, pAnimationTime);
 }
 
-lm::mat4 Bone::interpolateScaling(float pAnimationTime)
+lm::vec3 Bone::interpolateScaling(float pAnimationTime)
 {
     if (1 == mNumScalings)
-        return lm::mat4::scale(mScales[0].mScale);
+        return mScales[0].mScale;
 
     int p0Index = getScaleIndex(pAnimationTime);
     int p1Index = p0Index + 1;
     float scaleFactor = getScaleFactor(mScales[p0Index].mTimeStamp, mScales[p1Index].mTimeStamp, pAnimationTime);
-    lm::vec3 finalScale = lm::vec3::lerp(mScales[p0Index].mScale, mScales[p1Index].mScale, scaleFactor);
-    return lm::mat4::scale(finalScale);
+    return lm::vec3::lerp(mScales[p0Index].mScale, mScales[p1Index].mScale, scaleFactor);
 }
 
 lm::vec3 Bone::getVec(const aiVector3D& pVec)
@@ -80,8 +80,18 @@ void Renderer::Camera::processKeyboard(CameraMovement pDirection, float pDeltaTi
         mPosition -= mRight * velocity;
 }
 
+lm::ray Renderer::Camera::screenRay(float pX, float pY, float pWidth, float pHeight) const
+{
+    // the viewport puts -1 at the top, any depth between the planes gives the same direction
+    const lm::vec4 ndc(2.f * pX / pWidth - 1.f, 2.f * pY / pHeight - 1.f, 0.5f, 1.f);
+    const lm::vec4 point = lm::mat4(mVp).inverse() * ndc;
+    const lm::vec3 target(point.X() / point.W(), point.Y() / point.W(), point.Z() / point.W());
+    return lm::ray::fromPoints(mPosition, target);
+}
+
 void Renderer::Camera::updatePos()
 {
 	mView = lm::mat4::lookAt(mPosition, mPosition + mForward, mUp);
 	mVp = mProjection * mView;
+	mFrustum = lm::frustum::fromMatrix(mVp);
 }
\ No newline at end of file
@@ -1,32 +1,48 @@
 #include "GameObject.h"
+#include "Systems.h"
 
 using namespace Renderer;
 
-GameObject::GameObject(VKRenderer& pRenderer, Camera& pCamera, Model** pModel, Shader** pShader, Texture** pTexture, const lm::vec3& pPosition, const lm::vec3& pRotation, const lm::vec3& pScale) :
-	mRenderer(pRenderer),
-	mV(&pCamera.mPosition),
-	mVP(&pCamera.mVp),
-	mModel(pModel),
-	mShader(pShader),
-	mTexture(pTexture),
-	mLocal(lm::mat4::createTransformMatrix(pPosition, pRotation, pScale)),
-	mGlobal(mLocal),
+GameObject::GameObject(World& pWorld, Model** pModel, Shader** pShader, Texture** pTexture, const lm::vec3& pPosition, const lm::vec3& pRotation, const lm::vec3& pScale) :
+	mWorld(pWorld),
+	mEntity(pWorld.create()),
+	mTransform(pWorld.mTransforms.create(lm::transform::fromEuler(pPosition, pRotation, pScale).toMat4())),
 	mPosition(pPosition),
 	mRotation(pRotation),
-	mScale(pScale),
-	mUniBuffer(mRenderer)
+	mScale(pScale)
 {
-	mUniBuffer.init(sizeof(UniformBufferObject), VK_SHADER_STAGE_VERTEX_BIT);
+	RenderComponent& renderable = mWorld.add<RenderComponent>(mEntity);
+	renderable.mModel = pModel;
+	renderable.mShader = pShader;
+	renderable.mTexture = pTexture;
+	renderable.mTransform = mTransform;
+	mWorld.mUnbounded.push_back(mEntity);
+
+	mWorld.add<AnimationComponent>(mEntity).mModel = pModel;
 }
 
 GameObject::~GameObject()
 {
-	for (std::list<GameObject*>::iterator it = mChilds.begin(); it != mChilds.end(); it++)
-		delete* it;
+	for (GameObject* child : mChilds)
+		delete child;
 	mChilds.clear();
 
-	if (mAnimator != nullptr)
-		delete mAnimator;
+	const AnimationComponent& animation = mWorld.get<AnimationComponent>(mEntity);
+	delete animation.mAnimator;
+	delete animation.mBones;
+
+	mWorld.destroy(mEntity);
+	mWorld.mTransforms.destroy(mTransform);
+}
+
+void* GameObject::operator new(size_t pSize)
+{
+	return Pool<GameObject>::shared().allocate();
+}
+
+void GameObject::operator delete(void* pObject)
+{
+	Pool<GameObject>::deallocate(pObject);
 }
 
 void GameObject::addChild(GameObject& pChild)
@@ -38,14 +54,16 @@ void GameObject::addChild(GameObject& pChild)
 		pChild.mParent->removeChild(pChild);
 
 	pChild.mParent = this;
+	pChild.mChildIndex = uint32_t(mChilds.size());
 	mChilds.push_back(&pChild);
+	mWorld.mTransforms.setParent(pChild.mTransform, mTransform);
 
 
 	lm::vec3 scale = getGlobalScale(*this, lm::vec3(1, 1, 1));
 	pChild.mScale = lm::vec3(pChild.mScale.X() / scale.X(), pChild.mScale.Y() / scale.Y(), pChild.mScale.Z() / scale.Z());
 	pChild.mPosition = lm::vec3((pChild.mPosition.X() - mPosition.X()) / scale.X(), (pChild.mPosition.Y() - mPosition.Y()) / scale.Y(), (pChild.mPosition.Z() - mPosition.Z()) / scale.Z());
-	pChild.updateLocal();
-	updateGlobal();
+	// the globals follow on the next Scene::update, which re-sorts the hierarchy once for all the changes
+	pChild.setLocal(pChild.getLocalTransform().toMat4());
 }
 
 void GameObject::removeChild(GameObject& pChild)
@@ -54,82 +72,58 @@ void GameObject::removeChild(GameObject& pChild)
 		return;
 
 	pChild.mParent = nullptr;
-	mChilds.remove(&pChild);
+	GameObject* last = mChilds.back();
+	mChilds[pChild.mChildIndex] = last;
+	last->mChildIndex = pChild.mChildIndex;
+	mChilds.pop_back();
+	mWorld.mTransforms.setParent(pChild.mTransform, TransformHierarchy::INVALID);
 
 
 	lm::vec3 scale = getGlobalScale(*this, lm::vec3(1, 1, 1));
 	pChild.mScale = lm::vec3(pChild.mScale.X() * scale.X(), pChild.mScale.Y() * scale.Y(), pChild.mScale.Z() * scale.Z());
 	pChild.mPosition = lm::vec3((pChild.mPosition.X() * scale.X()) + mPosition.X(), (pChild.mPosition.Y() * scale.Y()) + mPosition.Y(), (pChild.mPosition.Z() * scale.Z()) + mPosition.Z());
-	pChild.updateLocal();
-	updateGlobal();
+	pChild.setLocal(pChild.getLocalTransform().toMat4());
 }
 
 void GameObject::updateGlobal()
 {
-	if (mParent != nullptr)
-		mGlobal = mParent->mGlobal * mLocal;
-	else
-		mGlobal = mLocal;
-
-	for (std::list<GameObject*>::iterator it = mChilds.begin(); it != mChilds.end(); it++)
-		(*it)->updateGlobal();
+	mWorld.mTransforms.update(mTransform);
 }
 
 void GameObject::updateLocal()
 {
-	mLocal = lm::mat4::createTransformMatrix(mPosition, mRotation, mScale);
+	mWorld.mTransforms.setLocal(mTransform, getLocalTransform().toMat4());
 	updateGlobal();
 }
 
-void GameObject::update(float pDeltaTime)
+const lm::mat4& GameObject::getLocal() const
 {
-	if (pDeltaTime == 0)
-		return;
-
-	if (mModel != nullptr && *mModel != nullptr && (*mModel)->mAnimation != nullptr)
-	{
-		if (mAnimator == nullptr)
-			mAnimator = new Animator((*mModel)->mAnimation);
-		else
-			mAnimator->updateAnimation(pDeltaTime);
-	}
-
-	updateGlobal();
+	return mWorld.mTransforms.getLocal(mTransform);
 }
 
-void GameObject::draw()
+void GameObject::setLocal(const lm::mat4& pLocal)
 {
-	for (std::list<GameObject*>::iterator it = mChilds.begin(); it != mChilds.end(); it++)
-		(*it)->draw();
-
-	if (*mShader == nullptr || *mModel == nullptr)
-		return;
-
-	(*mShader)->bind();
-
-	if (mTexture != nullptr && *mTexture != nullptr)
-		(*mShader)->setTexture((*mTexture)->mTextureSets[mRenderer.mCurrentFrame]);
+	mWorld.mTransforms.setLocal(mTransform, pLocal);
+}
 
-	
-	mData.mModel = mGlobal;
-	mData.mInverseModel = lm::mat3(mGlobal).inverse().transpose();
-	mData.mVP = (*mVP) * mGlobal;
-	mData.mView = (*mV);
+const lm::mat4& GameObject::getGlobal() const
+{
+	return mWorld.mTransforms.getWorld(mTransform);
+}
 
-	if (mAnimator != nullptr)
-	{
-		std::vector<lm::mat4>& transforms = mAnimator->mFinalBoneMatrices;
-		for (int i = 0; i < transforms.size(); ++i)
-			mData.mFinalBonesMatrices[i] = transforms[i];
+Model** GameObject::getModel() const
+{
+	return mWorld.get<RenderComponent>(mEntity).mModel;
+}
 
-		mData.mHasAnimation = true;
-	}
-	else
-		mData.mHasAnimation = false;
+Animator* GameObject::getAnimator() const
+{
+	return mWorld.get<AnimationComponent>(mEntity).mAnimator;
+}
 
-	(*mShader)->setMVP(mUniBuffer.mDescriptorSets[mRenderer.mCurrentFrame], mUniBuffer.mUniformBuffersMapped[mRenderer.mCurrentFrame], &mData, sizeof(UniformBufferObject));
-	
-	(*mModel)->draw(*(*mShader));
+lm::transform GameObject::getLocalTransform() const
+{
+	return lm::transform::fromEuler(mPosition, mRotation, mScale);
 }
 
 lm::vec3 GameObject::getGlobalScale(const GameObject& pObj, lm::vec3& pScale)
@@ -29,7 +29,7 @@ std::array<VkVertexInputAttributeDescription, 2> DebugVertex::getAttributeDescri
 }
 
 LineDrawer::LineDrawer(Camera& pCamera, VKRenderer& pRenderer, const char* pVertex, const char* pFragment)
-    : mCamera(pCamera), mRenderer(pRenderer), mUniBuffer(mRenderer)
+    : mCamera(pCamera), mRenderer(pRenderer), mLineVertice(pRenderer.mFrameArenas.allocator<DebugVertex>()), mUniBuffer(mRenderer)
 {
 	createDescriptorSetLayout();
     mUniBuffer.init(sizeof(lm::mat4), VK_SHADER_STAGE_VERTEX_BIT);
@@ -280,4 +280,6 @@ void LineDrawer::reset()
 
     vkFreeMemory(mRenderer.mDevice, mVertexBufferMemory, nullptr);
     mVertexBufferMemory = nullptr;
+
+    mLineVertice = FrameVector<DebugVertex>(mRenderer.mFrameArenas.allocator<DebugVertex>());
 }
\ No newline at end of file
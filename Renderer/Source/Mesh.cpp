@@ -137,4 +137,14 @@ Mesh::~Mesh()
 
     vkDestroyBuffer(mRenderer.mDevice, mVertexBuffer, nullptr);
     vkFreeMemory(mRenderer.mDevice, mVertexBufferMemory, nullptr);
-}
\ No newline at end of file
+}
+
+void* Mesh::operator new(size_t pSize)
+{
+    return Pool<Mesh>::shared().allocate();
+}
+
+void Mesh::operator delete(void* pObject)
+{
+    Pool<Mesh>::deallocate(pObject);
+}
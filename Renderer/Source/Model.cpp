@@ -82,6 +82,7 @@ void Model::processMesh(const aiMesh* pMesh, const aiScene* pScene)
         vector.Y() = pMesh->mVertices[i].y;
         vector.Z() = pMesh->mVertices[i].z;
         vertex.mPosition = vector;
+        mBounds.expand(vector);
         
         // normals
         if (pMesh->HasNormals())
@@ -126,6 +127,9 @@ void Model::processMesh(const aiMesh* pMesh, const aiScene* pScene)
         aiFace face = pMesh->mFaces[i];
         for (unsigned int j = 0; j < face.mNumIndices; j++)
             indices.push_back(face.mIndices[j]);
+
+        if (face.mNumIndices == 3)
+            mCollision.add(vertices[face.mIndices[0]].mPosition, vertices[face.mIndices[1]].mPosition, vertices[face.mIndices[2]].mPosition);
     }
 
     extractBoneWeightForVertices(vertices, pMesh, pScene);
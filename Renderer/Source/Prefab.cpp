@@ -0,0 +1,82 @@
+#include "Prefab.h"
+#include "GameObject.h"
+#include <stdexcept>
+
+using namespace Renderer;
+
+uint32_t Prefab::addNode(Model** pModel, Shader** pShader, Texture** pTexture, const lm::mat4& pLocal, uint32_t pParent)
+{
+	if (mNodes.empty() ? pParent != NO_PARENT : pParent >= mNodes.size())
+		throw std::runtime_error("prefab node needs a parent added before it, the root none!");
+
+	Node node;
+	node.mModel = pModel;
+	node.mShader = pShader;
+	node.mTexture = pTexture;
+	node.mLocal = pLocal;
+	node.mParent = pParent;
+	mNodes.push_back(node);
+	return uint32_t(mNodes.size() - 1);
+}
+
+const std::vector<Prefab::Node>& Prefab::getNodes() const
+{
+	return mNodes;
+}
+
+Prefab Prefab::fromObject(const GameObject& pRoot)
+{
+	Prefab prefab;
+	std::vector<std::pair<const GameObject*, uint32_t>> stack = { { &pRoot, NO_PARENT } };
+	while (!stack.empty())
+	{
+		const GameObject* object = stack.back().first;
+		const uint32_t parent = stack.back().second;
+		stack.pop_back();
+
+		const RenderComponent& renderable = object->mWorld.get<RenderComponent>(object->mEntity);
+		const uint32_t node = prefab.addNode(renderable.mModel, renderable.mShader, renderable.mTexture, parent == NO_PARENT ? lm::mat4(1.f) : object->getLocal(), parent);
+
+		for (const GameObject* child : object->mChilds)
+			stack.push_back({ child, node });
+	}
+	return prefab;
+}
+
+void Renderer::instantiatePrefab(World& pWorld, const Prefab& pPrefab, const lm::mat4& pTransform, PrefabInstance& pInstance)
+{
+	const std::vector<Prefab::Node>& nodes = pPrefab.getNodes();
+	pInstance.mParts.resize(nodes.size());
+
+	for (size_t i = 0; i < nodes.size(); i++)
+	{
+		const Prefab::Node& node = nodes[i];
+		PrefabInstance::Part& part = pInstance.mParts[i];
+		part.mEntity = pWorld.create();
+		part.mTransform = pWorld.mTransforms.create(node.mParent == Prefab::NO_PARENT ? pTransform : node.mLocal);
+		if (node.mParent != Prefab::NO_PARENT)
+			pWorld.mTransforms.setParent(part.mTransform, pInstance.mParts[node.mParent].mTransform);
+
+		RenderComponent& renderable = pWorld.add<RenderComponent>(part.mEntity);
+		renderable.mModel = node.mModel;
+		renderable.mShader = node.mShader;
+		renderable.mTexture = node.mTexture;
+		renderable.mTransform = part.mTransform;
+		pWorld.mUnbounded.push_back(part.mEntity);
+
+		pWorld.add<AnimationComponent>(part.mEntity).mModel = node.mModel;
+	}
+}
+
+void Renderer::destroyPrefabInstance(World& pWorld, PrefabInstance& pInstance, RetireQueue& pRetired)
+{
+	for (const PrefabInstance::Part& part : pInstance.mParts)
+	{
+		const AnimationComponent& animation = pWorld.get<AnimationComponent>(part.mEntity);
+		pRetired.retire(animation.mBones, animation.mAnimator);
+
+		pWorld.destroy(part.mEntity);
+		pWorld.mTransforms.destroy(part.mTransform);
+	}
+	pInstance.mParts.clear();
+}
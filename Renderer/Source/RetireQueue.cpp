@@ -0,0 +1,53 @@
+#include "RetireQueue.h"
+#include "ResourceManager.h"
+#include "UniformBuffer.h"
+#include "Animator.h"
+
+using namespace Renderer;
+
+RetireQueue::~RetireQueue()
+{
+	flush();
+}
+
+void RetireQueue::retire(UniformBuffer* pBones, Animator* pAnimator)
+{
+	if (pBones != nullptr || pAnimator != nullptr)
+		mRetired.push_back({ mFrame, nullptr, pBones, pAnimator });
+}
+
+void RetireQueue::retire(IResource* pResource)
+{
+	if (pResource != nullptr)
+		mRetired.push_back({ mFrame, pResource, nullptr, nullptr });
+}
+
+void RetireQueue::advance()
+{
+	mFrame++;
+	for (size_t i = 0; i < mRetired.size();)
+	{
+		if (mFrame > mRetired[i].mFrame + VKRenderer::MAX_FRAMES_IN_FLIGHT)
+		{
+			destroy(mRetired[i]);
+			mRetired[i] = mRetired.back();
+			mRetired.pop_back();
+		}
+		else
+			i++;
+	}
+}
+
+void RetireQueue::flush()
+{
+	for (const Retired& retired : mRetired)
+		destroy(retired);
+	mRetired.clear();
+}
+
+void RetireQueue::destroy(const Retired& pRetired)
+{
+	delete pRetired.mResource;
+	delete pRetired.mBones;
+	delete pRetired.mAnimator;
+}
@@ -0,0 +1,93 @@
+#include "SceneQuery.h"
+#include "Model.h"
+#include <algorithm>
+
+using namespace Renderer;
+
+bool Renderer::raycastEntity(World& pWorld, ComponentArray<RenderComponent>& pRenderables, Entity pEntity, const lm::ray& pRay, float& pMaxDistance, uint32_t& pTriangle)
+{
+	const RenderComponent* renderable = pRenderables.tryGet(pEntity);
+	if (renderable == nullptr || *renderable->mModel == nullptr)
+		return false;
+
+	// the direction is not normalized again, so a distance in model space is the same in world space
+	const CollisionMesh& collision = (*renderable->mModel)->mCollision;
+	const lm::ray local = pRay.transform(pWorld.mTransforms.getWorld(renderable->mTransform).affineInverse());
+	const size_t triangle = collision.raycast(local, pMaxDistance);
+	if (triangle == collision.size())
+		return false;
+
+	pTriangle = uint32_t(triangle);
+	return true;
+}
+
+bool Renderer::raycast(World& pWorld, const lm::ray& pRay, float pMaxDistance, RayHit& pHit)
+{
+	ComponentArray<RenderComponent>& renderables = pWorld.components<RenderComponent>();
+
+	pHit = RayHit();
+	pHit.mDistance = pMaxDistance;
+
+	// a box further than the nearest triangle so far is not opened
+	pWorld.mBVH.raycast(pRay, pMaxDistance, [&pWorld, &renderables, &pRay, &pHit](const uint32_t pEntity, const float)
+		{
+			if (raycastEntity(pWorld, renderables, pEntity, pRay, pHit.mDistance, pHit.mTriangle))
+				pHit.mEntity = pEntity;
+			return pHit.mDistance;
+		});
+
+	if (pHit.mEntity == INVALID_ENTITY)
+		return false;
+
+	pHit.mPoint = pRay.at(pHit.mDistance);
+	return true;
+}
+
+void Renderer::raycastAll(World& pWorld, const lm::ray& pRay, float pMaxDistance, std::vector<RayHit>& pHits)
+{
+	ComponentArray<RenderComponent>& renderables = pWorld.components<RenderComponent>();
+
+	pHits.clear();
+	pWorld.mBVH.raycast(pRay, pMaxDistance, [&pWorld, &renderables, &pRay, &pHits, pMaxDistance](const uint32_t pEntity, const float)
+		{
+			RayHit hit;
+			hit.mDistance = pMaxDistance;
+			if (raycastEntity(pWorld, renderables, pEntity, pRay, hit.mDistance, hit.mTriangle))
+			{
+				hit.mEntity = pEntity;
+				hit.mPoint = pRay.at(hit.mDistance);
+				pHits.push_back(hit);
+			}
+			return pMaxDistance;
+		});
+
+	// the boxes come front to back, the triangles in them do not have to
+	std::sort(pHits.begin(), pHits.end(), [](const RayHit& pA, const RayHit& pB) { return pA.mDistance < pB.mDistance; });
+}
+
+void Renderer::raycast(World& pWorld, ThreadPool& pPool, const lm::ray* pRays, size_t pCount, float pMaxDistance, RayHit* pHits)
+{
+	// looked up before the workers start, components() may create the array
+	ComponentArray<RenderComponent>& renderables = pWorld.components<RenderComponent>();
+
+	pPool.parallelFor(pCount, 64, [&pWorld, &renderables, pRays, pMaxDistance, pHits](size_t pBegin, size_t pEnd)
+		{
+			for (size_t i = pBegin; i < pEnd; i++)
+			{
+				RayHit& hit = pHits[i];
+				hit = RayHit();
+				hit.mDistance = pMaxDistance;
+
+				const lm::ray& ray = pRays[i];
+				pWorld.mBVH.raycast(ray, pMaxDistance, [&pWorld, &renderables, &ray, &hit](const uint32_t pEntity, const float)
+					{
+						if (raycastEntity(pWorld, renderables, pEntity, ray, hit.mDistance, hit.mTriangle))
+							hit.mEntity = pEntity;
+						return hit.mDistance;
+					});
+
+				if (hit.mEntity != INVALID_ENTITY)
+					hit.mPoint = ray.at(hit.mDistance);
+			}
+		});
+}
@@ -71,8 +71,8 @@ void Shader::createDescriptorSetLayout()
 
     mGlobalSetLayout = mRenderer.mDescriptorLayoutCache->createDescriptorLayout(&setinfo);
 
-    //MVP
-    VkDescriptorSetLayoutBinding uboLayoutBinding = builder.descriptorsetLayoutBinding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_VERTEX_BIT, 0);
+    //MVP, a block of the scene's DynamicUniformBuffer
+    VkDescriptorSetLayoutBinding uboLayoutBinding = builder.descriptorsetLayoutBinding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, VK_SHADER_STAGE_VERTEX_BIT, 0);
     VkDescriptorSetLayoutCreateInfo set2info = {};
     set2info.bindingCount = 1;
     set2info.flags = 0;
@@ -82,6 +82,17 @@ void Shader::createDescriptorSetLayout()
 
     mObjectSetLayout = mRenderer.mDescriptorLayoutCache->createDescriptorLayout(&set2info);
 
+    //Bones
+    VkDescriptorSetLayoutBinding bonesLayoutBinding = builder.descriptorsetLayoutBinding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_VERTEX_BIT, 0);
+    VkDescriptorSetLayoutCreateInfo set4info = {};
+    set4info.bindingCount = 1;
+    set4info.flags = 0;
+    set4info.pNext = nullptr;
+    set4info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    set4info.pBindings = &bonesLayoutBinding;
+
+    mBonesSetLayout = mRenderer.mDescriptorLayoutCache->createDescriptorLayout(&set4info);
+
     //Texture
     VkDescriptorSetLayoutBinding textureBind = builder.descriptorsetLayoutBinding(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT, 0);
     VkDescriptorSetLayoutCreateInfo set3info = {};
@@ -187,12 +198,20 @@ void Shader::createGraphicsPipeline(const char* pVertex, const char* pFragment)
     dynamicState.pDynamicStates = dynamicStates.data();
 
 
-    VkDescriptorSetLayout setLayouts[] = { mGlobalSetLayout, mObjectSetLayout, mSingleTextureSetLayout };
+    // the bone palette is one more uniform buffer of the vertex stage, laid out like the object set
+    VkDescriptorSetLayout setLayouts[] = { mGlobalSetLayout, mObjectSetLayout, mSingleTextureSetLayout, mBonesSetLayout };
     VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
     pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-    pipelineLayoutInfo.setLayoutCount = 3;
+    pipelineLayoutInfo.setLayoutCount = 4;
     pipelineLayoutInfo.pSetLayouts = setLayouts;
 
+    VkPushConstantRange viewRange{};
+    viewRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+    viewRange.offset = 0;
+    viewRange.size = VIEW_CONSTANTS_BYTES;
+    pipelineLayoutInfo.pushConstantRangeCount = 1;
+    pipelineLayoutInfo.pPushConstantRanges = &viewRange;
+
     if (vkCreatePipelineLayout(mRenderer.mDevice, &pipelineLayoutInfo, nullptr, &mPipelineLayout) != VK_SUCCESS)
         throw std::runtime_error("failed to create pipeline layout!");
 
@@ -234,10 +253,19 @@ void Shader::setLight(VkDescriptorSet* pDescriptor, void* pUniformBuffer, void*
     memcpy(pUniformBuffer, pData, pSize);
 }
 
-void Shader::setMVP(const VkDescriptorSet& pDescriptor, void* pUniformBuffer, void* pData, size_t pSize)
+void Shader::setMVP(const VkDescriptorSet& pDescriptor, uint32_t pOffset)
 {
-    vkCmdBindDescriptorSets(mRenderer.mCommandBuffers[mRenderer.mCurrentFrame], VK_PIPELINE_BIND_POINT_GRAPHICS, mPipelineLayout, 1, 1, &pDescriptor, 0, nullptr);
-    memcpy(pUniformBuffer, pData, pSize);
+    vkCmdBindDescriptorSets(mRenderer.mCommandBuffers[mRenderer.mCurrentFrame], VK_PIPELINE_BIND_POINT_GRAPHICS, mPipelineLayout, 1, 1, &pDescriptor, 1, &pOffset);
+}
+
+void Shader::setBones(const VkDescriptorSet& pDescriptor)
+{
+    vkCmdBindDescriptorSets(mRenderer.mCommandBuffers[mRenderer.mCurrentFrame], VK_PIPELINE_BIND_POINT_GRAPHICS, mPipelineLayout, 3, 1, &pDescriptor, 0, nullptr);
+}
+
+void Shader::setView(const void* pData, uint32_t pSize)
+{
+    vkCmdPushConstants(mRenderer.mCommandBuffers[mRenderer.mCurrentFrame], mPipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, pSize, pData);
 }
 
 void Shader::setTexture(const VkDescriptorSet& pDescriptor)
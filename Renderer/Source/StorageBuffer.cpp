@@ -31,8 +31,8 @@ StorageBuffer::~StorageBuffer()
 void StorageBuffer::createStorageBuffers()
 {
 	VkDeviceSize bufferSize1 = mRenderer.padStorageBufferSize(sizeof(DirLights));
-	VkDeviceSize bufferSize2 = mRenderer.padStorageBufferSize(sizeof(PointLight));
-	VkDeviceSize bufferSize3 = mRenderer.padStorageBufferSize(sizeof(SpotLight));
+	VkDeviceSize bufferSize2 = mRenderer.padStorageBufferSize(sizeof(PointLights));
+	VkDeviceSize bufferSize3 = mRenderer.padStorageBufferSize(sizeof(SpotLights));
 
 	VkDeviceSize bufferSize = bufferSize1 + bufferSize2 + bufferSize3;
 
@@ -65,8 +65,8 @@ void StorageBuffer::createStorageBuffers()
 void StorageBuffer::createDescriptor(VkShaderStageFlagBits pStage)
 {
 	VkDeviceSize bufferSize1 = mRenderer.padStorageBufferSize(sizeof(DirLights));
-	VkDeviceSize bufferSize2 = mRenderer.padStorageBufferSize(sizeof(PointLight));
-	VkDeviceSize bufferSize3 = mRenderer.padStorageBufferSize(sizeof(SpotLight));
+	VkDeviceSize bufferSize2 = mRenderer.padStorageBufferSize(sizeof(PointLights));
+	VkDeviceSize bufferSize3 = mRenderer.padStorageBufferSize(sizeof(SpotLights));
 
 	DescriptorSets.resize(VKRenderer::MAX_FRAMES_IN_FLIGHT);
 	for (size_t i = 0; i < VKRenderer::MAX_FRAMES_IN_FLIGHT; i++)
@@ -0,0 +1,246 @@
+#include "Systems.h"
+#include "UniformBuffer.h"
+#include "Batch/Batch.h"
+#include <algorithm>
+
+using namespace Renderer;
+
+void Renderer::updateAnimations(World& pWorld, ThreadPool& pPool, float pDeltaTime)
+{
+	if (pDeltaTime == 0)
+		return;
+
+	std::vector<AnimationComponent>& animations = pWorld.components<AnimationComponent>().mData;
+	pPool.parallelFor(animations.size(), 16, [&animations, pDeltaTime](size_t pBegin, size_t pEnd)
+		{
+			for (size_t i = pBegin; i < pEnd; i++)
+			{
+				AnimationComponent& animation = animations[i];
+				if (animation.mModel == nullptr || *animation.mModel == nullptr || (*animation.mModel)->mAnimation == nullptr)
+					continue;
+
+				if (animation.mAnimator == nullptr)
+					animation.mAnimator = new Animator((*animation.mModel)->mAnimation);
+				else
+					animation.mAnimator->updateAnimation(pDeltaTime);
+			}
+		});
+}
+
+void Renderer::updateBounds(World& pWorld)
+{
+	ComponentArray<RenderComponent>& renderables = pWorld.components<RenderComponent>();
+	ComponentArray<lm::aabb>& boxes = pWorld.components<lm::aabb>();
+
+	// the new entities get their box once their model is there, the others wait for a later frame
+	size_t waiting = 0;
+	for (const Entity entity : pWorld.mUnbounded)
+	{
+		const RenderComponent* renderable = renderables.tryGet(entity);
+		if (renderable == nullptr || boxes.has(entity))
+			continue;
+
+		if (*renderable->mModel == nullptr)
+		{
+			pWorld.mUnbounded[waiting++] = entity;
+			continue;
+		}
+
+		pWorld.mBVH.insert(entity, boxes.add(entity, (*renderable->mModel)->mBounds.transform(pWorld.mTransforms.getWorld(renderable->mTransform))));
+		if (renderable->mTransform >= pWorld.mBoxOwners.size())
+			pWorld.mBoxOwners.resize(size_t(renderable->mTransform) + 1, INVALID_ENTITY);
+		pWorld.mBoxOwners[renderable->mTransform] = entity;
+	}
+	pWorld.mUnbounded.resize(waiting);
+
+	// the boxed entities that moved are refitted together, a large batch in one pass over the BVH
+	pWorld.mRefitIds.clear();
+	pWorld.mRefitBoxes.clear();
+	for (const TransformHierarchy::Handle transform : pWorld.mTransforms.getChanged())
+	{
+		const Entity entity = transform < pWorld.mBoxOwners.size() ? pWorld.mBoxOwners[transform] : INVALID_ENTITY;
+		const RenderComponent* renderable = entity != INVALID_ENTITY ? renderables.tryGet(entity) : nullptr;
+
+		// the owner may be gone, and its entity or transform handle reused by another one
+		if (renderable == nullptr || renderable->mTransform != transform || !boxes.has(entity))
+			continue;
+
+		pWorld.mRefitIds.push_back(entity);
+		pWorld.mRefitBoxes.push_back(boxes.get(entity) = (*renderable->mModel)->mBounds.transform(pWorld.mTransforms.getWorld(transform)));
+	}
+	pWorld.mBVH.update(pWorld.mRefitIds.data(), pWorld.mRefitBoxes.data(), pWorld.mRefitIds.size());
+}
+
+void Renderer::cullRenderables(World& pWorld, ThreadPool& pPool, View* pViews, size_t pCount, FrameObjects& pObjects)
+{
+	static constexpr size_t CHUNK = 1024;
+
+	ComponentArray<lm::aabb>& boxes = pWorld.components<lm::aabb>();
+	const size_t count = boxes.size();
+	const size_t chunks = (count + CHUNK - 1) / CHUNK;
+	for (size_t view = 0; view < pCount; view++)
+	{
+		pViews[view].mVisible.mIndices.resize(count);
+		pViews[view].mVisible.mChunkCounts.resize(chunks);
+	}
+
+	// each chunk writes the indices it keeps over its own part of every view's mIndices
+	pPool.parallelFor(chunks, 1, [&boxes, pViews, pCount, count](size_t pBegin, size_t pEnd)
+		{
+			for (size_t chunk = pBegin; chunk < pEnd; chunk++)
+			{
+				const size_t first = chunk * CHUNK;
+				for (size_t view = 0; view < pCount; view++)
+				{
+					VisibleSet& visible = pViews[view].mVisible;
+					visible.mChunkCounts[chunk] = lm::batch::cull(pViews[view].mCamera->mFrustum, boxes.mData.data() + first, visible.mIndices.data() + first, std::min(CHUNK, count - first));
+				}
+			}
+		});
+
+	// only the boxes seen last frame have a block to forget
+	for (const uint32_t box : pObjects.mBoxes)
+		if (box < pObjects.mBlockOfBox.size())
+			pObjects.mBlockOfBox[box] = UINT32_MAX;
+	pObjects.mBlockOfBox.resize(count, UINT32_MAX);
+	pObjects.mEntities.clear();
+	pObjects.mBoxes.clear();
+
+	// a box seen by several views gets the block of the first one
+	for (size_t view = 0; view < pCount; view++)
+	{
+		VisibleSet& visible = pViews[view].mVisible;
+		visible.mEntities.clear();
+		visible.mBlocks.clear();
+
+		for (size_t chunk = 0; chunk < chunks; chunk++)
+		{
+			const size_t first = chunk * CHUNK;
+			for (size_t i = 0; i < visible.mChunkCounts[chunk]; i++)
+			{
+				const size_t box = first + visible.mIndices[first + i];
+				uint32_t& block = pObjects.mBlockOfBox[box];
+				if (block == UINT32_MAX)
+				{
+					block = uint32_t(pObjects.mEntities.size());
+					pObjects.mEntities.push_back(boxes.mEntities[box]);
+					pObjects.mBoxes.push_back(uint32_t(box));
+				}
+
+				visible.mEntities.push_back(boxes.mEntities[box]);
+				visible.mBlocks.push_back(block);
+			}
+		}
+
+		visible.mVisible = visible.mEntities.size();
+		visible.mCulled = count - visible.mVisible;
+	}
+}
+
+void Renderer::uploadRenderables(World& pWorld, VKRenderer& pRenderer, const FrameObjects& pObjects, DynamicUniformBuffer& pUniforms)
+{
+	ComponentArray<RenderComponent>& renderables = pWorld.components<RenderComponent>();
+	ComponentArray<AnimationComponent>& animations = pWorld.components<AnimationComponent>();
+
+	pUniforms.reserve(pRenderer.mCurrentFrame, pObjects.mEntities.size());
+
+	for (size_t block = 0; block < pObjects.mEntities.size(); block++)
+	{
+		const Entity entity = pObjects.mEntities[block];
+		const RenderComponent* renderable = renderables.tryGet(entity);
+		if (renderable == nullptr || *renderable->mModel == nullptr)
+			continue;
+
+		AnimationComponent* animation = animations.tryGet(entity);
+		const Animator* animator = animation != nullptr ? animation->mAnimator : nullptr;
+		const lm::mat4& global = pWorld.mTransforms.getWorld(renderable->mTransform);
+
+		// packed straight into this frame's mapped buffer, in the order of UniformBufferObject
+		lm::gpu::Std140Packer(pUniforms.getBlock(pRenderer.mCurrentFrame, block))
+			.write(global)
+			.write(lm::mat3::normalMatrix(global))
+			.write(animator != nullptr);
+
+		if (animator == nullptr)
+			continue;
+
+		if (animation->mBones == nullptr)
+		{
+			animation->mBones = new UniformBuffer(pRenderer);
+			animation->mBones->init(sizeof(BonePalette), VK_SHADER_STAGE_VERTEX_BIT);
+		}
+
+		const std::vector<lm::mat4>& transforms = animator->mFinalBoneMatrices;
+		lm::gpu::Std140Packer(animation->mBones->mUniformBuffersMapped[pRenderer.mCurrentFrame])
+			.write(transforms.data(), std::min(transforms.size(), size_t(MAX_BONE)));
+	}
+}
+
+void Renderer::drawRenderables(World& pWorld, VKRenderer& pRenderer, const View& pView, const DynamicUniformBuffer& pUniforms, const UniformBuffer& pNoBones)
+{
+	ComponentArray<RenderComponent>& renderables = pWorld.components<RenderComponent>();
+	ComponentArray<AnimationComponent>& animations = pWorld.components<AnimationComponent>();
+	const VisibleSet& visible = pView.mVisible;
+
+	ViewConstants constants;
+	constants.mVP = pView.mCamera->mVp;
+	constants.mPosition = pView.mCamera->mPosition;
+
+	for (size_t i = 0; i < visible.mEntities.size(); i++)
+	{
+		const Entity entity = visible.mEntities[i];
+		const RenderComponent* found = renderables.tryGet(entity);
+		if (found == nullptr)
+			continue;
+
+		const RenderComponent& renderable = *found;
+		if (*renderable.mShader == nullptr || *renderable.mModel == nullptr)
+			continue;
+
+		Shader& shader = *(*renderable.mShader);
+		shader.bind();
+		shader.setView(&constants, sizeof(constants));
+
+		if (renderable.mTexture != nullptr && *renderable.mTexture != nullptr)
+			shader.setTexture((*renderable.mTexture)->mTextureSets[pRenderer.mCurrentFrame]);
+
+		shader.setMVP(pUniforms.mDescriptorSets[pRenderer.mCurrentFrame], pUniforms.getOffset(visible.mBlocks[i]));
+
+		// the palette was filled by uploadRenderables when the object had its animator
+		const AnimationComponent* animation = animations.tryGet(entity);
+		if (animation != nullptr && animation->mAnimator != nullptr && animation->mBones != nullptr)
+			shader.setBones(animation->mBones->mDescriptorSets[pRenderer.mCurrentFrame]);
+		else
+			shader.setBones(pNoBones.mDescriptorSets[pRenderer.mCurrentFrame]);
+
+		(*renderable.mModel)->draw(shader);
+	}
+}
+
+void Renderer::writeMemoryReport(World& pWorld, VKRenderer& pRenderer, size_t pObjectBytes, std::ostream& pStream)
+{
+	ComponentArray<AnimationComponent>& animations = pWorld.components<AnimationComponent>();
+	const size_t objects = pWorld.components<RenderComponent>().size();
+	const size_t animated = size_t(std::count_if(animations.mData.begin(), animations.mData.end(), [](const AnimationComponent& pAnimation) { return pAnimation.mBones != nullptr; }));
+
+	// a box in the packed array, a leaf and the inner node above it in the BVH
+	const size_t components = sizeof(RenderComponent) + sizeof(AnimationComponent) + 2 * (sizeof(Entity) + sizeof(uint32_t));
+	const size_t bounds = sizeof(lm::aabb) + sizeof(Entity) + sizeof(uint32_t) + 2 * sizeof(lm::bvh::Node) + sizeof(int32_t);
+	const size_t transform = TransformHierarchy::bytesPerNode();
+	const size_t cpu = pObjectBytes + components + bounds + transform;
+
+	const size_t frames = VKRenderer::MAX_FRAMES_IN_FLIGHT;
+	const size_t uniforms = pRenderer.padUniformBufferSize(sizeof(UniformBufferObject)) * frames;
+	const size_t palette = pRenderer.padUniformBufferSize(sizeof(BonePalette)) * frames;
+	const size_t inlined = pRenderer.padUniformBufferSize(sizeof(UniformBufferObject) + sizeof(BonePalette)) * frames;
+	const size_t total = objects * (cpu + uniforms) + animated * palette;
+
+	pStream << "objects: " << objects << ", animated: " << animated << '\n'
+		<< "cpu per object: " << cpu << " B (object " << pObjectBytes << ", components " << components
+		<< ", bounds " << bounds << ", transform " << transform << ")\n"
+		<< "gpu per object: " << uniforms << " B of uniforms (a block of the shared buffer per frame in flight), " << palette << " B more with a bone palette\n"
+		<< "per object on average: " << (objects != 0 ? total / objects : 0) << " B, "
+		<< cpu + inlined << " B with the palette inlined in every uniform block\n"
+		<< "frame arenas: " << pRenderer.mFrameArenas.lastFrameBytes() << " B last frame, " << pRenderer.mFrameArenas.peakFrameBytes()
+		<< " B at most, " << pRenderer.mFrameArenas.capacity() << " B reserved\n";
+}
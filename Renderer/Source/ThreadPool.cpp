@@ -1,4 +1,7 @@
 #include "ThreadPool.h"
+#include <atomic>
+#include <memory>
+#include <algorithm>
 
 
 using namespace Renderer;
@@ -24,6 +27,59 @@ void ThreadPool::queueJob(std::function<void()> pJob)
     mMutexCondition.notify_one();
 }
 
+void ThreadPool::parallelFor(size_t pCount, size_t pGrain, const void* pJob, void (*pCall)(const void* pJob, size_t pBegin, size_t pEnd))
+{
+    struct Batch
+    {
+        // the caller's, a helper only calls it while the caller waits for the chunk it took
+        const void* mJob = nullptr;
+        void (*mCall)(const void*, size_t, size_t) = nullptr;
+        size_t mCount = 0;
+        size_t mGrain = 1;
+        std::atomic<size_t> mNext { 0 };
+        std::atomic<size_t> mDone { 0 };
+        std::mutex mMutex;
+        std::condition_variable mFinished;
+
+        void run()
+        {
+            size_t done = 0;
+            for (size_t begin = mNext.fetch_add(mGrain); begin < mCount; begin = mNext.fetch_add(mGrain))
+            {
+                const size_t end = std::min(begin + mGrain, mCount);
+                mCall(mJob, begin, end);
+                done += end - begin;
+            }
+
+            if (done != 0 && mDone.fetch_add(done) + done == mCount)
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mFinished.notify_all();
+            }
+        }
+    };
+
+    if (pCount == 0)
+        return;
+
+    // shared with the helpers, one that starts late (behind a loading job) finds nothing left to do
+    std::shared_ptr<Batch> batch = std::make_shared<Batch>();
+    batch->mJob = pJob;
+    batch->mCall = pCall;
+    batch->mCount = pCount;
+    batch->mGrain = std::max(pGrain, size_t(1));
+
+    const size_t chunks = (pCount + batch->mGrain - 1) / batch->mGrain;
+    const size_t helpers = std::min(mThreads.size(), chunks - 1);
+    for (size_t i = 0; i < helpers; i++)
+        queueJob([batch] { batch->run(); });
+
+    batch->run();
+
+    std::unique_lock<std::mutex> lock(batch->mMutex);
+    batch->mFinished.wait(lock, [&batch] { return batch->mDone == batch->mCount; });
+}
+
 void ThreadPool::stop()
 {
     {
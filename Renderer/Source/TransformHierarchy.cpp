@@ -0,0 +1,366 @@
+#include "TransformHierarchy.h"
+#include "Batch/Batch.h"
+#include <algorithm>
+
+using namespace Renderer;
+
+TransformHierarchy::Handle TransformHierarchy::create(const lm::mat4& pLocal)
+{
+	Handle handle;
+	if (!mFreeHandles.empty())
+	{
+		handle = mFreeHandles.back();
+		mFreeHandles.pop_back();
+	}
+	else
+	{
+		handle = Handle(mIndex.size());
+		mIndex.push_back(INVALID);
+		mChangedFrame.push_back(0);
+	}
+	mChangedFrame[handle] = 0;
+
+	// a new root at the end keeps the order valid, the parallel ranges are rebuilt
+	const uint32_t index = uint32_t(mLocal.size());
+	mGrain = 0;
+	mIndex[handle] = index;
+	mLocal.push_back(pLocal);
+	mWorld.push_back(pLocal);
+	mParent.push_back(INVALID);
+	mSubtreeEnd.push_back(index + 1);
+	mHandle.push_back(handle);
+	mDirty.push_back(1);
+	mRecomputed.push_back(0);
+	mMoved.push_back(0);
+	mAnyDirty = true;
+	return handle;
+}
+
+void TransformHierarchy::destroy(Handle pNode)
+{
+	// the slot is dropped by the next sort, its children become roots
+	mHandle[mIndex[pNode]] = INVALID;
+	mIndex[pNode] = INVALID;
+	mFreeHandles.push_back(pNode);
+	mSorted = false;
+}
+
+bool TransformHierarchy::setParent(Handle pNode, Handle pParent)
+{
+	const uint32_t index = mIndex[pNode];
+	const uint32_t parent = pParent == INVALID ? INVALID : mIndex[pParent];
+
+	for (uint32_t ancestor = parent; ancestor != INVALID && mHandle[ancestor] != INVALID; ancestor = mParent[ancestor])
+		if (ancestor == index)
+			return false;
+
+	mParent[index] = parent;
+	mDirty[index] = 1;
+	mAnyDirty = true;
+	mSorted = false;
+	return true;
+}
+
+TransformHierarchy::Handle TransformHierarchy::getParent(Handle pNode) const
+{
+	const uint32_t parent = mParent[mIndex[pNode]];
+	return parent == INVALID ? INVALID : mHandle[parent];
+}
+
+void TransformHierarchy::setLocal(Handle pNode, const lm::mat4& pLocal)
+{
+	const uint32_t index = mIndex[pNode];
+	mLocal[index] = pLocal;
+	mDirty[index] = 1;
+	mAnyDirty = true;
+}
+
+const lm::mat4& TransformHierarchy::getLocal(Handle pNode) const
+{
+	return mLocal[mIndex[pNode]];
+}
+
+const lm::mat4& TransformHierarchy::getWorld(Handle pNode) const
+{
+	return mWorld[mIndex[pNode]];
+}
+
+void TransformHierarchy::update()
+{
+	if (!mSorted)
+		sort();
+
+	// a static frame does not walk the hierarchy at all
+	if (mAnyDirty && updateRange(0, uint32_t(mLocal.size()), false))
+		mAnyMoved = true;
+	mAnyDirty = false;
+
+	publish();
+}
+
+void TransformHierarchy::update(ThreadPool& pPool)
+{
+	if (!mSorted)
+		sort();
+
+	if (mAnyDirty)
+	{
+		const uint32_t grain = std::max(uint32_t(mLocal.size() / ((pPool.mThreads.size() + 1) * 8)), uint32_t(256));
+		if (grain != mGrain)
+			partition(grain);
+
+		// the nodes above the ranges first, then every range on its own
+		for (uint32_t i : mSpine)
+		{
+			const uint32_t parent = mParent[i];
+			mRecomputed[i] = mDirty[i] || (parent != INVALID && mRecomputed[parent]);
+			if (mRecomputed[i])
+			{
+				recompute(i, i + 1);
+				mAnyMoved = true;
+			}
+		}
+
+		std::vector<uint8_t> moved(mRanges.size(), 0);
+		pPool.parallelFor(mRanges.size(), 1, [this, &moved](size_t pBegin, size_t pEnd)
+			{
+				for (size_t i = pBegin; i < pEnd; i++)
+					moved[i] = updateRange(mRanges[i].first, mRanges[i].second, false);
+			});
+
+		if (std::find(moved.begin(), moved.end(), uint8_t(1)) != moved.end())
+			mAnyMoved = true;
+	}
+	mAnyDirty = false;
+
+	publish();
+}
+
+void TransformHierarchy::update(Handle pNode)
+{
+	if (!mSorted)
+		sort();
+
+	const uint32_t index = mIndex[pNode];
+	if (updateRange(index, mSubtreeEnd[index], true))
+		mAnyMoved = true;
+}
+
+void TransformHierarchy::publish()
+{
+	mChanged.clear();
+	mFrame++;
+	if (mAnyMoved)
+	{
+		for (uint32_t i = 0; i < uint32_t(mMoved.size()); i++)
+		{
+			if (mMoved[i])
+			{
+				mChanged.push_back(mHandle[i]);
+				mChangedFrame[mHandle[i]] = mFrame;
+			}
+			mMoved[i] = 0;
+		}
+	}
+	mAnyMoved = false;
+}
+
+const std::vector<TransformHierarchy::Handle>& TransformHierarchy::getChanged() const
+{
+	return mChanged;
+}
+
+bool TransformHierarchy::hasChanged(Handle pNode) const
+{
+	return mChangedFrame[pNode] == mFrame;
+}
+
+size_t TransformHierarchy::size() const
+{
+	return mIndex.size() - mFreeHandles.size();
+}
+
+size_t TransformHierarchy::bytesPerNode()
+{
+	// by index, then by handle
+	return 2 * sizeof(lm::mat4) + 2 * sizeof(uint32_t) + sizeof(Handle) + 3 * sizeof(uint8_t) + 2 * sizeof(uint32_t);
+}
+
+bool TransformHierarchy::updateRange(uint32_t pBegin, uint32_t pEnd, bool pForce)
+{
+	if (pForce)
+		mDirty[pBegin] = 1;
+
+	// parents come first, so a node knows whether its parent moved in this pass,
+	// the parent of pBegin was handled before the range
+	bool moved = false;
+	for (uint32_t i = pBegin; i < pEnd;)
+	{
+		const uint32_t parent = mParent[i];
+		const bool parentMoved = parent != INVALID && mRecomputed[parent];
+		if (!parentMoved)
+		{
+			mRecomputed[i] = mDirty[i];
+			if (mDirty[i])
+			{
+				recompute(i, i + 1);
+				moved = true;
+			}
+			i++;
+			continue;
+		}
+
+		// the siblings that follow share the parent matrix
+		uint32_t end = i + 1;
+		while (end < pEnd && mParent[end] == parent)
+			end++;
+
+		recompute(i, end);
+		moved = true;
+		i = end;
+	}
+	return moved;
+}
+
+void TransformHierarchy::recompute(uint32_t pBegin, uint32_t pEnd)
+{
+	const uint32_t parent = mParent[pBegin];
+	if (parent == INVALID)
+		std::copy(mLocal.begin() + pBegin, mLocal.begin() + pEnd, mWorld.begin() + pBegin);
+	else
+		lm::batch::multiply(mWorld[parent], &mLocal[pBegin], &mWorld[pBegin], pEnd - pBegin);
+
+	for (uint32_t i = pBegin; i < pEnd; i++)
+	{
+		mDirty[i] = 0;
+		mRecomputed[i] = 1;
+		mMoved[i] = 1;
+	}
+}
+
+void TransformHierarchy::partition(uint32_t pGrain)
+{
+	mSpine.clear();
+	mRanges.clear();
+	mGrain = pGrain;
+
+	// the subtrees small enough become ranges, the nodes above them are updated serially;
+	// in depth first order the next node is the first child, or what follows the subtree
+	const uint32_t count = uint32_t(mLocal.size());
+	for (uint32_t i = 0; i < count;)
+	{
+		const uint32_t end = mSubtreeEnd[i];
+		if (end - i > pGrain)
+		{
+			mSpine.push_back(i);
+			i++;
+			continue;
+		}
+
+		// small neighbouring subtrees share a range
+		if (!mRanges.empty() && mRanges.back().second == i && end - mRanges.back().first <= pGrain)
+			mRanges.back().second = end;
+		else
+			mRanges.emplace_back(i, end);
+		i = end;
+	}
+}
+
+void TransformHierarchy::sort()
+{
+	const uint32_t count = uint32_t(mLocal.size());
+
+	// children of each live node, in storage order
+	std::vector<uint32_t> firstChild(count + 1, 0);
+	std::vector<uint32_t> children(count);
+	std::vector<uint32_t> roots;
+	for (uint32_t i = 0; i < count; i++)
+	{
+		if (mHandle[i] == INVALID)
+			continue;
+
+		if (mParent[i] == INVALID || mHandle[mParent[i]] == INVALID)
+		{
+			// orphans of a destroyed node become roots, their world matrix changes
+			if (mParent[i] != INVALID)
+			{
+				mParent[i] = INVALID;
+				mDirty[i] = 1;
+				mAnyDirty = true;
+			}
+			roots.push_back(i);
+		}
+		else
+			firstChild[mParent[i] + 1]++;
+	}
+
+	for (uint32_t i = 0; i < count; i++)
+		firstChild[i + 1] += firstChild[i];
+
+	std::vector<uint32_t> cursor(firstChild.begin(), firstChild.end() - 1);
+	for (uint32_t i = 0; i < count; i++)
+		if (mHandle[i] != INVALID && mParent[i] != INVALID && mHandle[mParent[i]] != INVALID)
+			children[cursor[mParent[i]]++] = i;
+
+	// depth first, siblings keep their relative order
+	std::vector<uint32_t> order;
+	std::vector<uint32_t> stack;
+	order.reserve(count);
+	for (uint32_t root : roots)
+	{
+		stack.push_back(root);
+		while (!stack.empty())
+		{
+			const uint32_t node = stack.back();
+			stack.pop_back();
+			order.push_back(node);
+
+			for (uint32_t child = firstChild[node + 1]; child > firstChild[node]; child--)
+				stack.push_back(children[child - 1]);
+		}
+	}
+
+	// old index -> new index
+	std::vector<uint32_t> remap(count, INVALID);
+	for (uint32_t i = 0; i < uint32_t(order.size()); i++)
+		remap[order[i]] = i;
+
+	const uint32_t size = uint32_t(order.size());
+	std::vector<lm::mat4> local(size);
+	std::vector<lm::mat4> world(size);
+	std::vector<uint32_t> parent(size);
+	std::vector<Handle> handle(size);
+	std::vector<uint8_t> dirty(size);
+	std::vector<uint8_t> moved(size);
+	for (uint32_t i = 0; i < size; i++)
+	{
+		const uint32_t old = order[i];
+		local[i] = mLocal[old];
+		world[i] = mWorld[old];
+		parent[i] = mParent[old] == INVALID ? INVALID : remap[mParent[old]];
+		handle[i] = mHandle[old];
+		dirty[i] = mDirty[old];
+		moved[i] = mMoved[old];
+		mIndex[handle[i]] = i;
+	}
+
+	// a subtree ends after its last descendant, sizes are summed from the leaves up
+	std::vector<uint32_t> subtreeSize(size, 1);
+	for (uint32_t i = size; i-- > 0;)
+		if (parent[i] != INVALID)
+			subtreeSize[parent[i]] += subtreeSize[i];
+
+	mSubtreeEnd.resize(size);
+	for (uint32_t i = 0; i < size; i++)
+		mSubtreeEnd[i] = i + subtreeSize[i];
+
+	mLocal.swap(local);
+	mWorld.swap(world);
+	mParent.swap(parent);
+	mHandle.swap(handle);
+	mDirty.swap(dirty);
+	mMoved.swap(moved);
+	mRecomputed.resize(size);
+	mGrain = 0;
+	mSorted = true;
+}
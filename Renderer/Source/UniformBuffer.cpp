@@ -1,4 +1,5 @@
 #include "UniformBuffer.h"
+#include <algorithm>
 
 using namespace Renderer;
 
@@ -51,4 +52,87 @@ void UniformBuffer::createDescriptor(unsigned int pSize, VkShaderStageFlagBits p
 			.bind_buffer(0, &bufferInfo, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, pStage)
 			.build(mDescriptorSets[i]);
 	}
+}
+
+DynamicUniformBuffer::DynamicUniformBuffer(VKRenderer& pRenderer) : mRenderer(pRenderer)
+{
+}
+
+DynamicUniformBuffer::~DynamicUniformBuffer()
+{
+	for (size_t i = 0; i < mUniformBuffers.size(); i++)
+	{
+		vkDestroyBuffer(mRenderer.mDevice, mUniformBuffers[i], nullptr);
+		vkFreeMemory(mRenderer.mDevice, mUniformBuffersMemory[i], nullptr);
+	}
+}
+
+void DynamicUniformBuffer::init(unsigned int pSize, VkShaderStageFlagBits pStage, size_t pCount)
+{
+	mStride = mRenderer.padUniformBufferSize(pSize);
+
+	mUniformBuffers.resize(VKRenderer::MAX_FRAMES_IN_FLIGHT);
+	mUniformBuffersMemory.resize(VKRenderer::MAX_FRAMES_IN_FLIGHT);
+	mUniformBuffersMapped.resize(VKRenderer::MAX_FRAMES_IN_FLIGHT);
+	mCapacities.resize(VKRenderer::MAX_FRAMES_IN_FLIGHT);
+	mDescriptorSets.resize(VKRenderer::MAX_FRAMES_IN_FLIGHT);
+
+	for (uint32_t i = 0; i < VKRenderer::MAX_FRAMES_IN_FLIGHT; i++)
+	{
+		createUniformBuffer(i, pCount);
+
+		// the range is one block, the offset comes with each bind
+		VkDescriptorBufferInfo bufferInfo{};
+		bufferInfo.buffer = mUniformBuffers[i];
+		bufferInfo.offset = 0;
+		bufferInfo.range = mStride;
+
+		vkutil::DescriptorBuilder::begin(mRenderer.mDescriptorLayoutCache, mRenderer.mDescriptorAllocator)
+			.bind_buffer(0, &bufferInfo, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, pStage)
+			.build(mDescriptorSets[i]);
+	}
+}
+
+void DynamicUniformBuffer::reserve(uint32_t pFrame, size_t pCount)
+{
+	if (pCount <= mCapacities[pFrame])
+		return;
+
+	vkDestroyBuffer(mRenderer.mDevice, mUniformBuffers[pFrame], nullptr);
+	vkFreeMemory(mRenderer.mDevice, mUniformBuffersMemory[pFrame], nullptr);
+	createUniformBuffer(pFrame, std::max(pCount, mCapacities[pFrame] * 2));
+
+	// the set is not in use either, it is pointed at the new buffer in place
+	VkDescriptorBufferInfo bufferInfo{};
+	bufferInfo.buffer = mUniformBuffers[pFrame];
+	bufferInfo.offset = 0;
+	bufferInfo.range = mStride;
+
+	VkWriteDescriptorSet write{};
+	write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+	write.dstSet = mDescriptorSets[pFrame];
+	write.dstBinding = 0;
+	write.descriptorCount = 1;
+	write.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+	write.pBufferInfo = &bufferInfo;
+	vkUpdateDescriptorSets(mRenderer.mDevice, 1, &write, 0, nullptr);
+}
+
+void* DynamicUniformBuffer::getBlock(uint32_t pFrame, size_t pIndex) const
+{
+	return static_cast<unsigned char*>(mUniformBuffersMapped[pFrame]) + pIndex * mStride;
+}
+
+uint32_t DynamicUniformBuffer::getOffset(size_t pIndex) const
+{
+	return uint32_t(pIndex * mStride);
+}
+
+void DynamicUniformBuffer::createUniformBuffer(uint32_t pFrame, size_t pCount)
+{
+	VkDeviceSize bufferSize = mStride * std::max(pCount, size_t(1));
+
+	mRenderer.createBuffer(bufferSize, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, mUniformBuffers[pFrame], mUniformBuffersMemory[pFrame]);
+	vkMapMemory(mRenderer.mDevice, mUniformBuffersMemory[pFrame], 0, bufferSize, 0, &mUniformBuffersMapped[pFrame]);
+	mCapacities[pFrame] = std::max(pCount, size_t(1));
 }
\ No newline at end of file
@@ -862,6 +862,7 @@ void VKRenderer::recreateSwapChain()
 void VKRenderer::beginDraw()
 {
     vkWaitForFences(mDevice, 1, &mInFlightFences[mCurrentFrame], VK_TRUE, UINT64_MAX);
+    mFrameArenas.beginFrame(mCurrentFrame);
     
     VkResult result = vkAcquireNextImageKHR(mDevice, mSwapChain, UINT64_MAX, mImageAvailableSemaphores[mCurrentFrame], VK_NULL_HANDLE, &mImageIndex);
     if (result == VK_ERROR_OUT_OF_DATE_KHR) 
@@ -894,21 +895,39 @@ void VKRenderer::beginDraw()
 
     vkCmdBeginRenderPass(mCommandBuffers[mCurrentFrame], &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
 
+    setViewport(0.0f, 0.0f, 1.0f, 1.0f, false);
+
+    //vkCmdSetPrimitiveTopology(commandBuffers[currentFrame], VK_PRIMITIVE_TOPOLOGY_LINE_LIST);
+}
+
+void VKRenderer::setViewport(float pX, float pY, float pWidth, float pHeight, bool pClearDepth)
+{
     VkViewport viewport{};
-    viewport.x = 0.0f;
-    viewport.y = 0.0f;
-    viewport.width = (float)mSwapChainExtent.width;
-    viewport.height = (float)mSwapChainExtent.height;
+    viewport.x = pX * mSwapChainExtent.width;
+    viewport.y = pY * mSwapChainExtent.height;
+    viewport.width = pWidth * mSwapChainExtent.width;
+    viewport.height = pHeight * mSwapChainExtent.height;
     viewport.minDepth = 0.0f;
     viewport.maxDepth = 1.0f;
     vkCmdSetViewport(mCommandBuffers[mCurrentFrame], 0, 1, &viewport);
 
     VkRect2D scissor{};
-    scissor.offset = { 0, 0 };
-    scissor.extent = mSwapChainExtent;
+    scissor.offset = { int32_t(viewport.x), int32_t(viewport.y) };
+    scissor.extent = { uint32_t(viewport.width), uint32_t(viewport.height) };
     vkCmdSetScissor(mCommandBuffers[mCurrentFrame], 0, 1, &scissor);
-    
-    //vkCmdSetPrimitiveTopology(commandBuffers[currentFrame], VK_PRIMITIVE_TOPOLOGY_LINE_LIST);
+
+    if (!pClearDepth)
+        return;
+
+    VkClearAttachment clear{};
+    clear.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+    clear.clearValue.depthStencil = { 1.0f, 0 };
+
+    VkClearRect rect{};
+    rect.rect = scissor;
+    rect.baseArrayLayer = 0;
+    rect.layerCount = 1;
+    vkCmdClearAttachments(mCommandBuffers[mCurrentFrame], 1, &clear, 1, &rect);
 }
 
 void VKRenderer::endDraw()
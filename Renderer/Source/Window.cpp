@@ -20,6 +20,8 @@ void Window::mousePosition(GLFWwindow* pWindow, double pX, double pY)
 
 void Window::mouseButton(GLFWwindow* pWindow, int pButton, int pAction, int pMods)
 {
+	Application* app = (Application*)glfwGetWindowUserPointer(pWindow);
+	app->mouseButton(pButton, pAction, pMods);
 }
 
 void Window::keyCallback(GLFWwindow* pWindow, int pKey, int pScancode, int pAction, int pMods)
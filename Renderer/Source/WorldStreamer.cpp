@@ -0,0 +1,286 @@
+#include "WorldStreamer.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace Renderer;
+
+WorldStreamer::WorldStreamer(World& pWorld, ResourceManager& pResources, RetireQueue& pRetired, const Settings& pSettings) :
+	mWorld(pWorld),
+	mResources(pResources),
+	mRetired(pRetired),
+	mSettings(pSettings)
+{
+	if (mSettings.mUnloadRadius < mSettings.mLoadRadius)
+		mSettings.mUnloadRadius = mSettings.mLoadRadius;
+}
+
+WorldStreamer::~WorldStreamer()
+{
+	clear();
+}
+
+void WorldStreamer::place(const Prefab& pPrefab, const lm::mat4& pTransform)
+{
+	const int32_t x = cellOf(pTransform[3].X());
+	const int32_t z = cellOf(pTransform[3].Z());
+	Cell& cell = mCells[key(x, z)];
+	cell.mX = x;
+	cell.mZ = z;
+	cell.mPlacements.push_back({ &pPrefab, pTransform });
+
+	// the streamed resources among the models, shaders and textures of the prefab
+	for (const Prefab::Node& node : pPrefab.getNodes())
+	{
+		for (const void* slot : { (const void*)node.mModel, (const void*)node.mShader, (const void*)node.mTexture })
+		{
+			std::unordered_map<const void*, uint32_t>::const_iterator found = mSlots.find(slot);
+			if (found == mSlots.end() || std::find(cell.mResources.begin(), cell.mResources.end(), found->second) != cell.mResources.end())
+				continue;
+
+			cell.mResources.push_back(found->second);
+			if (cell.mActive)
+				acquire(found->second);
+		}
+	}
+
+	if (cell.mActive)
+		instantiate(cell, cell.mPlacements.back());
+}
+
+void WorldStreamer::update(const lm::vec3& pCamera)
+{
+	// past the unload radius
+	for (size_t i = 0; i < mActive.size();)
+	{
+		if (distance(*mActive[i], pCamera) > mSettings.mUnloadRadius)
+		{
+			deactivate(*mActive[i]);
+			mActive[i] = mActive.back();
+			mActive.pop_back();
+		}
+		else
+			i++;
+	}
+
+	// within the load radius, only the cells around the camera are looked up
+	mWanted.clear();
+	const int32_t minX = cellOf(pCamera.X() - mSettings.mLoadRadius), maxX = cellOf(pCamera.X() + mSettings.mLoadRadius);
+	const int32_t minZ = cellOf(pCamera.Z() - mSettings.mLoadRadius), maxZ = cellOf(pCamera.Z() + mSettings.mLoadRadius);
+	for (int32_t x = minX; x <= maxX; x++)
+	{
+		for (int32_t z = minZ; z <= maxZ; z++)
+		{
+			std::unordered_map<uint64_t, Cell>::iterator found = mCells.find(key(x, z));
+			if (found == mCells.end() || found->second.mActive)
+				continue;
+
+			const float cellDistance = distance(found->second, pCamera);
+			if (cellDistance <= mSettings.mLoadRadius)
+				mWanted.push_back({ cellDistance, &found->second });
+		}
+	}
+	std::sort(mWanted.begin(), mWanted.end(), [](const std::pair<float, Cell*>& pA, const std::pair<float, Cell*>& pB) { return pA.first < pB.first; });
+
+	for (const std::pair<float, Cell*>& wanted : mWanted)
+	{
+		// a cell sharing a resource with the wanted one would give back bytes that activate() takes again,
+		// and what is missing is counted anew after each eviction
+		while (mResidentBytes + missingBytes(*wanted.second) > mSettings.mBudget)
+		{
+			// the furthest cell that is only kept by the hysteresis
+			size_t furthest = mActive.size();
+			float furthestDistance = mSettings.mLoadRadius;
+			for (size_t i = 0; i < mActive.size(); i++)
+			{
+				const float activeDistance = distance(*mActive[i], pCamera);
+				if (activeDistance > furthestDistance && !shares(*mActive[i], *wanted.second))
+				{
+					furthest = i;
+					furthestDistance = activeDistance;
+				}
+			}
+
+			if (furthest == mActive.size())
+				break;
+
+			deactivate(*mActive[furthest]);
+			mActive[furthest] = mActive.back();
+			mActive.pop_back();
+		}
+
+		// what is nearer came first, the rest waits for room
+		if (mResidentBytes + missingBytes(*wanted.second) > mSettings.mBudget)
+			break;
+
+		activate(*wanted.second);
+		mActive.push_back(wanted.second);
+	}
+
+	collect();
+}
+
+void WorldStreamer::clear()
+{
+	for (Cell* cell : mActive)
+		deactivate(*cell);
+	mActive.clear();
+	mUnused.clear();
+
+	// a load still queued or running no longer fills its slot, the job deletes what it loads
+	for (Resource& resource : mStreamed)
+	{
+		std::lock_guard<std::mutex> lock(resource.mState->mMutex);
+		if (resource.mState->mLoading.load())
+		{
+			resource.mState->mDropped = true;
+			continue;
+		}
+
+		delete *resource.mSlot;
+		*resource.mSlot = nullptr;
+	}
+}
+
+size_t WorldStreamer::getResidentBytes() const
+{
+	return mResidentBytes;
+}
+
+size_t WorldStreamer::getActiveCells() const
+{
+	return mActive.size();
+}
+
+uint64_t WorldStreamer::key(int32_t pX, int32_t pZ)
+{
+	return (uint64_t(uint32_t(pX)) << 32) | uint32_t(pZ);
+}
+
+int32_t WorldStreamer::cellOf(float pCoordinate) const
+{
+	return int32_t(std::floor(pCoordinate / mSettings.mCellSize));
+}
+
+float WorldStreamer::distance(const Cell& pCell, const lm::vec3& pCamera) const
+{
+	// to the nearest point of the cell's square
+	const float minX = pCell.mX * mSettings.mCellSize, minZ = pCell.mZ * mSettings.mCellSize;
+	const float dx = std::max({ minX - pCamera.X(), 0.f, pCamera.X() - (minX + mSettings.mCellSize) });
+	const float dz = std::max({ minZ - pCamera.Z(), 0.f, pCamera.Z() - (minZ + mSettings.mCellSize) });
+	return std::sqrt(dx * dx + dz * dz);
+}
+
+size_t WorldStreamer::missingBytes(const Cell& pCell) const
+{
+	size_t bytes = 0;
+	for (const uint32_t resource : pCell.mResources)
+		if (mStreamed[resource].mUsers == 0)
+			bytes += mStreamed[resource].mBytes;
+	return bytes;
+}
+
+bool WorldStreamer::shares(const Cell& pA, const Cell& pB)
+{
+	for (const uint32_t resource : pA.mResources)
+		if (std::find(pB.mResources.begin(), pB.mResources.end(), resource) != pB.mResources.end())
+			return true;
+	return false;
+}
+
+void WorldStreamer::activate(Cell& pCell)
+{
+	for (const uint32_t resource : pCell.mResources)
+		acquire(resource);
+
+	// drawn once their resources are in, like any object whose model is still loading
+	pCell.mInstances.reserve(pCell.mPlacements.size());
+	for (const Placement& placement : pCell.mPlacements)
+		instantiate(pCell, placement);
+	pCell.mActive = true;
+}
+
+void WorldStreamer::deactivate(Cell& pCell)
+{
+	for (PrefabInstance& instance : pCell.mInstances)
+		destroyPrefabInstance(mWorld, instance, mRetired);
+	pCell.mInstances.clear();
+
+	for (const uint32_t resource : pCell.mResources)
+		release(resource);
+	pCell.mActive = false;
+}
+
+void WorldStreamer::instantiate(Cell& pCell, const Placement& pPlacement)
+{
+	pCell.mInstances.emplace_back();
+	instantiatePrefab(mWorld, *pPlacement.mPrefab, pPlacement.mTransform, pCell.mInstances.back());
+}
+
+void WorldStreamer::acquire(uint32_t pResource)
+{
+	Resource& resource = mStreamed[pResource];
+	if (resource.mUsers++ != 0)
+		return;
+
+	mResidentBytes += resource.mBytes;
+
+	// still there when it was released and not unloaded yet, or wanted again after clear() dropped it
+	{
+		std::lock_guard<std::mutex> lock(resource.mState->mMutex);
+		if (resource.mState->mLoading.load())
+		{
+			resource.mState->mDropped = false;
+			return;
+		}
+	}
+	if (*resource.mSlot != nullptr)
+		return;
+
+	resource.mState->mLoading.store(true);
+	IResource** slot = resource.mSlot;
+	std::function<IResource*()> load = resource.mLoad;
+	std::shared_ptr<LoadState> state = resource.mState;
+	mResources.mPool.queueJob([slot, load, state]
+		{
+			IResource* loaded = load();
+			std::lock_guard<std::mutex> lock(state->mMutex);
+			if (state->mDropped)
+				delete loaded;
+			else
+				*slot = loaded;
+			state->mDropped = false;
+			state->mLoading.store(false);
+		});
+}
+
+void WorldStreamer::release(uint32_t pResource)
+{
+	Resource& resource = mStreamed[pResource];
+	if (--resource.mUsers != 0)
+		return;
+
+	mResidentBytes -= resource.mBytes;
+	mUnused.push_back(pResource);
+}
+
+void WorldStreamer::collect()
+{
+	for (size_t i = 0; i < mUnused.size();)
+	{
+		Resource& resource = mStreamed[mUnused[i]];
+		if (resource.mUsers == 0 && resource.mState->mLoading.load())
+		{
+			i++;
+			continue;
+		}
+
+		// the frames in flight may still draw with it
+		if (resource.mUsers == 0 && *resource.mSlot != nullptr)
+		{
+			mRetired.retire(*resource.mSlot);
+			*resource.mSlot = nullptr;
+		}
+		mUnused[i] = mUnused.back();
+		mUnused.pop_back();
+	}
+}